@@ -0,0 +1,11 @@
+#include "controller.h"
+
+void controller_init(controller_t *controller,
+                     callback_sender sender,
+                     const controller_operation_callback_t *operations,
+                     size_t number_of_operations) {
+
+    controller->sender = sender;
+    controller->operations = operations;
+    controller->number_of_operations = number_of_operations;
+}
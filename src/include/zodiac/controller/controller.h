@@ -0,0 +1,55 @@
+/**
+ * @file controller.h
+ * @brief Defines the controller descriptor used by the Zodiac executor.
+ *
+ * A controller is a named group of operations addressed by the `controller_index`
+ * of an instruction header. The descriptor holds the table of operations indexed by
+ * `operation_index` together with the context passed to each of them.
+ */
+
+#ifndef ZODIAC_CONTROLLER_H
+#define ZODIAC_CONTROLLER_H
+
+#include "controller_operation_callback.h"  ///< Include the operation callback definition.
+
+/**
+ * @brief Max number of controllers.
+ * The number of distinct values of controller_index_t.
+ */
+#define MAX_NUMBER_OF_CONTROLLERS 256
+
+/**
+ * @brief Max number of operations of a single controller.
+ * The number of distinct values of operation_index_t.
+ */
+#define MAX_NUMBER_OF_CONTROLLER_OPERATIONS 256
+
+/**
+ * @struct controller_s
+ * @brief Structure that describes a controller and its table of operations.
+ *
+ * The operation table is borrowed: it must stay alive for as long as the controller
+ * is registered. Operations with an index at or beyond `number_of_operations`, as well
+ * as nullptr entries of the table, are reported by the executor, the image and the
+ * validator as unknown.
+ */
+typedef struct controller_s {
+    callback_sender sender;                            ///< Context object for the operations.
+    const controller_operation_callback_t *operations; ///< Table of operations indexed by operation_index_t.
+    size_t number_of_operations;                       ///< Number of entries in the table of operations.
+} controller_t;
+
+/**
+ * @brief Initializes a controller descriptor.
+ *
+ * @param[out] controller Pointer to the controller structure to initialize.
+ * @param[in] sender The context to pass to the operations.
+ * @param[in] operations The table of operations indexed by operation_index_t.
+ * @param[in] number_of_operations Number of entries in the table, at most MAX_NUMBER_OF_CONTROLLER_OPERATIONS.
+ */
+void controller_init(controller_t *controller,
+                     callback_sender sender,
+                     const controller_operation_callback_t *operations,
+                     size_t number_of_operations);
+
+#endif // ZODIAC_CONTROLLER_H
@@ -0,0 +1,48 @@
+/**
+ * @file controller_operation_callback.h
+ * @brief Defines the callback that implements a single controller operation.
+ *
+ * Each controller exposes a table of operations. An operation is selected by the
+ * `operation_index` of an instruction header and is invoked by the executor with
+ * the header and operands of the instruction being executed.
+ */
+
+#ifndef ZODIAC_CONTROLLER_OPERATION_CALLBACK_H
+#define ZODIAC_CONTROLLER_OPERATION_CALLBACK_H
+
+#include "../instruction/instruction.h"  ///< Include the definition for instruction_header_t
+
+/**
+ * @brief Forward declaration of the executor running the operation.
+ */
+struct executor_s;
+
+/**
+ * @enum controller_operation_result_e
+ * @brief Enumerates the results an operation can report back to the executor.
+ */
+typedef enum controller_operation_result_e {
+    CONTROLLER_OPERATION_RESULT_CONTINUE, ///< Proceed with the next instruction.
+    CONTROLLER_OPERATION_RESULT_HALT,     ///< Stop the execution successfully.
+    CONTROLLER_OPERATION_RESULT_ERROR     ///< Stop the execution due to an operation failure.
+} controller_operation_result_t;
+
+/**
+ * @typedef controller_operation_callback_t
+ * @brief Function pointer type for the callback implementing a controller operation.
+ *
+ * The operands pointer refers to exactly `header->number_of_operands` bytes and is
+ * only valid for the duration of the call. Control flow is changed by seeking the
+ * executor (see executor_seek()).
+ *
+ * @param[in] sender The context of the controller that owns the operation.
+ * @param[in,out] executor The executor running the instruction.
+ * @param[in] header The header of the instruction being executed.
+ * @param[in] operands The operands of the instruction being executed.
+ * @return Returns a value of controller_operation_result_t telling the executor how to proceed.
+ */
+typedef controller_operation_result_t (*controller_operation_callback_t)
+        (callback_sender sender, struct executor_s *executor,
+         const instruction_header_t *header, const instruction_operand_t *operands);
+
+#endif // ZODIAC_CONTROLLER_OPERATION_CALLBACK_H
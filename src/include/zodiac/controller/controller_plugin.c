@@ -0,0 +1,113 @@
+#include "controller_plugin.h"
+
+#include <dlfcn.h>
+#include <stdio.h>
+
+/**
+ * @brief Keeps the message of the last failure of the dynamic loader in a plug-in.
+ */
+static void controller_plugin_keep_message(controller_plugin_t *plugin) {
+    const char *message = dlerror();
+    snprintf(plugin->message, sizeof(plugin->message), "%s", message != nullptr ? message : "unknown error");
+}
+
+controller_plugin_error_t controller_plugin_register(controller_plugin_t *plugin,
+                                                     const controller_plugin_descriptor_t *descriptor,
+                                                     controller_registry_t *registry,
+                                                     controller_index_t controller_index) {
+
+    controller_t controller;
+    callback_sender sender = nullptr;
+
+    plugin->handle = nullptr;
+    plugin->descriptor = descriptor;
+    plugin->sender = nullptr;
+    plugin->registry = nullptr;
+    plugin->controller_index = controller_index;
+    plugin->message[0] = '\0';
+
+    if (descriptor->abi_version != CONTROLLER_PLUGIN_ABI_VERSION) {
+        return CONTROLLER_PLUGIN_ERROR_VERSION;
+    }
+
+    if (descriptor->number_of_operations > MAX_NUMBER_OF_CONTROLLER_OPERATIONS) {
+        return CONTROLLER_PLUGIN_ERROR_TOO_MANY_OPERATIONS;
+    }
+
+    // Checked before the init hook, so a taken index never creates a context.
+    if (registry->controllers[controller_index].operations != nullptr) {
+        return CONTROLLER_PLUGIN_ERROR_OCCUPIED;
+    }
+
+    if (descriptor->init != nullptr && !descriptor->init(controller_index, &sender)) {
+        return CONTROLLER_PLUGIN_ERROR_INIT;
+    }
+
+    controller_init(&controller, sender, descriptor->operations, descriptor->number_of_operations);
+
+    if (controller_registry_register(registry, controller_index, &controller) != CONTROLLER_REGISTRY_ERROR_OK) {
+        if (descriptor->teardown != nullptr) {
+            descriptor->teardown(sender);
+        }
+
+        return CONTROLLER_PLUGIN_ERROR_OCCUPIED;
+    }
+
+    plugin->sender = sender;
+    plugin->registry = registry;
+    return CONTROLLER_PLUGIN_ERROR_OK;
+}
+
+controller_plugin_error_t controller_plugin_load(controller_plugin_t *plugin,
+                                                 const char *path,
+                                                 controller_registry_t *registry,
+                                                 controller_index_t controller_index) {
+
+    const controller_plugin_descriptor_t *descriptor;
+    controller_plugin_error_t error;
+    void *handle = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+
+    plugin->handle = nullptr;
+    plugin->registry = nullptr;
+    plugin->message[0] = '\0';
+
+    if (handle == nullptr) {
+        controller_plugin_keep_message(plugin);
+        return CONTROLLER_PLUGIN_ERROR_OPEN;
+    }
+
+    descriptor = dlsym(handle, CONTROLLER_PLUGIN_SYMBOL);
+    if (descriptor == nullptr) {
+        controller_plugin_keep_message(plugin);
+        dlclose(handle);
+        return CONTROLLER_PLUGIN_ERROR_SYMBOL;
+    }
+
+    error = controller_plugin_register(plugin, descriptor, registry, controller_index);
+    if (error != CONTROLLER_PLUGIN_ERROR_OK) {
+        dlclose(handle);
+        return error;
+    }
+
+    plugin->handle = handle;
+    return CONTROLLER_PLUGIN_ERROR_OK;
+}
+
+void controller_plugin_unload(controller_plugin_t *plugin) {
+    if (plugin->registry == nullptr) {
+        return;
+    }
+
+    controller_registry_unregister(plugin->registry, plugin->controller_index);
+
+    if (plugin->descriptor->teardown != nullptr) {
+        plugin->descriptor->teardown(plugin->sender);
+    }
+
+    if (plugin->handle != nullptr) {
+        dlclose(plugin->handle);
+    }
+
+    plugin->handle = nullptr;
+    plugin->registry = nullptr;
+}
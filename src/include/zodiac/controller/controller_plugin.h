@@ -0,0 +1,154 @@
+/**
+ * @file controller_plugin.h
+ * @brief Defines the ABI of controllers shipped as shared libraries.
+ *
+ * A plug-in exports a controller_plugin_descriptor_t under the name
+ * CONTROLLER_PLUGIN_SYMBOL, most easily with CONTROLLER_PLUGIN_DEFINE(). The descriptor
+ * holds the table of operations and the hooks creating and destroying the context they
+ * receive. Loading a plug-in opens the library, checks the descriptor, runs its init hook
+ * and registers the controller, so that dispatching to its operations costs the same
+ * indexed call as to a controller built into the VM.
+ *
+ * Plug-ins calling back into the VM, e.g. executor_seek(), rely on the host exporting
+ * the symbols of the core.
+ */
+
+#ifndef ZODIAC_CONTROLLER_PLUGIN_H
+#define ZODIAC_CONTROLLER_PLUGIN_H
+
+#include "controller_registry.h"  // Registry the controllers are registered into.
+
+/**
+ * @brief Version of the plug-in ABI, bumped whenever the descriptor or the operation callback change.
+ */
+#define CONTROLLER_PLUGIN_ABI_VERSION 1
+
+/**
+ * @brief Name of the symbol holding the descriptor of a plug-in.
+ */
+#define CONTROLLER_PLUGIN_SYMBOL "zodiac_controller_plugin"
+
+/**
+ * @brief Max length of the message of the dynamic loader kept by a plug-in, including the terminator.
+ */
+#define CONTROLLER_PLUGIN_MAX_MESSAGE_LENGTH 256
+
+/**
+ * @enum controller_plugin_error_e
+ * @brief Enumerates possible errors that can occur when loading a plug-in.
+ */
+typedef enum controller_plugin_error_e {
+    CONTROLLER_PLUGIN_ERROR_OK,                   ///< No error occurred, the controller is registered.
+    CONTROLLER_PLUGIN_ERROR_OPEN,                 ///< The library could not be opened.
+    CONTROLLER_PLUGIN_ERROR_SYMBOL,               ///< The library exports no descriptor.
+    CONTROLLER_PLUGIN_ERROR_VERSION,              ///< The descriptor was built for another ABI version.
+    CONTROLLER_PLUGIN_ERROR_TOO_MANY_OPERATIONS,  ///< The descriptor declares more operations than can be addressed.
+    CONTROLLER_PLUGIN_ERROR_INIT,                 ///< The init hook of the plug-in failed.
+    CONTROLLER_PLUGIN_ERROR_OCCUPIED              ///< The controller index is already in use.
+} controller_plugin_error_t;
+
+/**
+ * @typedef controller_plugin_init_callback_t
+ * @brief Function pointer type for the hook creating the context of the operations of a plug-in.
+ *
+ * @param[in] controller_index The index the controller is about to be registered under.
+ * @param[out] sender The context passed to the operations and to the teardown hook.
+ * @return Whether the plug-in is ready, its operations are not registered otherwise.
+ */
+typedef bool (*controller_plugin_init_callback_t)(controller_index_t controller_index, callback_sender *sender);
+
+/**
+ * @typedef controller_plugin_teardown_callback_t
+ * @brief Function pointer type for the hook destroying the context created by the init hook.
+ *
+ * @param[in] sender The context returned by the init hook.
+ */
+typedef void (*controller_plugin_teardown_callback_t)(callback_sender sender);
+
+/**
+ * @struct controller_plugin_descriptor_s
+ * @brief Structure that describes the controller exported by a plug-in.
+ */
+typedef struct controller_plugin_descriptor_s {
+    uint32_t abi_version;                                ///< CONTROLLER_PLUGIN_ABI_VERSION the plug-in was built with.
+    const char *name;                                    ///< Human-readable name of the controller.
+    const controller_operation_callback_t *operations;   ///< Table of operations indexed by operation_index_t.
+    size_t number_of_operations;                         ///< Number of entries in the table of operations.
+    controller_plugin_init_callback_t init;              ///< Creates the context of the operations, or nullptr.
+    controller_plugin_teardown_callback_t teardown;      ///< Destroys the context of the operations, or nullptr.
+} controller_plugin_descriptor_t;
+
+/**
+ * @brief Exports a descriptor from a plug-in.
+ *
+ * @param name The name of the controller, a string literal.
+ * @param operations The table of operations, an array.
+ * @param init The init hook, or nullptr.
+ * @param teardown The teardown hook, or nullptr.
+ */
+#define CONTROLLER_PLUGIN_DEFINE(name, operations, init, teardown)                                 \
+    ZDC_DLLEXPORT const controller_plugin_descriptor_t zodiac_controller_plugin = {                \
+            CONTROLLER_PLUGIN_ABI_VERSION,                                                         \
+            (name),                                                                                \
+            (operations),                                                                          \
+            sizeof(operations) / sizeof((operations)[0]),                                          \
+            (init),                                                                                \
+            (teardown)                                                                             \
+    }
+
+/**
+ * @struct controller_plugin_s
+ * @brief Structure that holds a controller registered from a descriptor.
+ */
+typedef struct controller_plugin_s {
+    void *handle;                                        ///< The library of the plug-in, nullptr if linked in.
+    const controller_plugin_descriptor_t *descriptor;    ///< The descriptor of the controller.
+    callback_sender sender;                              ///< The context returned by the init hook.
+    controller_registry_t *registry;                     ///< The registry the controller is registered into.
+    controller_index_t controller_index;                 ///< The index the controller is registered under.
+    char message[CONTROLLER_PLUGIN_MAX_MESSAGE_LENGTH];  ///< Why the dynamic loader failed, empty otherwise.
+} controller_plugin_t;
+
+/**
+ * @brief Initializes a controller from a descriptor and registers it.
+ *
+ * This is also how controllers linked into the host use the plug-in ABI.
+ *
+ * @param[out] plugin Pointer to the plug-in structure to initialize.
+ * @param[in] descriptor The descriptor, which must outlive the plug-in.
+ * @param[in,out] registry The registry to register the controller into.
+ * @param[in] controller_index The index under which the controller is addressed by instructions.
+ * @return controller_plugin_error_t Error code resulting from the operation.
+ */
+controller_plugin_error_t controller_plugin_register(controller_plugin_t *plugin,
+                                                     const controller_plugin_descriptor_t *descriptor,
+                                                     controller_registry_t *registry,
+                                                     controller_index_t controller_index);
+
+/**
+ * @brief Opens a plug-in library and registers its controller.
+ *
+ * When the library cannot be opened or exports no descriptor, the message of dlerror()
+ * is kept in the `message` field of the plug-in.
+ *
+ * @param[out] plugin Pointer to the plug-in structure to initialize.
+ * @param[in] path The path of the library, searched as by dlopen().
+ * @param[in,out] registry The registry to register the controller into.
+ * @param[in] controller_index The index under which the controller is addressed by instructions.
+ * @return controller_plugin_error_t Error code resulting from the operation.
+ */
+controller_plugin_error_t controller_plugin_load(controller_plugin_t *plugin,
+                                                 const char *path,
+                                                 controller_registry_t *registry,
+                                                 controller_index_t controller_index);
+
+/**
+ * @brief Unregisters the controller of a plug-in, runs its teardown hook and closes its library.
+ *
+ * No executor may run instructions of the controller afterwards.
+ *
+ * @param[in,out] plugin Pointer to the plug-in.
+ */
+void controller_plugin_unload(controller_plugin_t *plugin);
+
+#endif // ZODIAC_CONTROLLER_PLUGIN_H
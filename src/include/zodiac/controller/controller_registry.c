@@ -0,0 +1,27 @@
+#include "controller_registry.h"
+
+void controller_registry_init(controller_registry_t *registry) {
+    for (size_t index = 0; index < MAX_NUMBER_OF_CONTROLLERS; ++index) {
+        controller_init(&registry->controllers[index], nullptr, nullptr, 0);
+    }
+}
+
+controller_registry_error_t controller_registry_register(controller_registry_t *registry,
+                                                         controller_index_t controller_index,
+                                                         const controller_t *controller) {
+
+    if (controller->number_of_operations > MAX_NUMBER_OF_CONTROLLER_OPERATIONS) {
+        return CONTROLLER_REGISTRY_ERROR_TOO_MANY_OPERATIONS;
+    }
+
+    if (registry->controllers[controller_index].operations != nullptr) {
+        return CONTROLLER_REGISTRY_ERROR_OCCUPIED;
+    }
+
+    registry->controllers[controller_index] = *controller;
+    return CONTROLLER_REGISTRY_ERROR_OK;
+}
+
+void controller_registry_unregister(controller_registry_t *registry, controller_index_t controller_index) {
+    controller_init(&registry->controllers[controller_index], nullptr, nullptr, 0);
+}
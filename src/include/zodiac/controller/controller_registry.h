@@ -0,0 +1,80 @@
+/**
+ * @file controller_registry.h
+ * @brief Defines the controller registry used as the executor dispatch table.
+ *
+ * The registry is a two-level jump table: the first level is indexed by
+ * `controller_index_t` and holds one entry per controller slot, the second level is
+ * the operation table of the registered controller indexed by `operation_index_t`.
+ * Empty slots hold an empty operation table, so a single bounds check on the
+ * operation index covers both unknown controllers and unknown operations.
+ */
+
+#ifndef ZODIAC_CONTROLLER_REGISTRY_H
+#define ZODIAC_CONTROLLER_REGISTRY_H
+
+#include "controller.h"  ///< Include the controller descriptor.
+
+/**
+ * @enum controller_registry_error_e
+ * @brief Enumerates possible errors that can occur when registering controllers.
+ */
+typedef enum controller_registry_error_e {
+    CONTROLLER_REGISTRY_ERROR_OK,                  ///< No error occurred.
+    CONTROLLER_REGISTRY_ERROR_OCCUPIED,            ///< The controller index is already in use.
+    CONTROLLER_REGISTRY_ERROR_TOO_MANY_OPERATIONS  ///< The controller declares more operations than can be addressed.
+} controller_registry_error_t;
+
+/**
+ * @struct controller_registry_s
+ * @brief Structure that holds one controller per controller index.
+ */
+typedef struct controller_registry_s {
+    controller_t controllers[MAX_NUMBER_OF_CONTROLLERS]; ///< Controllers indexed by controller_index_t.
+} controller_registry_t;
+
+/**
+ * @brief Initializes an empty controller registry.
+ *
+ * @param[out] registry Pointer to the registry to initialize.
+ */
+void controller_registry_init(controller_registry_t *registry);
+
+/**
+ * @brief Registers a controller under the given controller index.
+ *
+ * The descriptor is copied into the registry, the operation table it refers to is not.
+ *
+ * @param[in,out] registry Pointer to the registry.
+ * @param[in] controller_index The index under which the controller is addressed by instructions.
+ * @param[in] controller The controller to register.
+ * @return controller_registry_error_t Error code resulting from the registration.
+ */
+controller_registry_error_t controller_registry_register(controller_registry_t *registry,
+                                                         controller_index_t controller_index,
+                                                         const controller_t *controller);
+
+/**
+ * @brief Removes the controller registered under the given controller index.
+ *
+ * @param[in,out] registry Pointer to the registry.
+ * @param[in] controller_index The index of the controller to remove.
+ */
+void controller_registry_unregister(controller_registry_t *registry, controller_index_t controller_index);
+
+/**
+ * @brief Looks up the operation addressed by an instruction header.
+ *
+ * @param[in] registry Pointer to the registry.
+ * @param[in] header The instruction header to resolve.
+ * @return The operation callback, or nullptr if the controller or the operation is unknown.
+ */
+ZDC_STATIC_INLINE controller_operation_callback_t controller_registry_lookup(const controller_registry_t *registry,
+                                                                             const instruction_header_t *header) {
+
+    const controller_t *controller = &registry->controllers[header->controller_index];
+    return header->operation_index < controller->number_of_operations
+           ? controller->operations[header->operation_index]
+           : nullptr;
+}
+
+#endif // ZODIAC_CONTROLLER_REGISTRY_H
@@ -0,0 +1,378 @@
+#include "executor.h"
+#include "../instruction/instruction_reader_buffer.h"
+#include "../runtime/tracer/tracer.h"
+
+#ifdef ZODIAC_COMPILER_COMPUTED_GOTO
+/// Continues at the label handling the operation result through the threaded dispatch table.
+#   define EXECUTOR_DISPATCH(result) goto *dispatch_table[(result)]
+/// Declares the threaded dispatch table of a run loop, indexed by operation result.
+#   define EXECUTOR_DISPATCH_TABLE_DECLARE()                                      \
+        static void *const dispatch_table[] = {                                   \
+                [CONTROLLER_OPERATION_RESULT_CONTINUE] = &&fetch,                 \
+                [CONTROLLER_OPERATION_RESULT_HALT] = &&halt,                      \
+                [CONTROLLER_OPERATION_RESULT_ERROR] = &&operation_error           \
+        }
+#else
+/// Continues at the label handling the operation result through a switch.
+#   define EXECUTOR_DISPATCH(result)                          \
+        switch (result) {                                     \
+            case CONTROLLER_OPERATION_RESULT_CONTINUE:        \
+                goto fetch;                                   \
+            case CONTROLLER_OPERATION_RESULT_HALT:            \
+                goto halt;                                    \
+            default:                                          \
+                goto operation_error;                         \
+        }
+/// Run loops dispatching through a switch need no table.
+#   define EXECUTOR_DISPATCH_TABLE_DECLARE() do { } while (0)
+#endif
+
+/**
+ * @brief Dispatches an instruction to its operation and continues with the operation result.
+ *
+ * Expands inside the run loops, which provide the `registry`, `controller`, `operation`,
+ * `result` and `sample` variables as well as the labels targeted by EXECUTOR_DISPATCH.
+ * Both operations beyond the table and holes in it are reported as unknown.
+ */
+#define EXECUTOR_EXECUTE(header, operands)                                                          \
+    do {                                                                                            \
+        controller = &registry->controllers[(header)->controller_index];                            \
+        if ((header)->operation_index >= controller->number_of_operations                           \
+            || (operation = controller->operations[(header)->operation_index]) == nullptr) {        \
+            return executor->status = EXECUTOR_STATUS_UNKNOWN_OPERATION;                            \
+        }                                                                                           \
+                                                                                                    \
+        PROFILER_SAMPLE_BEGIN(sample);                                                              \
+        result = operation(controller->sender, executor, (header), (operands));                     \
+        PROFILER_SAMPLE_END(executor->profiler, (header), sample);                                  \
+        ++executor->number_of_executed_instructions;                                                \
+        EXECUTOR_DISPATCH(result);                                                                  \
+    } while (0)
+
+/**
+ * @brief Runs instructions pulled from the reader of the executor until `limit` instructions have been executed.
+ */
+static executor_status_t executor_run_stream(executor_t *executor, uint64_t limit) {
+    const controller_registry_t *registry = executor->registry;
+    instruction_reader_t *reader = executor->reader;
+    instruction_t *instruction = &executor->instruction;
+    const controller_t *controller;
+    controller_operation_callback_t operation;
+    controller_operation_result_t result;
+    instruction_reader_read_error_t read_error;
+    PROFILER_SAMPLE_DECLARE(sample);
+
+    EXECUTOR_DISPATCH_TABLE_DECLARE();
+
+fetch:
+    if (executor->number_of_executed_instructions >= limit) {
+        return executor->status = EXECUTOR_STATUS_YIELDED;
+    }
+
+    read_error = instruction_reader_read(reader, instruction);
+    if (read_error != INSTRUCTION_READER_READ_ERROR_OK) {
+        goto read_failed;
+    }
+
+    EXECUTOR_EXECUTE(&instruction->header, instruction->operands);
+
+halt:
+    return executor->status = EXECUTOR_STATUS_HALTED;
+
+operation_error:
+    return executor->status = EXECUTOR_STATUS_OPERATION_ERROR;
+
+read_failed:
+    return executor->status = read_error == INSTRUCTION_READER_READ_ERROR_END
+                              ? EXECUTOR_STATUS_COMPLETED
+                              : EXECUTOR_STATUS_READ_ERROR;
+}
+
+/**
+ * @brief Defines a loop running instructions pulled from a reader of a known backend.
+ *
+ * The loop, named `executor_run_stream_name`, reads through the specialized functions of
+ * the backend, see INSTRUCTION_READER_SPECIALIZE(), so reads are inlined into the loop and
+ * dispatch operates on views instead of copies of the instructions.
+ *
+ * @param name Name of the specialized reader backend.
+ */
+#define EXECUTOR_SPECIALIZE_STREAM(name)                                                            \
+    static executor_status_t executor_run_stream_##name(executor_t *executor, uint64_t limit) {     \
+        const controller_registry_t *registry = executor->registry;                                 \
+        instruction_reader_t *reader = executor->reader;                                            \
+        const controller_t *controller;                                                             \
+        controller_operation_callback_t operation;                                                  \
+        controller_operation_result_t result;                                                       \
+        instruction_reader_read_error_t read_error;                                                 \
+        instruction_view_t view;                                                                    \
+        PROFILER_SAMPLE_DECLARE(sample);                                                            \
+                                                                                                    \
+        EXECUTOR_DISPATCH_TABLE_DECLARE();                                                          \
+                                                                                                    \
+    fetch:                                                                                          \
+        if (executor->number_of_executed_instructions >= limit) {                                   \
+            return executor->status = EXECUTOR_STATUS_YIELDED;                                      \
+        }                                                                                           \
+                                                                                                    \
+        read_error = instruction_reader_view_##name(reader, &view);                                 \
+        if (read_error != INSTRUCTION_READER_READ_ERROR_OK) {                                       \
+            goto read_failed;                                                                       \
+        }                                                                                           \
+                                                                                                    \
+        EXECUTOR_EXECUTE(view.header, view.operands);                                               \
+                                                                                                    \
+    halt:                                                                                           \
+        return executor->status = EXECUTOR_STATUS_HALTED;                                           \
+                                                                                                    \
+    operation_error:                                                                                \
+        return executor->status = EXECUTOR_STATUS_OPERATION_ERROR;                                  \
+                                                                                                    \
+    read_failed:                                                                                    \
+        return executor->status = read_error == INSTRUCTION_READER_READ_ERROR_END                   \
+                                  ? EXECUTOR_STATUS_COMPLETED                                       \
+                                  : EXECUTOR_STATUS_READ_ERROR;                                     \
+    }
+
+EXECUTOR_SPECIALIZE_STREAM(buffer)
+
+/**
+ * @brief Runs instructions in place from the program of the executor until `limit` instructions have been executed.
+ */
+static executor_status_t executor_run_program(executor_t *executor, uint64_t limit) {
+    const controller_registry_t *registry = executor->registry;
+    const instruction_program_t *program = executor->program;
+    const controller_t *controller;
+    controller_operation_callback_t operation;
+    controller_operation_result_t result;
+    instruction_reader_read_error_t read_error;
+    instruction_view_t view;
+    PROFILER_SAMPLE_DECLARE(sample);
+
+    EXECUTOR_DISPATCH_TABLE_DECLARE();
+
+fetch:
+    if (executor->number_of_executed_instructions >= limit) {
+        return executor->status = EXECUTOR_STATUS_YIELDED;
+    }
+
+    read_error = instruction_program_view(program, (instruction_reader_offset_t) executor->position, &view);
+    if (read_error != INSTRUCTION_READER_READ_ERROR_OK) {
+        goto read_failed;
+    }
+
+    executor->position += instruction_packed_size(view.header);
+    EXECUTOR_EXECUTE(view.header, view.operands);
+
+halt:
+    return executor->status = EXECUTOR_STATUS_HALTED;
+
+operation_error:
+    return executor->status = EXECUTOR_STATUS_OPERATION_ERROR;
+
+read_failed:
+    return executor->status = read_error == INSTRUCTION_READER_READ_ERROR_END
+                              ? EXECUTOR_STATUS_COMPLETED
+                              : EXECUTOR_STATUS_READ_ERROR;
+}
+
+/**
+ * @brief Runs the entries of the image of the executor until `limit` instructions have been executed.
+ *
+ * Positions past the end of the entries hold an offset within an instruction, see
+ * executor_image_resolve(); the instruction decoded there is dispatched through the
+ * registry, off the path of the entries.
+ */
+static executor_status_t executor_run_image(executor_t *executor, uint64_t limit) {
+    const executor_image_t *image = executor->image;
+    const executor_image_entry_t *entries = image->entries;
+    const executor_image_binding_t *bindings = image->bindings;
+    const uint8_t *code = image->program.code;
+    size_t number_of_entries = image->number_of_entries;
+    const controller_registry_t *registry;
+    uint64_t executed;
+    size_t position;
+    const executor_image_entry_t *entry;
+    const executor_image_binding_t *binding;
+    const instruction_header_t *header;
+    const controller_t *controller;
+    controller_operation_callback_t operation;
+    controller_operation_result_t result;
+    instruction_reader_read_error_t read_error;
+    instruction_view_t view;
+    size_t offset;
+    PROFILER_SAMPLE_DECLARE(sample);
+
+    EXECUTOR_DISPATCH_TABLE_DECLARE();
+
+fetch:
+    executed = executor->number_of_executed_instructions;
+    position = executor->position;
+
+next:
+    if (executed >= limit) {
+        return executor->status = EXECUTOR_STATUS_YIELDED;
+    }
+
+    if (position >= number_of_entries) {
+        if (position == number_of_entries) {
+            return executor->status = EXECUTOR_STATUS_COMPLETED;
+        }
+
+        goto decode;
+    }
+
+    entry = &entries[position];
+    binding = &bindings[entry->binding];
+    header = (const instruction_header_t *) (code + entry->offset);
+    position += entry->length;
+    executor->position = position;
+
+    PROFILER_SAMPLE_BEGIN(sample);
+    result = binding->operation(binding->sender, executor, header, (const instruction_operand_t *) (header + 1));
+    PROFILER_SAMPLE_END(executor->profiler, header, sample);
+    executed += entry->length;
+    executor->number_of_executed_instructions = executed;
+
+    // Comparing instead of reloading keeps the position off memory unless an operation seeks.
+    if (result == CONTROLLER_OPERATION_RESULT_CONTINUE && executor->position == position) {
+        goto next;
+    }
+
+    EXECUTOR_DISPATCH(result);
+
+decode:
+    entry = nullptr;
+    registry = image->registry;
+    offset = position - number_of_entries - 1;
+    read_error = instruction_program_view(&image->program, (instruction_reader_offset_t) offset, &view);
+    if (read_error != INSTRUCTION_READER_READ_ERROR_OK) {
+        return executor->status = EXECUTOR_STATUS_READ_ERROR;
+    }
+
+    executor->position = executor_image_resolve(image,
+                                                (instruction_reader_offset_t) (offset + instruction_packed_size(view.header)));
+    EXECUTOR_EXECUTE(view.header, view.operands);
+
+halt:
+    return executor->status = EXECUTOR_STATUS_HALTED;
+
+operation_error:
+    if (entry != nullptr && bindings[entry->binding].operation == executor_image_unknown_operation) {
+        executor->number_of_executed_instructions -= entry->length;
+        return executor->status = EXECUTOR_STATUS_UNKNOWN_OPERATION;
+    }
+
+    return executor->status = EXECUTOR_STATUS_OPERATION_ERROR;
+}
+
+void executor_init(executor_t *executor, const controller_registry_t *registry, instruction_reader_t *reader) {
+    executor->registry = registry;
+    executor->reader = reader;
+    executor->program = nullptr;
+    executor->image = nullptr;
+    executor->position = 0;
+    executor->number_of_executed_instructions = 0;
+    executor->status = EXECUTOR_STATUS_READY;
+    executor->logger = nullptr;
+#ifdef ZODIAC_PROFILER
+    executor->profiler = nullptr;
+#endif
+}
+
+void executor_init_program(executor_t *executor,
+                           const controller_registry_t *registry,
+                           const instruction_program_t *program) {
+
+    executor_init(executor, registry, nullptr);
+    executor->program = program;
+}
+
+void executor_init_image(executor_t *executor, const executor_image_t *image) {
+    executor_init(executor, nullptr, nullptr);
+    executor->image = image;
+}
+
+#ifdef ZODIAC_PROFILER
+void executor_set_profiler(executor_t *executor, profiler_t *profiler) {
+    executor->profiler = profiler;
+}
+#endif
+
+/**
+ * @brief Runs the executor from whichever source it was initialized with.
+ */
+static executor_status_t executor_run_until(executor_t *executor, uint64_t limit) {
+    executor_status_t status;
+
+    TRACER_BEGIN("executor.run");
+
+    if (executor->image != nullptr) {
+        status = executor_run_image(executor, limit);
+    } else if (executor->program != nullptr) {
+        status = executor_run_program(executor, limit);
+    } else if (instruction_reader_is_buffer(executor->reader)) {
+        status = executor_run_stream_buffer(executor, limit);
+    } else {
+        status = executor_run_stream(executor, limit);
+    }
+
+    TRACER_END("executor.run");
+
+#ifdef ZODIAC_PROFILER
+    // Dumps requested once the last sample was recorded are written when the run returns.
+    if (executor->profiler != nullptr) {
+        profiler_poll(executor->profiler);
+    }
+#endif
+
+    return status;
+}
+
+executor_status_t executor_run(executor_t *executor) {
+    return executor_run_until(executor, UINT64_MAX);
+}
+
+executor_status_t executor_run_slice(executor_t *executor, uint64_t number_of_instructions) {
+    uint64_t limit = executor->number_of_executed_instructions + number_of_instructions;
+
+    if (limit < number_of_instructions) {
+        limit = UINT64_MAX;
+    }
+
+    return executor_run_until(executor, limit);
+}
+
+void executor_set_logger(executor_t *executor, logger_t *logger) {
+    executor->logger = logger;
+}
+
+void executor_seek(executor_t *executor, instruction_reader_offset_t offset, instruction_reader_seek_mode_t mode) {
+    const executor_image_t *image = executor->image;
+
+    if (image != nullptr) {
+        size_t position = instruction_packed_seek((size_t) executor_image_offset(image, executor->position),
+                                                  image->program.size, offset, mode);
+        executor->position = executor_image_resolve(image, (instruction_reader_offset_t) position);
+    } else if (executor->program != nullptr) {
+        executor->position = instruction_packed_seek(executor->position, executor->program->size, offset, mode);
+    } else if (instruction_reader_is_buffer(executor->reader)) {
+        instruction_reader_seek_buffer(executor->reader, offset, mode);
+    } else {
+        instruction_reader_seek(executor->reader, offset, mode);
+    }
+}
+
+instruction_reader_offset_t executor_tell(executor_t *executor) {
+    if (executor->image != nullptr) {
+        return executor_image_offset(executor->image, executor->position);
+    }
+
+    if (executor->program != nullptr) {
+        return (instruction_reader_offset_t) executor->position;
+    }
+
+    return instruction_reader_is_buffer(executor->reader)
+           ? instruction_reader_tell_buffer(executor->reader)
+           : instruction_reader_tell(executor->reader);
+}
@@ -0,0 +1,158 @@
+/**
+ * @file executor.h
+ * @brief Defines the executor that runs instruction streams.
+ *
+ * The executor pulls instructions from an instruction reader, straight from a decoded
+ * program or from a pre-decoded image, and dispatches each of them through the controller registry to the
+ * operation addressed by its header. Operations steer control flow by seeking the
+ * executor, which forwards the request to the underlying reader or moves its position
+ * within the program.
+ *
+ * Readers of a backend specialized with INSTRUCTION_READER_SPECIALIZE(), such as the
+ * buffer reader of instruction_reader_buffer.h, are recognized and run by a loop built for
+ * that backend, which inlines the reads instead of calling through the reader.
+ */
+
+#ifndef ZODIAC_EXECUTOR_H
+#define ZODIAC_EXECUTOR_H
+
+#include "../controller/controller_registry.h"     // Dispatch table of controllers.
+#include "executor_image.h"                        // Pre-decoded source of the instructions.
+#include "../instruction/instruction_program.h"    // Decoded source of the instructions.
+#include "../instruction/instruction_reader.h"     // Streaming source of the instructions.
+#include "../runtime/logger/logger.h"              // Logger of the instance.
+#include "../runtime/profiler/profiler.h"          // Per-operation execution profile.
+
+/**
+ * @enum executor_status_e
+ * @brief Enumerates the states in which the executor stops.
+ */
+typedef enum executor_status_e {
+    EXECUTOR_STATUS_READY,             ///< The executor has not been run yet.
+    EXECUTOR_STATUS_COMPLETED,         ///< The end of the instruction stream has been reached.
+    EXECUTOR_STATUS_HALTED,            ///< An operation requested the execution to stop.
+    EXECUTOR_STATUS_READ_ERROR,        ///< The reader failed to provide the next instruction.
+    EXECUTOR_STATUS_UNKNOWN_OPERATION, ///< The instruction addresses an unregistered controller or operation.
+    EXECUTOR_STATUS_OPERATION_ERROR,   ///< An operation reported a failure.
+    EXECUTOR_STATUS_YIELDED            ///< The instruction budget of executor_run_slice() is exhausted.
+} executor_status_t;
+
+/**
+ * @struct executor_s
+ * @brief Structure that holds the execution state of a single instruction stream.
+ */
+typedef struct executor_s {
+    const controller_registry_t *registry;    ///< Dispatch table of controllers.
+    instruction_reader_t *reader;             ///< Streaming source of the instructions, if any.
+    const instruction_program_t *program;     ///< Decoded source of the instructions, if any.
+    const executor_image_t *image;            ///< Pre-decoded source of the instructions, if any.
+    size_t position;                          ///< Offset of the next instruction within the program, or position
+                                              ///< within the image, see executor_image_resolve().
+    instruction_t instruction;                ///< The instruction being executed when streaming.
+    uint64_t number_of_executed_instructions; ///< Number of instructions executed so far.
+    executor_status_t status;                 ///< The state in which the executor stopped last.
+    logger_t *logger;                         ///< Logger of this instance for its operations, if any.
+#ifdef ZODIAC_PROFILER
+    profiler_t *profiler;                     ///< Profile receiving the dispatched operations, if any.
+#endif
+} executor_t;
+
+/**
+ * @brief Initializes an executor.
+ *
+ * @param[out] executor Pointer to the executor to initialize.
+ * @param[in] registry The controller registry used to dispatch instructions.
+ * @param[in] reader The reader from which instructions are pulled.
+ */
+void executor_init(executor_t *executor, const controller_registry_t *registry, instruction_reader_t *reader);
+
+/**
+ * @brief Initializes an executor running a decoded program.
+ *
+ * Instructions are dispatched in place from the packed program without being copied.
+ *
+ * @param[out] executor Pointer to the executor to initialize.
+ * @param[in] registry The controller registry used to dispatch instructions.
+ * @param[in] program The program to run, which must outlive the executor.
+ */
+void executor_init_program(executor_t *executor,
+                           const controller_registry_t *registry,
+                           const instruction_program_t *program);
+
+/**
+ * @brief Initializes an executor running a pre-decoded image.
+ *
+ * Instructions are dispatched straight to the operations resolved when the image was
+ * linked, without parsing headers or looking operations up in a registry.
+ *
+ * @param[out] executor Pointer to the executor to initialize.
+ * @param[in] image The image to run, which must outlive the executor.
+ */
+void executor_init_image(executor_t *executor, const executor_image_t *image);
+
+#ifdef ZODIAC_PROFILER
+/**
+ * @brief Attaches a profiler counting the hits and cycles of the dispatched operations.
+ *
+ * Only available when built with ZODIAC_PROFILER. Executors running concurrently
+ * need profilers of their own, see profiler.h.
+ *
+ * @param[in,out] executor Pointer to the executor.
+ * @param[in] profiler The profiler receiving the samples, or nullptr to stop profiling.
+ */
+void executor_set_profiler(executor_t *executor, profiler_t *profiler);
+#endif
+
+/**
+ * @brief Runs instructions until the stream ends, an operation halts or an error occurs.
+ *
+ * @param[in,out] executor Pointer to the executor to run.
+ * @return executor_status_t The state in which the executor stopped.
+ */
+executor_status_t executor_run(executor_t *executor);
+
+/**
+ * @brief Runs at most the given number of instructions.
+ *
+ * Stops with EXECUTOR_STATUS_YIELDED when the budget is exhausted before the stream
+ * ends, an operation halts or an error occurs. Running the executor again resumes
+ * with the next instruction, which allows time slicing many executors on few threads.
+ *
+ * @param[in,out] executor Pointer to the executor to run.
+ * @param[in] number_of_instructions The instruction budget of the slice.
+ * @return executor_status_t The state in which the executor stopped.
+ */
+executor_status_t executor_run_slice(executor_t *executor, uint64_t number_of_instructions);
+
+/**
+ * @brief Sets the logger operations use for this executor.
+ *
+ * Giving every instance its own logger_t lets instances running on different threads
+ * log with their own level without sharing state; a logger forwarding to a
+ * logger_async_t is safe to share between threads as well.
+ *
+ * @param[in,out] executor Pointer to the executor.
+ * @param[in] logger The logger, or nullptr for none.
+ */
+void executor_set_logger(executor_t *executor, logger_t *logger);
+
+/**
+ * @brief Changes the position of the next instruction to execute.
+ *
+ * Intended to be called by operations implementing jumps, calls and returns.
+ *
+ * @param[in,out] executor Pointer to the executor.
+ * @param[in] offset Offset to apply from the seek mode's starting point.
+ * @param[in] mode The seek mode defining the starting point for the offset.
+ */
+void executor_seek(executor_t *executor, instruction_reader_offset_t offset, instruction_reader_seek_mode_t mode);
+
+/**
+ * @brief Reports the position of the next instruction to execute.
+ *
+ * @param[in] executor Pointer to the executor.
+ * @return The offset of the next instruction in the instruction stream.
+ */
+instruction_reader_offset_t executor_tell(executor_t *executor);
+
+#endif // ZODIAC_EXECUTOR_H
@@ -0,0 +1,160 @@
+#include "executor_fusion.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Returns the bit of the first filter covering a (controller, operation) pair.
+ */
+static size_t executor_fusion_filter_bit(controller_index_t controller_index, operation_index_t operation_index) {
+    return (size_t) controller_index * MAX_NUMBER_OF_CONTROLLER_OPERATIONS + operation_index;
+}
+
+/**
+ * @brief Packs the (controller, operation) indices of two instructions into a single key.
+ */
+static uint32_t executor_fusion_key(const instruction_header_t *first, const instruction_header_t *second) {
+    return (uint32_t) first->controller_index << 24 | (uint32_t) first->operation_index << 16 |
+           (uint32_t) second->controller_index << 8 | (uint32_t) second->operation_index;
+}
+
+/**
+ * @brief Unpacks a key built by executor_fusion_key().
+ */
+static executor_fusion_pattern_t executor_fusion_pattern(uint32_t key) {
+    executor_fusion_pattern_t pattern = {
+            {(controller_index_t) (key >> 24), (controller_index_t) (key >> 8)},
+            {(operation_index_t) (key >> 16), (operation_index_t) key}
+    };
+    return pattern;
+}
+
+static uint32_t executor_fusion_pattern_key(const executor_fusion_pattern_t *pattern) {
+    return (uint32_t) pattern->controller_indices[0] << 24 | (uint32_t) pattern->operation_indices[0] << 16 |
+           (uint32_t) pattern->controller_indices[1] << 8 | (uint32_t) pattern->operation_indices[1];
+}
+
+static int executor_fusion_compare_keys(const void *left, const void *right) {
+    uint32_t a = *(const uint32_t *) left;
+    uint32_t b = *(const uint32_t *) right;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Looks up the rule matching a pair of instructions.
+ *
+ * @return The rule, or nullptr if the pair is not fused.
+ */
+static const executor_fusion_rule_t *executor_fusion_find(const executor_fusion_t *fusion, uint32_t key) {
+    for (size_t index = 0; index < fusion->number_of_rules; ++index) {
+        if (executor_fusion_pattern_key(&fusion->rules[index].pattern) == key) {
+            return &fusion->rules[index];
+        }
+    }
+
+    return nullptr;
+}
+
+void executor_fusion_init(executor_fusion_t *fusion) {
+    fusion->number_of_rules = 0;
+    memset(fusion->first_filter, 0, sizeof(fusion->first_filter));
+}
+
+executor_fusion_error_t executor_fusion_add(executor_fusion_t *fusion, const executor_fusion_rule_t *rule) {
+    size_t bit = executor_fusion_filter_bit(rule->pattern.controller_indices[0], rule->pattern.operation_indices[0]);
+
+    if (executor_fusion_find(fusion, executor_fusion_pattern_key(&rule->pattern)) != nullptr) {
+        return EXECUTOR_FUSION_ERROR_DUPLICATE;
+    }
+
+    if (fusion->number_of_rules >= MAX_NUMBER_OF_FUSION_RULES) {
+        return EXECUTOR_FUSION_ERROR_FULL;
+    }
+
+    fusion->rules[fusion->number_of_rules++] = *rule;
+    fusion->first_filter[bit / 8] |= (uint8_t) (1u << (bit % 8));
+    return EXECUTOR_FUSION_ERROR_OK;
+}
+
+size_t executor_fusion_apply(const executor_fusion_t *fusion, executor_image_t *image) {
+    size_t number_of_fused_entries = 0;
+
+    for (size_t index = 0; index + 1 < image->number_of_entries; ++index) {
+        executor_image_entry_t *entry = &image->entries[index];
+        const instruction_header_t *header = executor_image_header(image, entry);
+        size_t bit = executor_fusion_filter_bit(header->controller_index, header->operation_index);
+        const executor_fusion_rule_t *rule;
+        size_t binding;
+
+        if ((fusion->first_filter[bit / 8] & (1u << (bit % 8))) == 0) {
+            continue;
+        }
+
+        rule = executor_fusion_find(fusion, executor_fusion_key(header, executor_fusion_second(header)));
+        if (rule == nullptr || (binding = executor_image_bind(image, rule->operation, rule->sender)) == SIZE_MAX) {
+            continue;
+        }
+
+        entry->binding = (uint16_t) binding;
+        entry->length = 2;
+        ++number_of_fused_entries;
+    }
+
+    return number_of_fused_entries;
+}
+
+size_t executor_fusion_hot_pairs(const executor_image_t *image,
+                                 executor_fusion_pair_t *pairs,
+                                 size_t max_number_of_pairs) {
+
+    size_t number_of_keys = image->number_of_entries > 1 ? image->number_of_entries - 1 : 0;
+    size_t number_of_pairs = 0;
+    uint32_t *keys;
+
+    if (number_of_keys == 0 || max_number_of_pairs == 0) {
+        return 0;
+    }
+
+    keys = platform_memory_allocate(nullptr, number_of_keys * sizeof(uint32_t));
+    if (keys == nullptr) {
+        return SIZE_MAX;
+    }
+
+    for (size_t index = 0; index < number_of_keys; ++index) {
+        keys[index] = executor_fusion_key(executor_image_header(image, &image->entries[index]),
+                                          executor_image_header(image, &image->entries[index + 1]));
+    }
+
+    qsort(keys, number_of_keys, sizeof(uint32_t), executor_fusion_compare_keys);
+
+    for (size_t start = 0, end; start < number_of_keys; start = end) {
+        size_t number_of_occurrences;
+        size_t position;
+
+        for (end = start + 1; end < number_of_keys && keys[end] == keys[start]; ++end) {
+        }
+
+        number_of_occurrences = end - start;
+
+        // Insert into the list kept sorted by decreasing number of occurrences.
+        position = number_of_pairs;
+        while (position > 0 && pairs[position - 1].number_of_occurrences < number_of_occurrences) {
+            --position;
+        }
+
+        if (position >= max_number_of_pairs) {
+            continue;
+        }
+
+        if (number_of_pairs < max_number_of_pairs) {
+            ++number_of_pairs;
+        }
+
+        memmove(&pairs[position + 1], &pairs[position], (number_of_pairs - 1 - position) * sizeof(pairs[0]));
+        pairs[position].pattern = executor_fusion_pattern(keys[start]);
+        pairs[position].number_of_occurrences = number_of_occurrences;
+    }
+
+    platform_memory_release(nullptr, keys);
+    return number_of_pairs;
+}
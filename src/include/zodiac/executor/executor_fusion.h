@@ -0,0 +1,138 @@
+/**
+ * @file executor_fusion.h
+ * @brief Defines superinstruction fusion for pre-decoded images.
+ *
+ * A fusion rule names a pair of adjacent (controller, operation) instructions and a
+ * fused operation executing both. Applying the rules to an image rebinds the entry of
+ * every matching first instruction to the fused operation and makes it continue past
+ * the second one, so the pair costs one dispatch instead of two. The entry of the
+ * second instruction is left untouched, so jumps landing on it still execute it alone.
+ * A fused pair still counts as two executed instructions, so the instruction budget of
+ * executor_run_slice() may be exceeded by one when it ends on a fused pair.
+ *
+ * A fused operation receives the header and operands of the first instruction; the
+ * second instruction immediately follows in the packed program and is reached with
+ * executor_fusion_second(). When it runs, the executor is already positioned after the
+ * second instruction. Candidate pairs can be picked from executor_fusion_hot_pairs().
+ */
+
+#ifndef ZODIAC_EXECUTOR_FUSION_H
+#define ZODIAC_EXECUTOR_FUSION_H
+
+#include "executor_image.h"  // Image whose entries are fused.
+
+/**
+ * @brief Max number of rules of a fusion table.
+ */
+#define MAX_NUMBER_OF_FUSION_RULES 256
+
+/**
+ * @enum executor_fusion_error_e
+ * @brief Enumerates possible errors that can occur when adding fusion rules.
+ */
+typedef enum executor_fusion_error_e {
+    EXECUTOR_FUSION_ERROR_OK,          ///< No error occurred.
+    EXECUTOR_FUSION_ERROR_FULL,        ///< The fusion table holds MAX_NUMBER_OF_FUSION_RULES rules already.
+    EXECUTOR_FUSION_ERROR_DUPLICATE    ///< A rule for the same pair already exists.
+} executor_fusion_error_t;
+
+/**
+ * @struct executor_fusion_pattern_s
+ * @brief Structure that identifies a pair of adjacent instructions.
+ */
+typedef struct executor_fusion_pattern_s {
+    controller_index_t controller_indices[2];   ///< Controller indices of the first and second instruction.
+    operation_index_t operation_indices[2];     ///< Operation indices of the first and second instruction.
+} executor_fusion_pattern_t;
+
+/**
+ * @struct executor_fusion_rule_s
+ * @brief Structure that binds a pair of instructions to a fused operation.
+ */
+typedef struct executor_fusion_rule_s {
+    executor_fusion_pattern_t pattern;          ///< The pair of instructions to fuse.
+    controller_operation_callback_t operation;  ///< The fused operation executing both instructions.
+    callback_sender sender;                     ///< The sender passed to the fused operation.
+} executor_fusion_rule_t;
+
+/**
+ * @struct executor_fusion_pair_s
+ * @brief Structure that reports how often a pair of instructions occurs.
+ */
+typedef struct executor_fusion_pair_s {
+    executor_fusion_pattern_t pattern;   ///< The pair of instructions.
+    size_t number_of_occurrences;        ///< Number of times the pair occurs.
+} executor_fusion_pair_t;
+
+/**
+ * @struct executor_fusion_s
+ * @brief Structure that holds a table of fusion rules.
+ */
+typedef struct executor_fusion_s {
+    executor_fusion_rule_t rules[MAX_NUMBER_OF_FUSION_RULES];  ///< The rules, in insertion order.
+    size_t number_of_rules;                                    ///< Number of rules.
+    uint8_t first_filter[MAX_NUMBER_OF_CONTROLLERS * MAX_NUMBER_OF_CONTROLLER_OPERATIONS / 8];
+                                                               ///< Bit set of the first instructions of the rules.
+} executor_fusion_t;
+
+/**
+ * @brief Initializes an empty fusion table.
+ *
+ * @param[out] fusion Pointer to the fusion table to initialize.
+ */
+void executor_fusion_init(executor_fusion_t *fusion);
+
+/**
+ * @brief Adds a rule to a fusion table.
+ *
+ * @param[in,out] fusion Pointer to the fusion table.
+ * @param[in] rule The rule to add, which is copied.
+ * @return executor_fusion_error_t Error code resulting from the operation.
+ */
+executor_fusion_error_t executor_fusion_add(executor_fusion_t *fusion, const executor_fusion_rule_t *rule);
+
+/**
+ * @brief Fuses every pair of adjacent entries of an image matching a rule.
+ *
+ * Must be applied again after the image is linked, which undoes fusion. Pairs whose
+ * fused operation cannot be bound by executor_image_bind() are left unfused.
+ *
+ * @param[in] fusion Pointer to the fusion table.
+ * @param[in,out] image Pointer to the linked image.
+ * @return The number of fused entries.
+ */
+size_t executor_fusion_apply(const executor_fusion_t *fusion, executor_image_t *image);
+
+/**
+ * @brief Finds the most frequent pairs of adjacent instructions of an image.
+ *
+ * @param[in] image Pointer to the image.
+ * @param[out] pairs The pairs found, most frequent first.
+ * @param[in] max_number_of_pairs Capacity of `pairs`.
+ * @return The number of pairs stored, or SIZE_MAX if the memory for counting could not be allocated.
+ */
+size_t executor_fusion_hot_pairs(const executor_image_t *image,
+                                 executor_fusion_pair_t *pairs,
+                                 size_t max_number_of_pairs);
+
+/**
+ * @brief Returns the header of the second instruction of a fused pair.
+ *
+ * @param[in] header The header of the first instruction, as received by the fused operation.
+ * @return The header of the instruction following it in the packed program.
+ */
+ZDC_STATIC_INLINE const instruction_header_t *executor_fusion_second(const instruction_header_t *header) {
+    return (const instruction_header_t *) ((const uint8_t *) header + instruction_packed_size(header));
+}
+
+/**
+ * @brief Returns the operands of the instruction with the given header in the packed program.
+ *
+ * @param[in] header The header of the instruction.
+ * @return The operands following the header.
+ */
+ZDC_STATIC_INLINE const instruction_operand_t *executor_fusion_operands(const instruction_header_t *header) {
+    return (const instruction_operand_t *) (header + 1);
+}
+
+#endif // ZODIAC_EXECUTOR_FUSION_H
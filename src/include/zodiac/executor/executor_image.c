@@ -0,0 +1,166 @@
+#include "executor_image.h"
+
+#include <string.h>
+
+void executor_image_init(executor_image_t *image) {
+    instruction_program_init(&image->program);
+    image->entries = nullptr;
+    image->number_of_entries = 0;
+    instruction_index_init(&image->index);
+    image->bindings = nullptr;
+    image->number_of_bindings = 0;
+    image->number_of_linked_bindings = 0;
+    image->bindings_capacity = 0;
+    image->registry = nullptr;
+}
+
+void executor_image_set_allocator(executor_image_t *image, const platform_allocator_t *allocator) {
+    instruction_program_set_allocator(&image->program, allocator);
+}
+
+void executor_image_free(executor_image_t *image) {
+    platform_memory_release(image->program.allocator, image->entries);
+    platform_memory_release(image->program.allocator, image->bindings);
+    instruction_index_free(&image->index);
+    instruction_program_free(&image->program);
+    image->entries = nullptr;
+    image->number_of_entries = 0;
+    image->bindings = nullptr;
+    image->number_of_bindings = 0;
+    image->number_of_linked_bindings = 0;
+    image->bindings_capacity = 0;
+}
+
+executor_image_error_t executor_image_load(executor_image_t *image,
+                                           const controller_registry_t *registry,
+                                           instruction_reader_t *reader) {
+
+    switch (instruction_program_load(&image->program, reader)) {
+        case INSTRUCTION_PROGRAM_ERROR_OK:
+            break;
+        case INSTRUCTION_PROGRAM_ERROR_READ:
+            return EXECUTOR_IMAGE_ERROR_READ;
+        default:
+            return EXECUTOR_IMAGE_ERROR_MEMORY;
+    }
+
+    return executor_image_build(image, registry);
+}
+
+executor_image_error_t executor_image_build(executor_image_t *image, const controller_registry_t *registry) {
+    const instruction_program_t *program = &image->program;
+
+    if (program->size > UINT32_MAX) {
+        return EXECUTOR_IMAGE_ERROR_SIZE;
+    }
+
+    // One spare entry keeps the allocation non-empty for empty programs.
+    image->entries = platform_memory_allocate(program->allocator,
+                                              (program->number_of_instructions + 1) * sizeof(executor_image_entry_t));
+    if (image->entries == nullptr) {
+        return EXECUTOR_IMAGE_ERROR_MEMORY;
+    }
+
+    image->number_of_entries = program->number_of_instructions;
+
+    if (instruction_index_reserve(&image->index, program->size, program->allocator) != INSTRUCTION_INDEX_ERROR_OK) {
+        return EXECUTOR_IMAGE_ERROR_MEMORY;
+    }
+
+    for (size_t index = 0; index < image->number_of_entries; ++index) {
+        instruction_reader_offset_t offset = instruction_program_offset(program, index);
+
+        image->entries[index].offset = (uint32_t) offset;
+        instruction_index_mark(&image->index, (size_t) offset);
+    }
+
+    if (instruction_index_complete(&image->index) != INSTRUCTION_INDEX_ERROR_OK) {
+        return EXECUTOR_IMAGE_ERROR_MEMORY;
+    }
+
+    return executor_image_link(image, registry);
+}
+
+executor_image_error_t executor_image_link(executor_image_t *image, const controller_registry_t *registry) {
+    // Binding of every (controller, operation) pair met so far, UINT32_MAX for the others.
+    uint32_t *bindings = platform_memory_allocate(nullptr, MAX_NUMBER_OF_IMAGE_BINDINGS * sizeof(uint32_t));
+    executor_image_error_t error = EXECUTOR_IMAGE_ERROR_OK;
+
+    if (bindings == nullptr) {
+        return EXECUTOR_IMAGE_ERROR_MEMORY;
+    }
+
+    memset(bindings, 0xFF, MAX_NUMBER_OF_IMAGE_BINDINGS * sizeof(uint32_t));
+    image->registry = registry;
+    image->number_of_bindings = 0;
+
+    for (size_t index = 0; index < image->number_of_entries; ++index) {
+        executor_image_entry_t *entry = &image->entries[index];
+        const instruction_header_t *header = executor_image_header(image, entry);
+        size_t key = (size_t) header->controller_index * MAX_NUMBER_OF_CONTROLLER_OPERATIONS + header->operation_index;
+
+        if (bindings[key] == UINT32_MAX) {
+            controller_operation_callback_t operation = controller_registry_lookup(registry, header);
+            size_t binding = operation != nullptr
+                             ? executor_image_bind(image, operation, registry->controllers[header->controller_index].sender)
+                             : executor_image_bind(image, executor_image_unknown_operation, nullptr);
+
+            if (binding == SIZE_MAX) {
+                error = EXECUTOR_IMAGE_ERROR_MEMORY;
+                break;
+            }
+
+            bindings[key] = (uint32_t) binding;
+        }
+
+        entry->binding = (uint16_t) bindings[key];
+        entry->length = 1;
+    }
+
+    image->number_of_linked_bindings = image->number_of_bindings;
+    platform_memory_release(nullptr, bindings);
+    return error;
+}
+
+size_t executor_image_bind(executor_image_t *image, controller_operation_callback_t operation, callback_sender sender) {
+    executor_image_binding_t *binding;
+
+    for (size_t index = image->number_of_linked_bindings; index < image->number_of_bindings; ++index) {
+        binding = &image->bindings[index];
+        if (binding->operation == operation && binding->sender == sender) {
+            return index;
+        }
+    }
+
+    if (image->number_of_bindings >= MAX_NUMBER_OF_IMAGE_BINDINGS) {
+        return SIZE_MAX;
+    }
+
+    if (image->number_of_bindings == image->bindings_capacity) {
+        size_t capacity = image->bindings_capacity != 0 ? image->bindings_capacity * 2 : 64;
+        executor_image_binding_t *bindings = platform_memory_reallocate(image->program.allocator, image->bindings,
+                                                                        capacity * sizeof(executor_image_binding_t));
+        if (bindings == nullptr) {
+            return SIZE_MAX;
+        }
+
+        image->bindings = bindings;
+        image->bindings_capacity = capacity;
+    }
+
+    binding = &image->bindings[image->number_of_bindings];
+    binding->operation = operation;
+    binding->sender = sender;
+    return image->number_of_bindings++;
+}
+
+controller_operation_result_t executor_image_unknown_operation(callback_sender sender,
+                                                               struct executor_s *executor,
+                                                               const instruction_header_t *header,
+                                                               const instruction_operand_t *operands) {
+    (void) sender;
+    (void) executor;
+    (void) header;
+    (void) operands;
+    return CONTROLLER_OPERATION_RESULT_ERROR;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file executor_image.h
+ * @brief Defines the pre-decoded, direct-threaded image of a program.
+ *
+ * Loading an image reads the whole instruction stream once, keeps it in the packed
+ * program format and builds one 8-byte entry per instruction holding the offset of the
+ * instruction within the program, its binding and the number of instructions it
+ * executes. Bindings pair a resolved operation with the sender it receives; the image
+ * holds one per distinct operation it dispatches to, so they stay in cache while the
+ * entries are streamed. Running an image therefore neither parses headers nor looks
+ * operations up in the controller registry.
+ *
+ * Control flow still works in offsets: seeking an executor running an image resolves
+ * the target offset to the entry starting there in constant time through the index of
+ * the instruction boundaries built with the entries, see executor_image_resolve().
+ * Like in every other mode, an offset within an instruction is decoded from there on:
+ * such instructions are decoded from the program and dispatched through the registry
+ * until the execution reaches the start of an entry again.
+ */
+
+#ifndef ZODIAC_EXECUTOR_IMAGE_H
+#define ZODIAC_EXECUTOR_IMAGE_H
+
+#include "../controller/controller_registry.h"     // Source of the resolved operations.
+#include "../instruction/instruction_packed.h"     // Layout of the packed instructions.
+#include "../instruction/instruction_index.h"      // Boundaries of the instructions.
+#include "../instruction/instruction_program.h"    // Packed storage of the instructions.
+
+/**
+ * @enum executor_image_error_e
+ * @brief Enumerates possible errors that can occur when loading an image.
+ */
+typedef enum executor_image_error_e {
+    EXECUTOR_IMAGE_ERROR_OK,       ///< No error occurred, the image is ready to run.
+    EXECUTOR_IMAGE_ERROR_READ,     ///< The reader failed before reaching the end of the stream.
+    EXECUTOR_IMAGE_ERROR_MEMORY,   ///< The memory for the image could not be allocated.
+    EXECUTOR_IMAGE_ERROR_SIZE      ///< The program is larger than the 4 GiB addressed by the entries.
+} executor_image_error_t;
+
+/**
+ * @brief Max number of bindings of an image, enough for every (controller, operation) pair.
+ */
+#define MAX_NUMBER_OF_IMAGE_BINDINGS (MAX_NUMBER_OF_CONTROLLERS * MAX_NUMBER_OF_CONTROLLER_OPERATIONS)
+
+/**
+ * @struct executor_image_binding_s
+ * @brief Structure that holds an operation dispatched to by the entries of an image.
+ */
+typedef struct executor_image_binding_s {
+    controller_operation_callback_t operation;   ///< The resolved operation.
+    callback_sender sender;                      ///< The sender passed to the operation.
+} executor_image_binding_t;
+
+/**
+ * @struct executor_image_entry_s
+ * @brief Structure that holds a pre-decoded instruction.
+ */
+typedef struct executor_image_entry_s {
+    uint32_t offset;     ///< Offset of the instruction within the program.
+    uint16_t binding;    ///< Index of the binding of the operation within the image.
+    uint16_t length;     ///< Number of instructions executed by the operation, 2 when fused.
+} executor_image_entry_t;
+
+/**
+ * @struct executor_image_s
+ * @brief Structure that holds a program and its pre-decoded entries.
+ */
+typedef struct executor_image_s {
+    instruction_program_t program;          ///< The packed instructions, owned by the image.
+    executor_image_entry_t *entries;        ///< One entry per instruction, in program order.
+    size_t number_of_entries;               ///< Number of entries, equal to the number of instructions.
+    instruction_index_t index;              ///< Boundaries of the instructions, resolving offsets to entries.
+    executor_image_binding_t *bindings;     ///< Operations dispatched to by the entries.
+    size_t number_of_bindings;              ///< Number of bindings.
+    size_t number_of_linked_bindings;       ///< Number of bindings made when linking, those of fused operations follow.
+    size_t bindings_capacity;               ///< Number of bindings that fit the allocation.
+    const controller_registry_t *registry;  ///< The registry the image is linked against.
+} executor_image_t;
+
+/**
+ * @brief Initializes an empty image.
+ *
+ * @param[out] image Pointer to the image to initialize.
+ */
+void executor_image_init(executor_image_t *image);
+
+/**
+ * @brief Sets the allocator providing the memory of an empty image and its program.
+ *
+ * Placing the image in the arena of a VM instance lets the instance be torn down by
+ * resetting the arena.
+ *
+ * @param[in,out] image Pointer to the image, which must not be loaded yet.
+ * @param[in] allocator The allocator, or nullptr for the default allocator.
+ */
+void executor_image_set_allocator(executor_image_t *image, const platform_allocator_t *allocator);
+
+/**
+ * @brief Releases the memory held by an image and leaves it empty.
+ *
+ * The allocator of the image is kept.
+ *
+ * @param[in,out] image Pointer to the image to release.
+ */
+void executor_image_free(executor_image_t *image);
+
+/**
+ * @brief Loads an image from the current position of a reader until the end of the stream.
+ *
+ * The stream is read once, then the entries are built and linked against the registry.
+ *
+ * @param[in,out] image Pointer to an initialized, empty image.
+ * @param[in] registry The controller registry resolving the operations.
+ * @param[in,out] reader The reader from which instructions are loaded.
+ * @return executor_image_error_t Error code resulting from the operation.
+ */
+executor_image_error_t executor_image_load(executor_image_t *image,
+                                           const controller_registry_t *registry,
+                                           instruction_reader_t *reader);
+
+/**
+ * @brief Builds and links the entries and the index of an image whose program is already filled.
+ *
+ * Used by sources that provide the packed program themselves instead of a reader,
+ * such as a restored snapshot, see executor_snapshot_open().
+ *
+ * @param[in,out] image Pointer to an image holding a program and no entries.
+ * @param[in] registry The controller registry resolving the operations.
+ * @return executor_image_error_t Error code resulting from the operation.
+ */
+executor_image_error_t executor_image_build(executor_image_t *image, const controller_registry_t *registry);
+
+/**
+ * @brief Resolves the operations of every entry again.
+ *
+ * Needed after controllers are registered or unregistered. Undoes superinstruction
+ * fusion, see executor_fusion_apply(). Instructions addressing an
+ * unknown controller or operation are bound to executor_image_unknown_operation().
+ *
+ * @param[in,out] image Pointer to the image.
+ * @param[in] registry The controller registry resolving the operations, which must outlive the image.
+ * @return executor_image_error_t Error code resulting from the operation.
+ */
+executor_image_error_t executor_image_link(executor_image_t *image, const controller_registry_t *registry);
+
+/**
+ * @brief Returns the binding of an operation and its sender, adding it to the image if needed.
+ *
+ * Only bindings added since the image was linked are shared, see executor_fusion_apply().
+ *
+ * @param[in,out] image Pointer to the linked image.
+ * @param[in] operation The operation.
+ * @param[in] sender The sender passed to the operation.
+ * @return The index of the binding, or SIZE_MAX if the bindings are full or could not be grown.
+ */
+size_t executor_image_bind(executor_image_t *image, controller_operation_callback_t operation, callback_sender sender);
+
+/**
+ * @brief Operation bound to the instructions that could not be resolved.
+ *
+ * Makes the executor stop with EXECUTOR_STATUS_UNKNOWN_OPERATION when reached, so
+ * unresolved instructions cost nothing unless they are executed.
+ */
+controller_operation_result_t executor_image_unknown_operation(callback_sender sender,
+                                                               struct executor_s *executor,
+                                                               const instruction_header_t *header,
+                                                               const instruction_operand_t *operands);
+
+/**
+ * @brief Returns the header of the instruction of an entry.
+ *
+ * @param[in] image Pointer to the image.
+ * @param[in] entry An entry of the image.
+ * @return The header within the program; the operands follow it.
+ */
+ZDC_STATIC ZDC_FORCE_INLINE const instruction_header_t *executor_image_header(const executor_image_t *image,
+                                                                               const executor_image_entry_t *entry) {
+
+    return (const instruction_header_t *) (image->program.code + entry->offset);
+}
+
+/**
+ * @brief Returns the position of an executor running an image at an offset.
+ *
+ * Positions below `number_of_entries` are the index of the entry starting at the offset,
+ * answered in constant time by the index of the image, see instruction_index_rank().
+ * `number_of_entries` is the end of the program, and positions beyond it hold an offset
+ * within an instruction, whose bytes are decoded as an instruction of their own.
+ *
+ * @param[in] image Pointer to the image.
+ * @param[in] offset Offset within the program, up to its size.
+ * @return The position of the executor.
+ */
+ZDC_STATIC_INLINE size_t executor_image_resolve(const executor_image_t *image, instruction_reader_offset_t offset) {
+    if ((size_t) offset < image->program.size && !instruction_index_is_boundary(&image->index, offset)) {
+        return image->number_of_entries + 1 + (size_t) offset;
+    }
+
+    return instruction_index_rank(&image->index, offset);
+}
+
+/**
+ * @brief Returns the offset of a position of an executor running an image.
+ *
+ * @param[in] image Pointer to the image.
+ * @param[in] position A position returned by executor_image_resolve(), or an entry index.
+ * @return The offset of the instruction, or the size of the program past the last instruction.
+ */
+ZDC_STATIC_INLINE instruction_reader_offset_t executor_image_offset(const executor_image_t *image, size_t position) {
+    if (position < image->number_of_entries) {
+        return (instruction_reader_offset_t) image->entries[position].offset;
+    }
+
+    return position == image->number_of_entries
+           ? (instruction_reader_offset_t) image->program.size
+           : (instruction_reader_offset_t) (position - image->number_of_entries - 1);
+}
+
+#endif // ZODIAC_EXECUTOR_IMAGE_H
@@ -0,0 +1,266 @@
+#include "executor_snapshot.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// Marker stored in the byte order of the host that saved a snapshot.
+#define EXECUTOR_SNAPSHOT_BYTE_ORDER UINT32_C(0x01020304)
+
+/**
+ * @struct executor_snapshot_record_s
+ * @brief Represents an entry of the table of state sections as stored in the file.
+ */
+typedef struct executor_snapshot_record_s {
+    uint64_t identifier;   /*!< The identifier of the section */
+    uint64_t offset;       /*!< Offset of the state bytes */
+    uint64_t size;         /*!< Number of state bytes */
+} executor_snapshot_record_t;
+
+/**
+ * @brief Rounds an offset up to the alignment of the regions.
+ */
+static uint64_t executor_snapshot_align(uint64_t offset) {
+    return (offset + EXECUTOR_SNAPSHOT_ALIGNMENT - 1) & ~(uint64_t) (EXECUTOR_SNAPSHOT_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Writes a region at its offset, padding the file up to it with zeros.
+ */
+static bool executor_snapshot_write(FILE *stream, uint64_t *written, uint64_t offset, const void *data, size_t size) {
+    static const uint8_t padding[EXECUTOR_SNAPSHOT_ALIGNMENT];
+
+    if (*written < offset && fwrite(padding, 1, (size_t) (offset - *written), stream) != offset - *written) {
+        return false;
+    }
+
+    *written = offset + size;
+    return size == 0 || fwrite(data, 1, size, stream) == size;
+}
+
+/**
+ * @brief Returns whether a region of the given size at the given offset lies within the mapping.
+ */
+static bool executor_snapshot_contains(const executor_snapshot_t *snapshot, uint64_t offset, uint64_t size) {
+    return offset <= snapshot->mapping_size && size <= snapshot->mapping_size - offset;
+}
+
+/**
+ * @brief Checks the header, the regions and the offsets index of a mapped snapshot.
+ */
+static bool executor_snapshot_check(const executor_snapshot_t *snapshot) {
+    const executor_snapshot_header_t *header = snapshot->header;
+    const uint8_t *code;
+    const instruction_reader_offset_t *offsets;
+    const executor_snapshot_record_t *records;
+    uint64_t expected = 0;
+
+    if (memcmp(header->magic, EXECUTOR_SNAPSHOT_MAGIC, EXECUTOR_SNAPSHOT_MAGIC_SIZE) != 0
+        || header->byte_order != EXECUTOR_SNAPSHOT_BYTE_ORDER
+        || header->offset_size != sizeof(instruction_reader_offset_t)
+        || header->offsets_offset % EXECUTOR_SNAPSHOT_ALIGNMENT != 0
+        || header->sections_offset % EXECUTOR_SNAPSHOT_ALIGNMENT != 0
+        || !executor_snapshot_contains(snapshot, header->code_offset, header->code_size)
+        || header->number_of_instructions > header->code_size
+        || !executor_snapshot_contains(snapshot, header->offsets_offset,
+                                       header->number_of_instructions * sizeof(instruction_reader_offset_t))
+        || header->number_of_sections > snapshot->mapping_size
+        || !executor_snapshot_contains(snapshot, header->sections_offset,
+                                       header->number_of_sections * sizeof(executor_snapshot_record_t))
+        || header->position < 0
+        || (uint64_t) header->position > header->code_size) {
+        return false;
+    }
+
+    code = (const uint8_t *) snapshot->mapping + header->code_offset;
+    offsets = (const instruction_reader_offset_t *) ((const uint8_t *) snapshot->mapping + header->offsets_offset);
+    records = (const executor_snapshot_record_t *) ((const uint8_t *) snapshot->mapping + header->sections_offset);
+
+    // Every instruction must start where the previous one ends and fit in the program.
+    for (uint64_t index = 0; index < header->number_of_instructions; ++index) {
+        if ((uint64_t) offsets[index] != expected
+            || header->code_size - expected < sizeof(instruction_header_t)) {
+            return false;
+        }
+
+        expected += instruction_packed_size((const instruction_header_t *) (code + expected));
+        if (expected > header->code_size) {
+            return false;
+        }
+    }
+
+    if (expected != header->code_size) {
+        return false;
+    }
+
+    for (uint64_t index = 0; index < header->number_of_sections; ++index) {
+        if (!executor_snapshot_contains(snapshot, records[index].offset, records[index].size)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+executor_snapshot_error_t executor_snapshot_save(const char *path,
+                                                 const instruction_program_t *program,
+                                                 executor_t *executor,
+                                                 const executor_snapshot_section_t *sections,
+                                                 size_t number_of_sections) {
+
+    executor_snapshot_header_t header;
+    executor_snapshot_record_t record;
+    uint64_t written = 0;
+    uint64_t offset;
+    bool succeeded;
+    FILE *stream;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, EXECUTOR_SNAPSHOT_MAGIC, EXECUTOR_SNAPSHOT_MAGIC_SIZE);
+    header.byte_order = EXECUTOR_SNAPSHOT_BYTE_ORDER;
+    header.offset_size = sizeof(instruction_reader_offset_t);
+    header.code_offset = executor_snapshot_align(sizeof(header));
+    header.code_size = program->size;
+    header.offsets_offset = executor_snapshot_align(header.code_offset + header.code_size);
+    header.number_of_instructions = program->number_of_instructions;
+    header.position = executor_tell(executor);
+    header.number_of_executed_instructions = executor->number_of_executed_instructions;
+    header.sections_offset = executor_snapshot_align(header.offsets_offset
+                                                     + header.number_of_instructions
+                                                       * sizeof(instruction_reader_offset_t));
+    header.number_of_sections = number_of_sections;
+
+    stream = fopen(path, "wb");
+    if (stream == nullptr) {
+        return EXECUTOR_SNAPSHOT_ERROR_OPEN;
+    }
+
+    succeeded = executor_snapshot_write(stream, &written, 0, &header, sizeof(header))
+                && executor_snapshot_write(stream, &written, header.code_offset, program->code, program->size)
+                && executor_snapshot_write(stream, &written, header.offsets_offset, program->offsets,
+                                           program->number_of_instructions * sizeof(instruction_reader_offset_t));
+
+    // State bytes follow the table of sections, each at an aligned offset.
+    offset = executor_snapshot_align(header.sections_offset + number_of_sections * sizeof(record));
+
+    for (size_t index = 0; succeeded && index < number_of_sections; ++index) {
+        record.identifier = sections[index].identifier;
+        record.offset = offset;
+        record.size = sections[index].size;
+        offset = executor_snapshot_align(offset + record.size);
+
+        succeeded = executor_snapshot_write(stream, &written, header.sections_offset + index * sizeof(record),
+                                            &record, sizeof(record));
+    }
+
+    offset = executor_snapshot_align(header.sections_offset + number_of_sections * sizeof(record));
+
+    for (size_t index = 0; succeeded && index < number_of_sections; ++index) {
+        succeeded = executor_snapshot_write(stream, &written, offset, sections[index].data, sections[index].size);
+        offset = executor_snapshot_align(offset + sections[index].size);
+    }
+
+    if (fclose(stream) != 0 || !succeeded) {
+        return EXECUTOR_SNAPSHOT_ERROR_WRITE;
+    }
+
+    return EXECUTOR_SNAPSHOT_ERROR_OK;
+}
+
+executor_snapshot_error_t executor_snapshot_open(executor_snapshot_t *snapshot,
+                                                 const char *path,
+                                                 const controller_registry_t *registry) {
+
+    const executor_snapshot_header_t *header;
+    instruction_program_t *program = &snapshot->image.program;
+    struct stat status;
+    void *mapping;
+    int fd;
+
+    snapshot->mapping = nullptr;
+    snapshot->mapping_size = 0;
+    snapshot->header = nullptr;
+    executor_image_init(&snapshot->image);
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return EXECUTOR_SNAPSHOT_ERROR_OPEN;
+    }
+
+    if (fstat(fd, &status) != 0 || (uint64_t) status.st_size < sizeof(executor_snapshot_header_t)) {
+        close(fd);
+        return EXECUTOR_SNAPSHOT_ERROR_FORMAT;
+    }
+
+    mapping = mmap(nullptr, (size_t) status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+        return EXECUTOR_SNAPSHOT_ERROR_MAP;
+    }
+
+    snapshot->mapping = mapping;
+    snapshot->mapping_size = (size_t) status.st_size;
+    snapshot->header = header = mapping;
+
+    if (!executor_snapshot_check(snapshot)) {
+        executor_snapshot_close(snapshot);
+        return EXECUTOR_SNAPSHOT_ERROR_FORMAT;
+    }
+
+    // The program is used in place and never grown, so it owns no capacity.
+    program->code = (uint8_t *) mapping + header->code_offset;
+    program->size = (size_t) header->code_size;
+    program->offsets = (instruction_reader_offset_t *) ((uint8_t *) mapping + header->offsets_offset);
+    program->number_of_instructions = (size_t) header->number_of_instructions;
+
+    if (executor_image_build(&snapshot->image, registry) != EXECUTOR_IMAGE_ERROR_OK) {
+        executor_snapshot_close(snapshot);
+        return EXECUTOR_SNAPSHOT_ERROR_MEMORY;
+    }
+
+    return EXECUTOR_SNAPSHOT_ERROR_OK;
+}
+
+void executor_snapshot_close(executor_snapshot_t *snapshot) {
+    platform_memory_release(snapshot->image.program.allocator, snapshot->image.entries);
+    platform_memory_release(snapshot->image.program.allocator, snapshot->image.bindings);
+    instruction_index_free(&snapshot->image.index);
+    executor_image_init(&snapshot->image);
+
+    if (snapshot->mapping != nullptr) {
+        munmap(snapshot->mapping, snapshot->mapping_size);
+    }
+
+    snapshot->mapping = nullptr;
+    snapshot->mapping_size = 0;
+    snapshot->header = nullptr;
+}
+
+void executor_snapshot_restore(const executor_snapshot_t *snapshot, executor_t *executor) {
+    executor_init_image(executor, &snapshot->image);
+    executor_seek(executor, (instruction_reader_offset_t) snapshot->header->position, INSTRUCTION_READER_SEEK_SET);
+    executor->number_of_executed_instructions = snapshot->header->number_of_executed_instructions;
+}
+
+bool executor_snapshot_section(const executor_snapshot_t *snapshot,
+                               uint64_t identifier,
+                               executor_snapshot_section_t *section) {
+
+    const executor_snapshot_header_t *header = snapshot->header;
+    const executor_snapshot_record_t *records =
+            (const executor_snapshot_record_t *) ((const uint8_t *) snapshot->mapping + header->sections_offset);
+
+    for (uint64_t index = 0; index < header->number_of_sections; ++index) {
+        if (records[index].identifier == identifier) {
+            section->identifier = identifier;
+            section->data = (const uint8_t *) snapshot->mapping + records[index].offset;
+            section->size = (size_t) records[index].size;
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file executor_snapshot.h
+ * @brief Defines snapshots of a decoded program and the state of an executor.
+ *
+ * A snapshot file holds a packed program with its offsets index, the position and the
+ * instruction counter of an executor, and opaque state sections saved on behalf of the
+ * controllers. Every region is stored at a 64-byte aligned offset in the native layout
+ * of the host and refers to other regions by offset only, so the file is relocatable:
+ * opening it maps it read-only and uses the program in place. The only fix-ups are the
+ * entries of the pre-decoded image, which hold pointers and are rebuilt from the offsets
+ * index and linked against the registry of the running process.
+ *
+ * Snapshots are not portable between hosts with a different byte order or offset width;
+ * opening such a snapshot fails with EXECUTOR_SNAPSHOT_ERROR_FORMAT.
+ */
+
+#ifndef ZODIAC_EXECUTOR_SNAPSHOT_H
+#define ZODIAC_EXECUTOR_SNAPSHOT_H
+
+#include "executor.h"  // Executor whose state is saved and restored.
+
+/**
+ * @brief Magic bytes a snapshot starts with.
+ */
+#define EXECUTOR_SNAPSHOT_MAGIC "ZDCSNAP1"
+
+/**
+ * @brief Number of magic bytes a snapshot starts with.
+ */
+#define EXECUTOR_SNAPSHOT_MAGIC_SIZE 8
+
+/**
+ * @brief Alignment of the regions of a snapshot in bytes.
+ */
+#define EXECUTOR_SNAPSHOT_ALIGNMENT 64
+
+/**
+ * @enum executor_snapshot_error_e
+ * @brief Enumerates possible errors that can occur when saving or opening a snapshot.
+ */
+typedef enum executor_snapshot_error_e {
+    EXECUTOR_SNAPSHOT_ERROR_OK,       ///< No error occurred.
+    EXECUTOR_SNAPSHOT_ERROR_OPEN,     ///< The file could not be opened or created.
+    EXECUTOR_SNAPSHOT_ERROR_WRITE,    ///< The file could not be written.
+    EXECUTOR_SNAPSHOT_ERROR_FORMAT,   ///< The file is not a snapshot of this host or is corrupt.
+    EXECUTOR_SNAPSHOT_ERROR_MAP,      ///< The file could not be mapped into memory.
+    EXECUTOR_SNAPSHOT_ERROR_MEMORY    ///< The entries of the image could not be allocated.
+} executor_snapshot_error_t;
+
+/**
+ * @struct executor_snapshot_header_s
+ * @brief Structure stored at the start of a snapshot file.
+ */
+typedef struct executor_snapshot_header_s {
+    char magic[EXECUTOR_SNAPSHOT_MAGIC_SIZE];   ///< EXECUTOR_SNAPSHOT_MAGIC.
+    uint32_t byte_order;                        ///< 0x01020304 in the byte order of the host.
+    uint32_t offset_size;                       ///< Size of instruction_reader_offset_t on the host.
+    uint64_t code_offset;                       ///< Offset of the packed program.
+    uint64_t code_size;                         ///< Size of the packed program.
+    uint64_t offsets_offset;                    ///< Offset of the offsets index of the program.
+    uint64_t number_of_instructions;            ///< Number of instructions of the program.
+    int64_t position;                           ///< Offset of the next instruction to execute.
+    uint64_t number_of_executed_instructions;   ///< Instruction counter of the executor.
+    uint64_t sections_offset;                   ///< Offset of the table of state sections.
+    uint64_t number_of_sections;                ///< Number of state sections.
+} executor_snapshot_header_t;
+
+/**
+ * @struct executor_snapshot_section_s
+ * @brief Structure that describes an opaque state section.
+ *
+ * When saving, `data` points to the bytes to store; in an opened snapshot, it points
+ * into the mapping.
+ */
+typedef struct executor_snapshot_section_s {
+    uint64_t identifier;   ///< Identifier chosen by the owner of the state, e.g. a controller index.
+    const void *data;      ///< The state bytes.
+    size_t size;           ///< Number of state bytes.
+} executor_snapshot_section_t;
+
+/**
+ * @struct executor_snapshot_s
+ * @brief Structure that holds an opened snapshot.
+ *
+ * The program of the image lives in the mapping; the image belongs to the snapshot and is
+ * released by executor_snapshot_close(), never by executor_image_free().
+ */
+typedef struct executor_snapshot_s {
+    void *mapping;                                   ///< The mapped file.
+    size_t mapping_size;                             ///< Size of the mapped file.
+    const executor_snapshot_header_t *header;        ///< The header, at the start of the mapping.
+    executor_image_t image;                          ///< The program, pre-decoded and linked.
+} executor_snapshot_t;
+
+/**
+ * @brief Saves a program, the state of an executor running it and state sections.
+ *
+ * The position saved is executor_tell(), so the executor may run the program in any mode.
+ *
+ * @param[in] path Path of the snapshot file to create or replace.
+ * @param[in] program The decoded program run by the executor.
+ * @param[in] executor The executor whose position and instruction counter are saved.
+ * @param[in] sections The state sections to save, may be nullptr if there are none.
+ * @param[in] number_of_sections Number of state sections.
+ * @return executor_snapshot_error_t Error code resulting from the operation.
+ */
+executor_snapshot_error_t executor_snapshot_save(const char *path,
+                                                 const instruction_program_t *program,
+                                                 executor_t *executor,
+                                                 const executor_snapshot_section_t *sections,
+                                                 size_t number_of_sections);
+
+/**
+ * @brief Maps a snapshot and links its program against a registry.
+ *
+ * @param[out] snapshot Pointer to the snapshot to open.
+ * @param[in] path Path of the snapshot file.
+ * @param[in] registry The controller registry resolving the operations of the program.
+ * @return executor_snapshot_error_t Error code resulting from the operation.
+ */
+executor_snapshot_error_t executor_snapshot_open(executor_snapshot_t *snapshot,
+                                                 const char *path,
+                                                 const controller_registry_t *registry);
+
+/**
+ * @brief Releases the image and unmaps the snapshot.
+ *
+ * Executors restored from the snapshot and section data become invalid.
+ *
+ * @param[in,out] snapshot Pointer to the snapshot.
+ */
+void executor_snapshot_close(executor_snapshot_t *snapshot);
+
+/**
+ * @brief Initializes an executor running the image of a snapshot from the saved state.
+ *
+ * @param[in] snapshot Pointer to the opened snapshot.
+ * @param[out] executor Pointer to the executor to initialize.
+ */
+void executor_snapshot_restore(const executor_snapshot_t *snapshot, executor_t *executor);
+
+/**
+ * @brief Looks up a state section of a snapshot.
+ *
+ * @param[in] snapshot Pointer to the opened snapshot.
+ * @param[in] identifier The identifier the section was saved with.
+ * @param[out] section Receives the section, whose data points into the mapping.
+ * @return Whether the snapshot holds a section with the identifier.
+ */
+bool executor_snapshot_section(const executor_snapshot_t *snapshot,
+                               uint64_t identifier,
+                               executor_snapshot_section_t *section);
+
+#endif // ZODIAC_EXECUTOR_SNAPSHOT_H
@@ -0,0 +1,370 @@
+#include "executor_validator.h"
+#include "../instruction/instruction_index.h"
+#include "../platform/platform_cpu.h"
+#include "../platform/platform_memory.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+#ifdef ZODIAC_PLATFORM_X86
+#   include <immintrin.h>
+#endif
+
+#if defined(ZODIAC_PLATFORM_X86) && defined(ZODIAC_COMPILER_TARGET_ATTRIBUTE)
+/// Whether the x86 vector kernels are built.
+#   define EXECUTOR_VALIDATOR_X86_KERNELS
+#endif
+
+/// Number of instructions collected by the walk before their indices are checked.
+#define EXECUTOR_VALIDATOR_BATCH_SIZE 256
+
+/**
+ * @struct executor_validator_batch_s
+ * @brief Represents instructions collected by the walk, stored as separate index arrays.
+ */
+typedef struct executor_validator_batch_s {
+    uint8_t controller_indices[EXECUTOR_VALIDATOR_BATCH_SIZE];  ///< Controller indices of the instructions.
+    uint8_t operation_indices[EXECUTOR_VALIDATOR_BATCH_SIZE];   ///< Operation indices of the instructions.
+    size_t offsets[EXECUTOR_VALIDATOR_BATCH_SIZE];              ///< Offsets of the instructions.
+    size_t number_of_instructions;                              ///< Number of collected instructions.
+} executor_validator_batch_t;
+
+/**
+ * @brief Checks one instruction against the snapshot of the registry.
+ */
+static executor_validator_error_t executor_validator_check(const executor_validator_t *validator,
+                                                           uint8_t controller_index,
+                                                           uint8_t operation_index) {
+
+    size_t bit = (size_t) controller_index * MAX_NUMBER_OF_CONTROLLER_OPERATIONS + operation_index;
+
+    if (validator->operations[bit / 8] & (1u << (bit % 8))) {
+        return EXECUTOR_VALIDATOR_ERROR_OK;
+    }
+
+    return validator->controllers[controller_index]
+           ? EXECUTOR_VALIDATOR_ERROR_OPERATION
+           : EXECUTOR_VALIDATOR_ERROR_CONTROLLER;
+}
+
+/**
+ * @brief Returns whether a group of instructions addresses a single controller and only its
+ * leading registered operations. Each kernel checks as many instructions as a vector holds.
+ */
+typedef bool (*executor_validator_dense_check_t)(const executor_validator_t *validator,
+                                                 const uint8_t *controller_indices,
+                                                 const uint8_t *operation_indices);
+
+/**
+ * @struct executor_validator_kernel_s
+ * @brief Represents a dense check and the number of instructions it checks at once.
+ */
+typedef struct executor_validator_kernel_s {
+    executor_validator_dense_check_t check_dense;   /*!< The dense check */
+    size_t number_of_lanes;                         /*!< Number of instructions checked at once */
+} executor_validator_kernel_t;
+
+static bool executor_validator_check_dense_scalar(const executor_validator_t *validator,
+                                                  const uint8_t *controller_indices,
+                                                  const uint8_t *operation_indices) {
+
+    uint16_t limit = validator->dense_limits[controller_indices[0]];
+    bool valid = limit != 0;
+
+    for (size_t lane = 0; lane < 8; ++lane) {
+        valid &= controller_indices[lane] == controller_indices[0] && operation_indices[lane] < limit;
+    }
+
+    return valid;
+}
+
+#ifdef EXECUTOR_VALIDATOR_X86_KERNELS
+
+ZDC_TARGET("sse2")
+static bool executor_validator_check_dense_sse2(const executor_validator_t *validator,
+                                                const uint8_t *controller_indices,
+                                                const uint8_t *operation_indices) {
+
+    uint16_t limit = validator->dense_limits[controller_indices[0]];
+    __m128i controllers = _mm_loadu_si128((const __m128i *) controller_indices);
+    __m128i operations = _mm_loadu_si128((const __m128i *) operation_indices);
+    __m128i last = _mm_set1_epi8((char) (limit - 1));
+    __m128i uniform = _mm_cmpeq_epi8(controllers, _mm_set1_epi8((char) controller_indices[0]));
+    __m128i bounded = _mm_cmpeq_epi8(_mm_max_epu8(operations, last), last);
+
+    return limit != 0 && _mm_movemask_epi8(_mm_and_si128(uniform, bounded)) == 0xFFFF;
+}
+
+ZDC_TARGET("avx2")
+static bool executor_validator_check_dense_avx2(const executor_validator_t *validator,
+                                                const uint8_t *controller_indices,
+                                                const uint8_t *operation_indices) {
+
+    uint16_t limit = validator->dense_limits[controller_indices[0]];
+    __m256i controllers = _mm256_loadu_si256((const __m256i *) controller_indices);
+    __m256i operations = _mm256_loadu_si256((const __m256i *) operation_indices);
+    __m256i last = _mm256_set1_epi8((char) (limit - 1));
+    __m256i uniform = _mm256_cmpeq_epi8(controllers, _mm256_set1_epi8((char) controller_indices[0]));
+    __m256i bounded = _mm256_cmpeq_epi8(_mm256_max_epu8(operations, last), last);
+
+    return limit != 0 && _mm256_movemask_epi8(_mm256_and_si256(uniform, bounded)) == -1;
+}
+
+ZDC_TARGET("avx512f,avx512bw")
+static bool executor_validator_check_dense_avx512(const executor_validator_t *validator,
+                                                  const uint8_t *controller_indices,
+                                                  const uint8_t *operation_indices) {
+
+    uint16_t limit = validator->dense_limits[controller_indices[0]];
+    __m512i controllers = _mm512_loadu_si512(controller_indices);
+    __m512i operations = _mm512_loadu_si512(operation_indices);
+    __mmask64 uniform = _mm512_cmpeq_epi8_mask(controllers, _mm512_set1_epi8((char) controller_indices[0]));
+    __mmask64 bounded = _mm512_cmple_epu8_mask(operations, _mm512_set1_epi8((char) (limit - 1)));
+
+    return limit != 0 && (uniform & bounded) == UINT64_MAX;
+}
+
+#endif
+
+/// Kernels in order of preference.
+static const executor_validator_kernel_t executor_validator_kernels[] = {
+#ifdef EXECUTOR_VALIDATOR_X86_KERNELS
+        {executor_validator_check_dense_avx512, 64},
+        {executor_validator_check_dense_avx2,   32},
+        {executor_validator_check_dense_sse2,   16},
+#endif
+        {executor_validator_check_dense_scalar, 8}
+};
+
+/// Extensions the kernels of executor_validator_kernels need, in the same order.
+static const platform_cpu_features_t executor_validator_kernel_features[] = {
+#ifdef EXECUTOR_VALIDATOR_X86_KERNELS
+        PLATFORM_CPU_FEATURE_AVX512F | PLATFORM_CPU_FEATURE_AVX512BW,
+        PLATFORM_CPU_FEATURE_AVX2,
+        PLATFORM_CPU_FEATURE_SSE2,
+#endif
+        0
+};
+
+/// The selected kernel, nullptr until the first validation.
+static _Atomic(const executor_validator_kernel_t *) executor_validator_kernel;
+
+/**
+ * @brief Returns the best kernel the processor supports, selecting it on the first call.
+ */
+static const executor_validator_kernel_t *executor_validator_select_kernel(void) {
+    const executor_validator_kernel_t *kernel = atomic_load_explicit(&executor_validator_kernel,
+                                                                     memory_order_relaxed);
+    size_t index = 0;
+
+    if (kernel != nullptr) {
+        return kernel;
+    }
+
+    while (!platform_cpu_has(executor_validator_kernel_features[index])) {
+        ++index;
+    }
+
+    kernel = &executor_validator_kernels[index];
+    atomic_store_explicit(&executor_validator_kernel, kernel, memory_order_relaxed);
+    return kernel;
+}
+
+/**
+ * @brief Checks the indices of a batch and reports its first defective instruction.
+ *
+ * @return The index of the defective instruction in the batch, or the size of the batch.
+ */
+static size_t executor_validator_check_batch(const executor_validator_t *validator,
+                                             const executor_validator_batch_t *batch,
+                                             executor_validator_error_t *error) {
+
+    const executor_validator_kernel_t *kernel = executor_validator_select_kernel();
+    size_t index = 0;
+
+    while (index < batch->number_of_instructions) {
+        size_t end = index + kernel->number_of_lanes;
+
+        if (end <= batch->number_of_instructions
+            && kernel->check_dense(validator,
+                                   batch->controller_indices + index,
+                                   batch->operation_indices + index)) {
+            index = end;
+            continue;
+        }
+
+        if (end > batch->number_of_instructions) {
+            end = batch->number_of_instructions;
+        }
+
+        for (; index < end; ++index) {
+            *error = executor_validator_check(validator,
+                                              batch->controller_indices[index],
+                                              batch->operation_indices[index]);
+            if (*error != EXECUTOR_VALIDATOR_ERROR_OK) {
+                return index;
+            }
+        }
+    }
+
+    return index;
+}
+
+/**
+ * @brief Records the outcome of a validation.
+ */
+static executor_validator_error_t executor_validator_report(executor_validator_result_t *result,
+                                                            executor_validator_error_t error,
+                                                            size_t offset,
+                                                            size_t number_of_instructions) {
+
+    if (result != nullptr) {
+        result->error = error;
+        result->offset = offset;
+        result->number_of_instructions = number_of_instructions;
+    }
+
+    return error;
+}
+
+/**
+ * @brief Checks the jump targets of a program whose instruction boundaries are known.
+ */
+static executor_validator_error_t executor_validator_check_jumps(const executor_validator_t *validator,
+                                                                 const uint8_t *code,
+                                                                 size_t size,
+                                                                 const instruction_index_t *boundaries,
+                                                                 executor_validator_result_t *result) {
+
+    size_t number_of_instructions = 0;
+    size_t offset = 0;
+
+    while (offset < size) {
+        const instruction_header_t *header = (const instruction_header_t *) (code + offset);
+        const instruction_operand_t *operands = code + offset + sizeof(instruction_header_t);
+        instruction_reader_offset_t target;
+
+        if (validator->jump_callback(validator->jump_sender, header, operands, &target)
+            && (size_t) target != size && !instruction_index_is_boundary(boundaries, target)) {
+            return executor_validator_report(result, EXECUTOR_VALIDATOR_ERROR_JUMP, offset, number_of_instructions);
+        }
+
+        offset += sizeof(instruction_header_t) + header->number_of_operands;
+        ++number_of_instructions;
+    }
+
+    return executor_validator_report(result, EXECUTOR_VALIDATOR_ERROR_OK, size, number_of_instructions);
+}
+
+void executor_validator_init(executor_validator_t *validator, const controller_registry_t *registry) {
+    memset(validator->operations, 0, sizeof(validator->operations));
+    validator->jump_callback = nullptr;
+    validator->jump_sender = nullptr;
+
+    for (size_t controller_index = 0; controller_index < MAX_NUMBER_OF_CONTROLLERS; ++controller_index) {
+        const controller_t *controller = &registry->controllers[controller_index];
+        bool dense = true;
+
+        validator->controllers[controller_index] = controller->operations != nullptr;
+        validator->dense_limits[controller_index] = 0;
+
+        for (size_t operation_index = 0; operation_index < controller->number_of_operations; ++operation_index) {
+            size_t bit = controller_index * MAX_NUMBER_OF_CONTROLLER_OPERATIONS + operation_index;
+
+            if (controller->operations[operation_index] == nullptr) {
+                dense = false;
+                continue;
+            }
+
+            validator->operations[bit / 8] |= (uint8_t) (1u << (bit % 8));
+            if (dense) {
+                validator->dense_limits[controller_index] = (uint16_t) (operation_index + 1);
+            }
+        }
+    }
+}
+
+void executor_validator_set_jump_callback(executor_validator_t *validator,
+                                          executor_validator_jump_callback_t jump_callback,
+                                          callback_sender sender) {
+
+    validator->jump_callback = jump_callback;
+    validator->jump_sender = sender;
+}
+
+executor_validator_error_t executor_validator_validate(const executor_validator_t *validator,
+                                                       const uint8_t *code,
+                                                       size_t size,
+                                                       executor_validator_result_t *result) {
+
+    executor_validator_batch_t batch;
+    executor_validator_error_t error = EXECUTOR_VALIDATOR_ERROR_OK;
+    instruction_index_t boundaries;
+    size_t number_of_instructions = 0;
+    size_t offset = 0;
+
+    instruction_index_init(&boundaries);
+
+    if (validator->jump_callback != nullptr
+        && instruction_index_reserve(&boundaries, size, nullptr) != INSTRUCTION_INDEX_ERROR_OK) {
+        return executor_validator_report(result, EXECUTOR_VALIDATOR_ERROR_MEMORY, 0, 0);
+    }
+
+    while (error == EXECUTOR_VALIDATOR_ERROR_OK && offset < size) {
+        executor_validator_error_t batch_error = EXECUTOR_VALIDATOR_ERROR_OK;
+        size_t defective;
+
+        batch.number_of_instructions = 0;
+
+        while (offset < size && batch.number_of_instructions < EXECUTOR_VALIDATOR_BATCH_SIZE) {
+            const instruction_header_t *header = (const instruction_header_t *) (code + offset);
+            size_t remaining = size - offset;
+
+            if (remaining < sizeof(instruction_header_t)) {
+                error = EXECUTOR_VALIDATOR_ERROR_HEADER;
+                break;
+            }
+
+            if (remaining - sizeof(instruction_header_t) < header->number_of_operands) {
+                error = EXECUTOR_VALIDATOR_ERROR_OPERANDS;
+                break;
+            }
+
+            if (boundaries.boundaries != nullptr) {
+                instruction_index_mark(&boundaries, offset);
+            }
+
+            batch.controller_indices[batch.number_of_instructions] = header->controller_index;
+            batch.operation_indices[batch.number_of_instructions] = header->operation_index;
+            batch.offsets[batch.number_of_instructions] = offset;
+            ++batch.number_of_instructions;
+
+            offset += sizeof(instruction_header_t) + header->number_of_operands;
+        }
+
+        // Indices of the collected instructions precede a structural defect, so they are checked first.
+        defective = executor_validator_check_batch(validator, &batch, &batch_error);
+
+        if (defective < batch.number_of_instructions) {
+            error = batch_error;
+            offset = batch.offsets[defective];
+            number_of_instructions += defective;
+            break;
+        }
+
+        number_of_instructions += batch.number_of_instructions;
+    }
+
+    if (error != EXECUTOR_VALIDATOR_ERROR_OK) {
+        instruction_index_free(&boundaries);
+        return executor_validator_report(result, error, offset, number_of_instructions);
+    }
+
+    if (boundaries.boundaries != nullptr) {
+        error = executor_validator_check_jumps(validator, code, size, &boundaries, result);
+        instruction_index_free(&boundaries);
+        return error;
+    }
+
+    return executor_validator_report(result, EXECUTOR_VALIDATOR_ERROR_OK, size, number_of_instructions);
+}
@@ -0,0 +1,114 @@
+/**
+ * @file executor_validator.h
+ * @brief Defines the up-front validation of a whole packed program.
+ *
+ * The validator walks a packed program once before it is executed and reports the first
+ * malformed instruction with its exact offset: a truncated header, operands running past
+ * the end of the program, an unregistered controller, an unknown operation, or a jump
+ * landing between instructions. The executor keeps its own checks of these errors even
+ * for programs that pass: operations may seek to offsets no jump callback reports, and
+ * controllers may be unregistered after validation, so passing cannot guarantee the
+ * checks never fire, while they cost a well-predicted branch per instruction.
+ *
+ * Instruction boundaries are found by a sequential walk, while the controller and
+ * operation indices collected by the walk are checked in SIMD batches (AVX-512, AVX2 or
+ * SSE2, picked at run time, see platform_cpu.h, with a plain C fallback): a batch
+ * addressing one controller whose first operations are all registered passes with a
+ * single compare, any other batch is checked instruction by instruction.
+ *
+ * Jumps are operation-specific, so their targets are reported by an optional callback.
+ */
+
+#ifndef ZODIAC_EXECUTOR_VALIDATOR_H
+#define ZODIAC_EXECUTOR_VALIDATOR_H
+
+#include "../controller/controller_registry.h"         // Registered controllers and operations.
+#include "../instruction/instruction_reader_offset.h"  // Offsets of jump targets.
+
+/**
+ * @enum executor_validator_error_e
+ * @brief Enumerates the defects the validator reports.
+ */
+typedef enum executor_validator_error_e {
+    EXECUTOR_VALIDATOR_ERROR_OK,          ///< The program is valid.
+    EXECUTOR_VALIDATOR_ERROR_HEADER,      ///< The program ends inside an instruction header.
+    EXECUTOR_VALIDATOR_ERROR_OPERANDS,    ///< The operands of an instruction run past the end of the program.
+    EXECUTOR_VALIDATOR_ERROR_CONTROLLER,  ///< An instruction addresses a controller that is not registered.
+    EXECUTOR_VALIDATOR_ERROR_OPERATION,   ///< An instruction addresses an operation its controller lacks.
+    EXECUTOR_VALIDATOR_ERROR_JUMP,        ///< A jump target is not the offset of an instruction.
+    EXECUTOR_VALIDATOR_ERROR_MEMORY       ///< The map of instruction boundaries could not be allocated.
+} executor_validator_error_t;
+
+/**
+ * @brief Callback reporting the jump target of an instruction.
+ *
+ * @param[in] sender The sender given to executor_validator_set_jump_callback().
+ * @param[in] header The header of the instruction.
+ * @param[in] operands The operands of the instruction.
+ * @param[out] target Receives the offset the instruction jumps to.
+ * @return Whether the instruction jumps.
+ */
+typedef bool (*executor_validator_jump_callback_t)(callback_sender sender,
+                                                   const instruction_header_t *header,
+                                                   const instruction_operand_t *operands,
+                                                   instruction_reader_offset_t *target);
+
+/**
+ * @struct executor_validator_result_s
+ * @brief Structure that describes the outcome of a validation.
+ */
+typedef struct executor_validator_result_s {
+    executor_validator_error_t error;   ///< The first defect found.
+    size_t offset;                      ///< Offset of the defective instruction, the program size if valid.
+    size_t number_of_instructions;      ///< Number of instructions preceding the defective one.
+} executor_validator_result_t;
+
+/**
+ * @struct executor_validator_s
+ * @brief Structure that holds a snapshot of the registered operations.
+ */
+typedef struct executor_validator_s {
+    uint8_t operations[MAX_NUMBER_OF_CONTROLLERS * MAX_NUMBER_OF_CONTROLLER_OPERATIONS / 8];
+                                                              ///< Bit set of the registered operations.
+    uint16_t dense_limits[MAX_NUMBER_OF_CONTROLLERS];         ///< Number of leading registered operations.
+    bool controllers[MAX_NUMBER_OF_CONTROLLERS];              ///< Whether a controller is registered.
+    executor_validator_jump_callback_t jump_callback;         ///< Reports jump targets, nullptr to skip them.
+    callback_sender jump_sender;                              ///< The sender passed to the jump callback.
+} executor_validator_t;
+
+/**
+ * @brief Takes a snapshot of the operations of a registry.
+ *
+ * Controllers registered afterwards are unknown to the validator until it is initialized again.
+ *
+ * @param[out] validator Pointer to the validator to initialize.
+ * @param[in] registry The registry the validated programs are executed with.
+ */
+void executor_validator_init(executor_validator_t *validator, const controller_registry_t *registry);
+
+/**
+ * @brief Sets the callback reporting jump targets.
+ *
+ * @param[in,out] validator Pointer to the validator.
+ * @param[in] jump_callback The callback, or nullptr to skip the jump check.
+ * @param[in] sender The sender passed to the callback.
+ */
+void executor_validator_set_jump_callback(executor_validator_t *validator,
+                                          executor_validator_jump_callback_t jump_callback,
+                                          callback_sender sender);
+
+/**
+ * @brief Validates a packed program.
+ *
+ * @param[in] validator Pointer to the validator.
+ * @param[in] code The packed instructions.
+ * @param[in] size Number of bytes of the program.
+ * @param[out] result Receives the outcome, or nullptr.
+ * @return executor_validator_error_t The first defect found.
+ */
+executor_validator_error_t executor_validator_validate(const executor_validator_t *validator,
+                                                       const uint8_t *code,
+                                                       size_t size,
+                                                       executor_validator_result_t *result);
+
+#endif // ZODIAC_EXECUTOR_VALIDATOR_H
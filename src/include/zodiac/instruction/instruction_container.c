@@ -0,0 +1,283 @@
+#include "instruction_container.h"
+#include "../platform/platform_memory.h"
+
+#include <string.h>
+
+/// Shortest back-reference the codec encodes.
+#define INSTRUCTION_CONTAINER_MIN_MATCH 4
+
+/// Farthest distance of a back-reference.
+#define INSTRUCTION_CONTAINER_MAX_DISTANCE 65535
+
+/// Number of bits of the hash table of the compressor.
+#define INSTRUCTION_CONTAINER_HASH_BITS 12
+
+/**
+ * @brief Hashes the four bytes starting at the given position.
+ */
+static uint32_t instruction_container_hash(const uint8_t *data) {
+    uint32_t value;
+
+    memcpy(&value, data, sizeof(value));
+    return (value * UINT32_C(2654435761)) >> (32 - INSTRUCTION_CONTAINER_HASH_BITS);
+}
+
+/**
+ * @brief Stores the remainder of a length that did not fit in its token nibble.
+ *
+ * @return Position past the stored bytes, or nullptr if they do not fit.
+ */
+static uint8_t *instruction_container_put_length(uint8_t *cursor, const uint8_t *end, size_t length) {
+    while (length >= 255) {
+        if (cursor == end) {
+            return nullptr;
+        }
+        *cursor++ = 255;
+        length -= 255;
+    }
+
+    if (cursor == end) {
+        return nullptr;
+    }
+
+    *cursor++ = (uint8_t) length;
+    return cursor;
+}
+
+/**
+ * @brief Reads the remainder of a length that did not fit in its token nibble.
+ *
+ * @return Whether the length was complete.
+ */
+static bool instruction_container_get_length(const uint8_t **cursor, const uint8_t *end, size_t *length) {
+    uint8_t byte;
+
+    do {
+        if (*cursor == end) {
+            return false;
+        }
+        byte = *(*cursor)++;
+        *length += byte;
+    } while (byte == 255);
+
+    return true;
+}
+
+/**
+ * @brief Stores a token with its literals and, unless `match_length` is 0, its back-reference.
+ *
+ * @return Position past the token, or nullptr if it does not fit.
+ */
+static uint8_t *instruction_container_put_sequence(uint8_t *cursor, const uint8_t *end,
+                                                   const uint8_t *literals, size_t number_of_literals,
+                                                   size_t distance, size_t match_length) {
+
+    size_t match_code = match_length != 0 ? match_length - INSTRUCTION_CONTAINER_MIN_MATCH : 0;
+    uint8_t *token = cursor;
+
+    if (cursor == end) {
+        return nullptr;
+    }
+
+    *token = (uint8_t) (((number_of_literals < 15 ? number_of_literals : 15) << 4)
+                        | (match_code < 15 ? match_code : 15));
+    ++cursor;
+
+    if (number_of_literals >= 15
+        && (cursor = instruction_container_put_length(cursor, end, number_of_literals - 15)) == nullptr) {
+        return nullptr;
+    }
+
+    if ((size_t) (end - cursor) < number_of_literals) {
+        return nullptr;
+    }
+
+    memcpy(cursor, literals, number_of_literals);
+    cursor += number_of_literals;
+
+    if (match_length == 0) {
+        return cursor;
+    }
+
+    if (end - cursor < 2) {
+        return nullptr;
+    }
+
+    *cursor++ = (uint8_t) distance;
+    *cursor++ = (uint8_t) (distance >> 8);
+
+    if (match_code >= 15) {
+        cursor = instruction_container_put_length(cursor, end, match_code - 15);
+    }
+
+    return cursor;
+}
+
+size_t instruction_container_bound(size_t size) {
+    return size + size / 255 + 16;
+}
+
+size_t instruction_container_compress(const uint8_t *data, size_t size, uint8_t *output, size_t capacity) {
+    uint32_t table[1 << INSTRUCTION_CONTAINER_HASH_BITS] = {0};
+    const uint8_t *end = output + capacity;
+    uint8_t *cursor = output;
+    size_t anchor = 0;
+    size_t position = 0;
+
+    while (position + INSTRUCTION_CONTAINER_MIN_MATCH <= size) {
+        uint32_t hash = instruction_container_hash(data + position);
+        size_t candidate = table[hash];
+        size_t length;
+
+        // Entries hold positions plus one, leaving 0 for empty entries.
+        table[hash] = (uint32_t) (position + 1);
+
+        if (candidate == 0
+            || position - (candidate - 1) > INSTRUCTION_CONTAINER_MAX_DISTANCE
+            || memcmp(data + candidate - 1, data + position, INSTRUCTION_CONTAINER_MIN_MATCH) != 0) {
+            ++position;
+            continue;
+        }
+
+        --candidate;
+        length = INSTRUCTION_CONTAINER_MIN_MATCH;
+        while (position + length < size && data[candidate + length] == data[position + length]) {
+            ++length;
+        }
+
+        cursor = instruction_container_put_sequence(cursor, end, data + anchor, position - anchor,
+                                                    position - candidate, length);
+        if (cursor == nullptr) {
+            return 0;
+        }
+
+        position += length;
+        anchor = position;
+    }
+
+    cursor = instruction_container_put_sequence(cursor, end, data + anchor, size - anchor, 0, 0);
+    return cursor != nullptr ? (size_t) (cursor - output) : 0;
+}
+
+size_t instruction_container_decompress(const uint8_t *data, size_t size, uint8_t *output, size_t capacity) {
+    const uint8_t *end = data + size;
+    size_t position = 0;
+
+    while (data < end) {
+        uint8_t token = *data++;
+        size_t number_of_literals = token >> 4;
+        size_t length = (token & 15) + INSTRUCTION_CONTAINER_MIN_MATCH;
+        size_t distance;
+
+        if (number_of_literals == 15 && !instruction_container_get_length(&data, end, &number_of_literals)) {
+            return SIZE_MAX;
+        }
+
+        if ((size_t) (end - data) < number_of_literals || capacity - position < number_of_literals) {
+            return SIZE_MAX;
+        }
+
+        memcpy(output + position, data, number_of_literals);
+        data += number_of_literals;
+        position += number_of_literals;
+
+        if (data == end) {
+            break;
+        }
+
+        if (end - data < 2) {
+            return SIZE_MAX;
+        }
+
+        distance = data[0] | ((size_t) data[1] << 8);
+        data += 2;
+
+        if ((token & 15) == 15 && !instruction_container_get_length(&data, end, &length)) {
+            return SIZE_MAX;
+        }
+
+        if (distance == 0 || distance > position || capacity - position < length) {
+            return SIZE_MAX;
+        }
+
+        // Byte by byte, since a back-reference may overlap the bytes it produces.
+        for (size_t index = 0; index < length; ++index, ++position) {
+            output[position] = output[position - distance];
+        }
+    }
+
+    return position;
+}
+
+/**
+ * @brief Stores a value of the given number of bytes in little-endian byte order.
+ */
+static uint8_t *instruction_container_put(uint8_t *cursor, uint64_t value, size_t size) {
+    for (size_t index = 0; index < size; ++index) {
+        cursor[index] = (uint8_t) (value >> (index * 8));
+    }
+    return cursor + size;
+}
+
+instruction_container_error_t instruction_container_pack(FILE *stream,
+                                                         const uint8_t *data,
+                                                         size_t size,
+                                                         size_t block_size) {
+
+    instruction_container_error_t error = INSTRUCTION_CONTAINER_ERROR_OK;
+    size_t number_of_blocks;
+    size_t metadata_size;
+    size_t used = 0;
+    uint8_t *metadata;
+    uint8_t *blocks;
+    uint8_t *cursor;
+
+    if (block_size == 0) {
+        block_size = INSTRUCTION_CONTAINER_DEFAULT_BLOCK_SIZE;
+    } else if (block_size > INSTRUCTION_CONTAINER_MAX_BLOCK_SIZE) {
+        block_size = INSTRUCTION_CONTAINER_MAX_BLOCK_SIZE;
+    }
+
+    number_of_blocks = (size + block_size - 1) / block_size;
+    metadata_size = INSTRUCTION_CONTAINER_HEADER_SIZE + number_of_blocks * INSTRUCTION_CONTAINER_INDEX_ENTRY_SIZE;
+
+    metadata = platform_memory_allocate(nullptr, metadata_size);
+    // Blocks that do not shrink are stored as is, so the blocks never outgrow the stream.
+    blocks = platform_memory_allocate(nullptr, size + 1);
+    if (metadata == nullptr || blocks == nullptr) {
+        platform_memory_release(nullptr, metadata);
+        platform_memory_release(nullptr, blocks);
+        return INSTRUCTION_CONTAINER_ERROR_MEMORY;
+    }
+
+    memcpy(metadata, INSTRUCTION_CONTAINER_MAGIC, INSTRUCTION_CONTAINER_MAGIC_SIZE);
+    cursor = instruction_container_put(metadata + INSTRUCTION_CONTAINER_MAGIC_SIZE, block_size, 4);
+    cursor = instruction_container_put(cursor, number_of_blocks, 4);
+    cursor = instruction_container_put(cursor, size, 8);
+
+    for (size_t index = 0; index < number_of_blocks; ++index) {
+        size_t start = index * block_size;
+        size_t length = size - start < block_size ? size - start : block_size;
+        size_t stored_size = instruction_container_compress(data + start, length, blocks + used, length);
+        uint32_t flags = 0;
+
+        if (stored_size == 0 || stored_size >= length) {
+            memcpy(blocks + used, data + start, length);
+            stored_size = length;
+            flags = INSTRUCTION_CONTAINER_BLOCK_RAW;
+        }
+
+        cursor = instruction_container_put(cursor, metadata_size + used, 8);
+        cursor = instruction_container_put(cursor, stored_size | flags, 4);
+        used += stored_size;
+    }
+
+    if (fwrite(metadata, 1, metadata_size, stream) != metadata_size
+        || fwrite(blocks, 1, used, stream) != used) {
+        error = INSTRUCTION_CONTAINER_ERROR_WRITE;
+    }
+
+    platform_memory_release(nullptr, metadata);
+    platform_memory_release(nullptr, blocks);
+    return error;
+}
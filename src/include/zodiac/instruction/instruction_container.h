@@ -0,0 +1,131 @@
+/**
+ * @file instruction_container.h
+ * @brief Defines the compressed container format of program files.
+ *
+ * A container splits a packed instruction stream (see instruction_packed.h) into blocks
+ * of a fixed uncompressed size and compresses every block on its own, so any offset of
+ * the stream can be reached by decompressing a single block. All integers are stored in
+ * little-endian byte order:
+ *
+ *     header   magic "ZDCPACK1", u32 block size, u32 number of blocks, u64 stream size
+ *     index    per block: u64 file offset of the block, u32 stored size
+ *     blocks   the stored bytes of every block
+ *
+ * The highest bit of a stored size marks a block kept uncompressed because compressing
+ * it did not save any space.
+ *
+ * Blocks are compressed with a small bundled LZ77 codec in the spirit of LZ4: a block is
+ * a sequence of tokens, each holding a run of literals followed by a back-reference of at
+ * least four bytes into the preceding 64 KiB, and the last token holds literals only.
+ */
+
+#ifndef ZODIAC_INSTRUCTION_CONTAINER_H
+#define ZODIAC_INSTRUCTION_CONTAINER_H
+
+#include "../platform/platform.h"  // Fixed-width and boolean types.
+
+#include <stdio.h>
+
+/**
+ * @brief Magic bytes a container starts with.
+ */
+#define INSTRUCTION_CONTAINER_MAGIC "ZDCPACK1"
+
+/**
+ * @brief Number of magic bytes a container starts with.
+ */
+#define INSTRUCTION_CONTAINER_MAGIC_SIZE 8
+
+/**
+ * @brief Size of the header of a container in bytes.
+ */
+#define INSTRUCTION_CONTAINER_HEADER_SIZE 24
+
+/**
+ * @brief Size of an entry of the block index in bytes.
+ */
+#define INSTRUCTION_CONTAINER_INDEX_ENTRY_SIZE 12
+
+/**
+ * @brief Default uncompressed size of a block in bytes.
+ */
+#define INSTRUCTION_CONTAINER_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+/**
+ * @brief Largest uncompressed size of a block in bytes.
+ */
+#define INSTRUCTION_CONTAINER_MAX_BLOCK_SIZE (16 * 1024 * 1024)
+
+/**
+ * @brief Flag of a stored size marking an uncompressed block.
+ */
+#define INSTRUCTION_CONTAINER_BLOCK_RAW UINT32_C(0x80000000)
+
+/**
+ * @enum instruction_container_error_e
+ * @brief Enumerates possible errors that can occur when writing a container.
+ */
+typedef enum instruction_container_error_e {
+    INSTRUCTION_CONTAINER_ERROR_OK,      ///< No error occurred, the container is written.
+    INSTRUCTION_CONTAINER_ERROR_WRITE,   ///< The stream rejected the written bytes.
+    INSTRUCTION_CONTAINER_ERROR_MEMORY   ///< The compressed blocks could not be allocated.
+} instruction_container_error_t;
+
+/**
+ * @struct instruction_container_block_s
+ * @brief Structure that locates a block inside a container.
+ */
+typedef struct instruction_container_block_s {
+    uint64_t offset;        ///< Offset of the stored bytes from the start of the container.
+    uint32_t stored_size;   ///< Number of stored bytes, without INSTRUCTION_CONTAINER_BLOCK_RAW.
+    bool raw;               ///< Whether the block is stored uncompressed.
+} instruction_container_block_t;
+
+/**
+ * @brief Returns the largest compressed size of a block.
+ *
+ * @param[in] size Uncompressed size of the block.
+ * @return Number of bytes a compressed block may occupy at most.
+ */
+size_t instruction_container_bound(size_t size);
+
+/**
+ * @brief Compresses a block.
+ *
+ * @param[in] data The bytes to compress.
+ * @param[in] size Number of bytes to compress.
+ * @param[out] output Receives the compressed bytes.
+ * @param[in] capacity Size of the output, instruction_container_bound() is always enough.
+ * @return Number of compressed bytes, or 0 if they do not fit in the output.
+ */
+size_t instruction_container_compress(const uint8_t *data, size_t size, uint8_t *output, size_t capacity);
+
+/**
+ * @brief Decompresses a block.
+ *
+ * Corrupt input never writes past the output.
+ *
+ * @param[in] data The compressed bytes.
+ * @param[in] size Number of compressed bytes.
+ * @param[out] output Receives the decompressed bytes.
+ * @param[in] capacity Size of the output.
+ * @return Number of decompressed bytes, or SIZE_MAX if the input is corrupt or does not fit.
+ */
+size_t instruction_container_decompress(const uint8_t *data, size_t size, uint8_t *output, size_t capacity);
+
+/**
+ * @brief Writes a packed instruction stream as a container.
+ *
+ * @param[in,out] stream The stream to write to.
+ * @param[in] data The packed instruction stream.
+ * @param[in] size Number of bytes of the stream.
+ * @param[in] block_size Uncompressed size of a block, or 0 for the default, clamped to
+ *                       INSTRUCTION_CONTAINER_MAX_BLOCK_SIZE.
+ * @return instruction_container_error_t Error code resulting from the operation.
+ */
+instruction_container_error_t instruction_container_pack(FILE *stream,
+                                                         const uint8_t *data,
+                                                         size_t size,
+                                                         size_t block_size);
+
+#endif // ZODIAC_INSTRUCTION_CONTAINER_H
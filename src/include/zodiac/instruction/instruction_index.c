@@ -0,0 +1,120 @@
+#include "instruction_index.h"
+
+/**
+ * @brief Returns the number of words of the bitmap of code of the given size.
+ *
+ * One word more than needed for the bytes of code lets the end of the code be ranked.
+ */
+static size_t instruction_index_number_of_words(size_t size) {
+    return size / 64 + 1;
+}
+
+void instruction_index_init(instruction_index_t *index) {
+    index->boundaries = nullptr;
+    index->ranks = nullptr;
+    index->samples = nullptr;
+    index->size = 0;
+    index->number_of_instructions = 0;
+    index->allocator = nullptr;
+}
+
+void instruction_index_free(instruction_index_t *index) {
+    platform_memory_release(index->allocator, index->boundaries);
+    platform_memory_release(index->allocator, index->ranks);
+    platform_memory_release(index->allocator, index->samples);
+    instruction_index_init(index);
+}
+
+instruction_index_error_t instruction_index_reserve(instruction_index_t *index,
+                                                   size_t size,
+                                                   const platform_allocator_t *allocator) {
+
+    index->boundaries = platform_memory_allocate_zeroed(allocator,
+                                                        instruction_index_number_of_words(size) * sizeof(uint64_t));
+    if (index->boundaries == nullptr) {
+        return INSTRUCTION_INDEX_ERROR_MEMORY;
+    }
+
+    index->size = size;
+    index->allocator = allocator;
+    return INSTRUCTION_INDEX_ERROR_OK;
+}
+
+instruction_index_error_t instruction_index_complete(instruction_index_t *index) {
+    size_t number_of_words = instruction_index_number_of_words(index->size);
+    size_t number_of_instructions = 0;
+    size_t number_of_samples = 0;
+
+    index->ranks = platform_memory_allocate(index->allocator,
+                                            (number_of_words / INSTRUCTION_INDEX_BLOCK_WORDS + 1) * sizeof(uint64_t));
+    if (index->ranks == nullptr) {
+        return INSTRUCTION_INDEX_ERROR_MEMORY;
+    }
+
+    for (size_t word = 0; word < number_of_words; ++word) {
+        if (word % INSTRUCTION_INDEX_BLOCK_WORDS == 0) {
+            index->ranks[word / INSTRUCTION_INDEX_BLOCK_WORDS] = number_of_instructions;
+        }
+
+        number_of_instructions += platform_bits_count(index->boundaries[word]);
+    }
+
+    // One spare sample keeps the allocation non-empty for empty code.
+    index->samples = platform_memory_allocate(index->allocator,
+                                              (number_of_instructions / INSTRUCTION_INDEX_SAMPLE_RATE + 1)
+                                              * sizeof(size_t));
+    if (index->samples == nullptr) {
+        return INSTRUCTION_INDEX_ERROR_MEMORY;
+    }
+
+    number_of_instructions = 0;
+
+    for (size_t word = 0; word < number_of_words; ++word) {
+        uint64_t bits = index->boundaries[word];
+
+        while (bits != 0) {
+            if (number_of_instructions++ % INSTRUCTION_INDEX_SAMPLE_RATE == 0) {
+                index->samples[number_of_samples++] = word * 64 + platform_bits_lowest(bits);
+            }
+
+            bits &= bits - 1;
+        }
+    }
+
+    index->number_of_instructions = number_of_instructions;
+    return INSTRUCTION_INDEX_ERROR_OK;
+}
+
+instruction_index_error_t instruction_index_build(instruction_index_t *index,
+                                                 const uint8_t *code,
+                                                 size_t size,
+                                                 const platform_allocator_t *allocator) {
+
+    instruction_index_error_t error = instruction_index_reserve(index, size, allocator);
+    instruction_reader_read_error_t read_error;
+    instruction_view_t view;
+    size_t offset = 0;
+
+    if (error != INSTRUCTION_INDEX_ERROR_OK) {
+        return error;
+    }
+
+    while ((read_error = instruction_packed_decode(code, size, offset, &view)) == INSTRUCTION_READER_READ_ERROR_OK) {
+        instruction_index_mark(index, offset);
+        offset += instruction_packed_size(view.header);
+    }
+
+    if (read_error == INSTRUCTION_READER_READ_ERROR_END) {
+        error = instruction_index_complete(index);
+    } else {
+        error = read_error == INSTRUCTION_READER_READ_ERROR_HEADER
+                ? INSTRUCTION_INDEX_ERROR_HEADER
+                : INSTRUCTION_INDEX_ERROR_OPERANDS;
+    }
+
+    if (error != INSTRUCTION_INDEX_ERROR_OK) {
+        instruction_index_free(index);
+    }
+
+    return error;
+}
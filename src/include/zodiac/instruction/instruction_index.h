@@ -0,0 +1,191 @@
+/**
+ * @file instruction_index.h
+ * @brief Defines a compact index of the instruction boundaries of packed code.
+ *
+ * Instructions in the packed format have variable lengths, so neither the offset of the
+ * n-th instruction nor whether an offset starts an instruction can be told without
+ * scanning. The index answers both in constant time from:
+ * - a bitmap with one bit per byte of code, set where an instruction starts;
+ * - the number of instruction starts before every block of the bitmap (rank);
+ * - the offset of every INSTRUCTION_INDEX_SAMPLE_RATE-th instruction (select).
+ *
+ * It takes about 1/7 of the size of the code, independently of the number of
+ * instructions, and is built once when a program is loaded. Tools searching boundaries
+ * in huge programs use it instead of walking the code.
+ */
+
+#ifndef ZODIAC_INSTRUCTION_INDEX_H
+#define ZODIAC_INSTRUCTION_INDEX_H
+
+#include "instruction_packed.h"             // Packed instruction accessors.
+#include "../platform/platform_bits.h"      // Bit counting of the bitmap.
+#include "../platform/platform_memory.h"    // Source of the memory of the index.
+
+/// Number of words of the bitmap covered by each rank entry.
+#define INSTRUCTION_INDEX_BLOCK_WORDS 8
+
+/// Number of instructions between two sampled offsets.
+#define INSTRUCTION_INDEX_SAMPLE_RATE 64
+
+/**
+ * @enum instruction_index_error_e
+ * @brief Enumerates possible errors that can occur when building an index.
+ */
+typedef enum instruction_index_error_e {
+    INSTRUCTION_INDEX_ERROR_OK,         ///< No error occurred, the index is complete.
+    INSTRUCTION_INDEX_ERROR_HEADER,     ///< The code ends within the header of an instruction.
+    INSTRUCTION_INDEX_ERROR_OPERANDS,   ///< The code ends within the operands of an instruction.
+    INSTRUCTION_INDEX_ERROR_MEMORY      ///< The memory for the index could not be allocated.
+} instruction_index_error_t;
+
+/**
+ * @struct instruction_index_s
+ * @brief Structure that holds the boundaries of the instructions of a code buffer.
+ */
+typedef struct instruction_index_s {
+    uint64_t *boundaries;                   ///< One bit per byte of code, set where an instruction starts.
+    uint64_t *ranks;                        ///< Number of instruction starts before each block of the bitmap.
+    size_t *samples;                        ///< Offset of every INSTRUCTION_INDEX_SAMPLE_RATE-th instruction.
+    size_t size;                            ///< Number of bytes of code indexed.
+    size_t number_of_instructions;          ///< Number of instructions, known once the index is complete.
+    const platform_allocator_t *allocator;  ///< Source of the memory, nullptr for the default allocator.
+} instruction_index_t;
+
+/**
+ * @brief Initializes an empty index.
+ *
+ * @param[out] index Pointer to the index to initialize.
+ */
+void instruction_index_init(instruction_index_t *index);
+
+/**
+ * @brief Releases the memory held by an index and leaves it empty.
+ *
+ * @param[in,out] index Pointer to the index to release.
+ */
+void instruction_index_free(instruction_index_t *index);
+
+/**
+ * @brief Allocates a cleared bitmap for code of the given size.
+ *
+ * Boundaries are then set with instruction_index_mark() and the index finished with
+ * instruction_index_complete(), which lets code already walked by its loader be indexed
+ * without walking it again.
+ *
+ * @param[in,out] index Pointer to an empty index.
+ * @param[in] size Number of bytes of code.
+ * @param[in] allocator The allocator of the index, or nullptr for the default allocator.
+ * @return instruction_index_error_t Error code resulting from the operation.
+ */
+instruction_index_error_t instruction_index_reserve(instruction_index_t *index,
+                                                   size_t size,
+                                                   const platform_allocator_t *allocator);
+
+/**
+ * @brief Marks the start of an instruction in a reserved index.
+ *
+ * @param[in,out] index Pointer to the index.
+ * @param[in] offset Offset of the instruction, less than the size of the code.
+ */
+ZDC_STATIC_INLINE void instruction_index_mark(instruction_index_t *index, size_t offset) {
+    index->boundaries[offset / 64] |= UINT64_C(1) << (offset % 64);
+}
+
+/**
+ * @brief Computes the rank and select tables once every boundary is marked.
+ *
+ * @param[in,out] index Pointer to the reserved index.
+ * @return instruction_index_error_t Error code resulting from the operation.
+ */
+instruction_index_error_t instruction_index_complete(instruction_index_t *index);
+
+/**
+ * @brief Builds the index of packed code by walking it.
+ *
+ * @param[in,out] index Pointer to an empty index, left empty on failure.
+ * @param[in] code Start of the packed instructions.
+ * @param[in] size Number of bytes at `code`.
+ * @param[in] allocator The allocator of the index, or nullptr for the default allocator.
+ * @return instruction_index_error_t Error code resulting from the operation.
+ */
+instruction_index_error_t instruction_index_build(instruction_index_t *index,
+                                                 const uint8_t *code,
+                                                 size_t size,
+                                                 const platform_allocator_t *allocator);
+
+/**
+ * @brief Returns whether an offset is the start of an instruction.
+ *
+ * Only reads the bitmap, so it may be used on a reserved index as soon as its boundaries are marked.
+ *
+ * @param[in] index Pointer to the index.
+ * @param[in] offset Any offset.
+ * @return Whether an instruction starts at the offset.
+ */
+ZDC_STATIC_INLINE bool instruction_index_is_boundary(const instruction_index_t *index,
+                                                     instruction_reader_offset_t offset) {
+
+    return offset >= 0 && (size_t) offset < index->size
+           && (index->boundaries[(size_t) offset / 64] >> ((size_t) offset % 64) & 1u) != 0;
+}
+
+/**
+ * @brief Returns the number of instructions starting before an offset.
+ *
+ * This is also the ordinal number of the first instruction starting at or after the offset.
+ *
+ * @param[in] index Pointer to the complete index.
+ * @param[in] offset Any offset, clamped to the bounds of the code.
+ * @return The number of instructions, up to `number_of_instructions`.
+ */
+ZDC_STATIC_INLINE size_t instruction_index_rank(const instruction_index_t *index,
+                                                instruction_reader_offset_t offset) {
+
+    size_t position = offset < 0 ? 0 : (size_t) offset < index->size ? (size_t) offset : index->size;
+    size_t word = position / 64;
+    size_t rank = (size_t) index->ranks[word / INSTRUCTION_INDEX_BLOCK_WORDS];
+
+    for (size_t previous = word - word % INSTRUCTION_INDEX_BLOCK_WORDS; previous < word; ++previous) {
+        rank += platform_bits_count(index->boundaries[previous]);
+    }
+
+    return rank + platform_bits_count(index->boundaries[word] & ((UINT64_C(1) << (position % 64)) - 1));
+}
+
+/**
+ * @brief Returns the offset of the instruction with the given ordinal number.
+ *
+ * Scans the bitmap from the nearest sampled offset, so the cost is bounded by the
+ * length of INSTRUCTION_INDEX_SAMPLE_RATE instructions.
+ *
+ * @param[in] index Pointer to the complete index.
+ * @param[in] ordinal Ordinal number of the instruction.
+ * @return The offset of the instruction, or the size of the code past the last instruction.
+ */
+ZDC_STATIC_INLINE instruction_reader_offset_t instruction_index_select(const instruction_index_t *index,
+                                                                       size_t ordinal) {
+
+    size_t offset;
+    size_t word;
+    uint64_t bits;
+    unsigned int rank;
+    unsigned int count;
+
+    if (ordinal >= index->number_of_instructions) {
+        return (instruction_reader_offset_t) index->size;
+    }
+
+    offset = index->samples[ordinal / INSTRUCTION_INDEX_SAMPLE_RATE];
+    rank = (unsigned int) (ordinal % INSTRUCTION_INDEX_SAMPLE_RATE);
+    word = offset / 64;
+    bits = index->boundaries[word] & (~UINT64_C(0) << (offset % 64));
+
+    while (rank >= (count = platform_bits_count(bits))) {
+        rank -= count;
+        bits = index->boundaries[++word];
+    }
+
+    return (instruction_reader_offset_t) (word * 64 + platform_bits_select(bits, rank));
+}
+
+#endif // ZODIAC_INSTRUCTION_INDEX_H
@@ -0,0 +1,104 @@
+/**
+ * @file instruction_packed.h
+ * @brief Accessors for instructions stored in the packed in-memory format.
+ *
+ * In the packed format every instruction occupies its instruction_header_t followed by
+ * exactly `number_of_operands` operand bytes, with no padding between instructions.
+ * This is the layout of program files as well as of decoded programs, so readers and
+ * the executor share these accessors to walk instructions in place.
+ */
+
+#ifndef ZODIAC_INSTRUCTION_PACKED_H
+#define ZODIAC_INSTRUCTION_PACKED_H
+
+#include "instruction_reader_read_callback.h"  // Read errors.
+#include "instruction_reader_seek_callback.h"  // Seek modes.
+#include "instruction_view.h"                  // Non-owning instruction view.
+
+/**
+ * @brief Returns the number of bytes a packed instruction occupies.
+ *
+ * @param[in] header The header of the instruction.
+ * @return The size of the header plus the size of the operands.
+ */
+ZDC_STATIC_INLINE size_t instruction_packed_size(const instruction_header_t *header) {
+    return sizeof(instruction_header_t) + header->number_of_operands;
+}
+
+/**
+ * @brief Decodes the packed instruction starting at the given position.
+ *
+ * @param[in] code Start of the packed instructions.
+ * @param[in] size Number of bytes available at `code`.
+ * @param[in] position Offset of the instruction to decode.
+ * @param[out] view The view to fill with pointers into `code`.
+ * @return instruction_reader_read_error_t Error code resulting from the decoding.
+ */
+ZDC_STATIC_INLINE instruction_reader_read_error_t instruction_packed_decode(const uint8_t *code,
+                                                                           size_t size,
+                                                                           size_t position,
+                                                                           instruction_view_t *view) {
+
+    size_t remaining = position < size ? size - position : 0;
+    const instruction_header_t *header;
+
+    if (remaining == 0) {
+        return INSTRUCTION_READER_READ_ERROR_END;
+    }
+
+    if (remaining < sizeof(instruction_header_t)) {
+        return INSTRUCTION_READER_READ_ERROR_HEADER;
+    }
+
+    header = (const instruction_header_t *) (code + position);
+    if (remaining - sizeof(instruction_header_t) < header->number_of_operands) {
+        return INSTRUCTION_READER_READ_ERROR_OPERANDS;
+    }
+
+    view->header = header;
+    view->operands = code + position + sizeof(instruction_header_t);
+    return INSTRUCTION_READER_READ_ERROR_OK;
+}
+
+/**
+ * @brief Computes the position resulting from a seek within packed instructions.
+ *
+ * The resulting position is clamped to the range [0, size].
+ *
+ * @param[in] position The current position.
+ * @param[in] size Number of bytes of packed instructions.
+ * @param[in] offset Offset to apply from the seek mode's starting point.
+ * @param[in] mode The seek mode defining the starting point for the offset.
+ * @return The new position.
+ */
+ZDC_STATIC_INLINE size_t instruction_packed_seek(size_t position,
+                                                 size_t size,
+                                                 instruction_reader_offset_t offset,
+                                                 instruction_reader_seek_mode_t mode) {
+
+    instruction_reader_offset_t origin;
+
+    switch (mode) {
+        case INSTRUCTION_READER_SEEK_CUR:
+            origin = (instruction_reader_offset_t) position;
+            break;
+        case INSTRUCTION_READER_SEEK_END:
+            origin = (instruction_reader_offset_t) size;
+            break;
+        default:
+            origin = 0;
+            break;
+    }
+
+    if (offset < -origin) {
+        return 0;
+    }
+
+    if (offset > (instruction_reader_offset_t) size - origin) {
+        return size;
+    }
+
+    return (size_t) (origin + offset);
+}
+
+#endif // ZODIAC_INSTRUCTION_PACKED_H
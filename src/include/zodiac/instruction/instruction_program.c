@@ -0,0 +1,116 @@
+#include "instruction_program.h"
+
+#include <string.h>
+
+/// Initial capacity of the packed instructions buffer in bytes.
+#define INSTRUCTION_PROGRAM_INITIAL_CODE_CAPACITY 4096
+
+/// Initial capacity of the offsets index in entries.
+#define INSTRUCTION_PROGRAM_INITIAL_OFFSETS_CAPACITY 1024
+
+/// Number of instructions requested from the reader per batch while loading.
+#define INSTRUCTION_PROGRAM_LOAD_BATCH_SIZE 16
+
+/**
+ * @brief Ensures a buffer with the given capacity can hold `required` units of `unit` bytes.
+ *
+ * Buffers are grown geometrically starting from `initial_capacity` units.
+ */
+static bool instruction_program_reserve(const platform_allocator_t *allocator, void **buffer, size_t *capacity,
+                                        size_t required, size_t initial_capacity, size_t unit) {
+
+    size_t grown_capacity = *capacity != 0 ? *capacity : initial_capacity;
+    void *reallocated;
+
+    if (required <= *capacity) {
+        return true;
+    }
+
+    while (grown_capacity < required) {
+        grown_capacity *= 2;
+    }
+
+    reallocated = platform_memory_reallocate(allocator, *buffer, grown_capacity * unit);
+    if (reallocated == nullptr) {
+        return false;
+    }
+
+    *buffer = reallocated;
+    *capacity = grown_capacity;
+    return true;
+}
+
+void instruction_program_init(instruction_program_t *program) {
+    program->code = nullptr;
+    program->size = 0;
+    program->code_capacity = 0;
+    program->offsets = nullptr;
+    program->number_of_instructions = 0;
+    program->offsets_capacity = 0;
+    program->allocator = nullptr;
+}
+
+void instruction_program_set_allocator(instruction_program_t *program, const platform_allocator_t *allocator) {
+    program->allocator = allocator;
+}
+
+void instruction_program_free(instruction_program_t *program) {
+    const platform_allocator_t *allocator = program->allocator;
+
+    platform_memory_release(allocator, program->code);
+    platform_memory_release(allocator, program->offsets);
+    instruction_program_init(program);
+    program->allocator = allocator;
+}
+
+instruction_program_error_t instruction_program_append(instruction_program_t *program,
+                                                       const instruction_header_t *header,
+                                                       const instruction_operand_t *operands) {
+
+    size_t size = instruction_packed_size(header);
+
+    if (!instruction_program_reserve(program->allocator, (void **) &program->code, &program->code_capacity,
+                                     program->size + size,
+                                     INSTRUCTION_PROGRAM_INITIAL_CODE_CAPACITY, sizeof(uint8_t)) ||
+        !instruction_program_reserve(program->allocator, (void **) &program->offsets, &program->offsets_capacity,
+                                     program->number_of_instructions + 1,
+                                     INSTRUCTION_PROGRAM_INITIAL_OFFSETS_CAPACITY,
+                                     sizeof(instruction_reader_offset_t))) {
+
+        return INSTRUCTION_PROGRAM_ERROR_MEMORY;
+    }
+
+    memcpy(program->code + program->size, header, sizeof(instruction_header_t));
+
+    // memcpy() requires valid pointers even for zero bytes, and operands may be nullptr.
+    if (header->number_of_operands > 0) {
+        memcpy(program->code + program->size + sizeof(instruction_header_t), operands, header->number_of_operands);
+    }
+
+    program->offsets[program->number_of_instructions++] = (instruction_reader_offset_t) program->size;
+    program->size += size;
+    return INSTRUCTION_PROGRAM_ERROR_OK;
+}
+
+instruction_program_error_t instruction_program_load(instruction_program_t *program, instruction_reader_t *reader) {
+    instruction_t instructions[INSTRUCTION_PROGRAM_LOAD_BATCH_SIZE];
+    instruction_reader_read_error_t read_error;
+    size_t number_of_read_instructions;
+
+    do {
+        read_error = instruction_reader_read_many(reader, instructions, INSTRUCTION_PROGRAM_LOAD_BATCH_SIZE,
+                                                  &number_of_read_instructions);
+
+        for (size_t index = 0; index < number_of_read_instructions; ++index) {
+            if (instruction_program_append(program, &instructions[index].header, instructions[index].operands)
+                != INSTRUCTION_PROGRAM_ERROR_OK) {
+
+                return INSTRUCTION_PROGRAM_ERROR_MEMORY;
+            }
+        }
+    } while (read_error == INSTRUCTION_READER_READ_ERROR_OK);
+
+    return read_error == INSTRUCTION_READER_READ_ERROR_END
+           ? INSTRUCTION_PROGRAM_ERROR_OK
+           : INSTRUCTION_PROGRAM_ERROR_READ;
+}
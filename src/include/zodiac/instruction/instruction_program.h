@@ -0,0 +1,119 @@
+/**
+ * @file instruction_program.h
+ * @brief Defines a decoded program held in the packed in-memory format.
+ *
+ * A program stores every instruction as its header followed by exactly
+ * `number_of_operands` operand bytes (see instruction_packed.h), instead of the fixed
+ * size instruction_t, so long programs stay dense in the cache. An index maps the
+ * ordinal number of each instruction to its offset, which resolves jumps by
+ * instruction number without scanning.
+ */
+
+#ifndef ZODIAC_INSTRUCTION_PROGRAM_H
+#define ZODIAC_INSTRUCTION_PROGRAM_H
+
+#include "instruction_packed.h"  // Packed instruction accessors.
+#include "instruction_reader.h"  // Source of the instructions to load.
+#include "../platform/platform_memory.h"  // Source of the memory of the program.
+
+/**
+ * @enum instruction_program_error_e
+ * @brief Enumerates possible errors that can occur when loading a program.
+ */
+typedef enum instruction_program_error_e {
+    INSTRUCTION_PROGRAM_ERROR_OK,       ///< No error occurred, the program is loaded.
+    INSTRUCTION_PROGRAM_ERROR_READ,     ///< The reader failed before reaching the end of the stream.
+    INSTRUCTION_PROGRAM_ERROR_MEMORY    ///< The memory for the program could not be allocated.
+} instruction_program_error_t;
+
+/**
+ * @struct instruction_program_s
+ * @brief Structure that holds the packed instructions of a program and their index.
+ */
+typedef struct instruction_program_s {
+    uint8_t *code;                          ///< Packed instructions.
+    size_t size;                            ///< Number of bytes of packed instructions.
+    size_t code_capacity;                   ///< Number of bytes allocated for packed instructions.
+    instruction_reader_offset_t *offsets;   ///< Offset of each instruction, indexed by ordinal.
+    size_t number_of_instructions;          ///< Number of instructions in the program.
+    size_t offsets_capacity;                ///< Number of entries allocated for the offsets index.
+    const platform_allocator_t *allocator;  ///< Source of the memory, nullptr for the default allocator.
+} instruction_program_t;
+
+/**
+ * @brief Initializes an empty program.
+ *
+ * @param[out] program Pointer to the program to initialize.
+ */
+void instruction_program_init(instruction_program_t *program);
+
+/**
+ * @brief Sets the allocator providing the memory of an empty program.
+ *
+ * @param[in,out] program Pointer to the program, which must not hold instructions yet.
+ * @param[in] allocator The allocator, or nullptr for the default allocator.
+ */
+void instruction_program_set_allocator(instruction_program_t *program, const platform_allocator_t *allocator);
+
+/**
+ * @brief Releases the memory held by a program and leaves it empty.
+ *
+ * The allocator of the program is kept.
+ *
+ * @param[in,out] program Pointer to the program to release.
+ */
+void instruction_program_free(instruction_program_t *program);
+
+/**
+ * @brief Appends an instruction to a program.
+ *
+ * @param[in,out] program Pointer to the program.
+ * @param[in] header The header of the instruction to append.
+ * @param[in] operands The `header->number_of_operands` operands of the instruction, may be nullptr when there
+ *                     are none.
+ * @return instruction_program_error_t Error code resulting from the operation.
+ */
+instruction_program_error_t instruction_program_append(instruction_program_t *program,
+                                                       const instruction_header_t *header,
+                                                       const instruction_operand_t *operands);
+
+/**
+ * @brief Loads a program from the current position of a reader until the end of the stream.
+ *
+ * The instructions are appended to the program, which must have been initialized.
+ *
+ * @param[in,out] program Pointer to the program.
+ * @param[in,out] reader The reader from which instructions are loaded.
+ * @return instruction_program_error_t Error code resulting from the operation.
+ */
+instruction_program_error_t instruction_program_load(instruction_program_t *program, instruction_reader_t *reader);
+
+/**
+ * @brief Returns a view of the instruction at the given offset.
+ *
+ * @param[in] program Pointer to the program.
+ * @param[in] offset Offset of the instruction.
+ * @param[out] view The view to fill with pointers into the program.
+ * @return instruction_reader_read_error_t Error code resulting from the decoding.
+ */
+ZDC_STATIC_INLINE instruction_reader_read_error_t instruction_program_view(const instruction_program_t *program,
+                                                                          instruction_reader_offset_t offset,
+                                                                          instruction_view_t *view) {
+
+    return instruction_packed_decode(program->code, program->size, (size_t) offset, view);
+}
+
+/**
+ * @brief Returns the offset of the instruction with the given ordinal number.
+ *
+ * @param[in] program Pointer to the program.
+ * @param[in] ordinal Ordinal number of the instruction, less than `number_of_instructions`.
+ * @return The offset of the instruction.
+ */
+ZDC_STATIC_INLINE instruction_reader_offset_t instruction_program_offset(const instruction_program_t *program,
+                                                                         size_t ordinal) {
+
+    return program->offsets[ordinal];
+}
+
+#endif // ZODIAC_INSTRUCTION_PROGRAM_H
@@ -1,4 +1,5 @@
 #include "instruction_reader.h"
+#include "../runtime/tracer/tracer.h"
 
 void instruction_reader_init(instruction_reader_t *reader, void *sender,
                              instruction_reader_read_callback_t read_callback,
@@ -9,21 +10,69 @@ void instruction_reader_init(instruction_reader_t *reader, void *sender,
     reader->read_callback = read_callback;
     reader->seek_callback = seek_callback;
     reader->tell_callback = tell_callback;
+    reader->read_many_callback = nullptr;
+}
+
+void instruction_reader_set_read_many_callback(instruction_reader_t *reader,
+                                               instruction_reader_read_many_callback_t read_many_callback) {
+
+    reader->read_many_callback = read_many_callback;
 }
 
 instruction_reader_read_error_t instruction_reader_read(instruction_reader_t *reader,
                                                         instruction_t *instruction) {
 
-    return reader->read_callback(reader->sender, instruction);
+    instruction_reader_read_error_t error;
+
+    TRACER_BEGIN("reader.read");
+    error = reader->read_callback(reader->sender, instruction);
+    TRACER_END("reader.read");
+    return error;
+}
+
+instruction_reader_read_error_t instruction_reader_read_many(instruction_reader_t *reader,
+                                                             instruction_t *instructions,
+                                                             size_t number_of_instructions,
+                                                             size_t *number_of_read_instructions) {
+
+    instruction_reader_read_error_t error = INSTRUCTION_READER_READ_ERROR_OK;
+    size_t index;
+
+    TRACER_BEGIN("reader.read_many");
+
+    if (reader->read_many_callback != nullptr) {
+        error = reader->read_many_callback(reader->sender, instructions, number_of_instructions,
+                                           number_of_read_instructions);
+        TRACER_END("reader.read_many");
+        return error;
+    }
+
+    for (index = 0; index < number_of_instructions; ++index) {
+        error = reader->read_callback(reader->sender, &instructions[index]);
+        if (error != INSTRUCTION_READER_READ_ERROR_OK) {
+            break;
+        }
+    }
+
+    *number_of_read_instructions = index;
+    TRACER_END("reader.read_many");
+    return error;
 }
 
 void instruction_reader_seek(instruction_reader_t *reader,
                              instruction_reader_offset_t offset,
                              instruction_reader_seek_mode_t mode) {
 
+    TRACER_BEGIN("reader.seek");
     reader->seek_callback(reader->sender, offset, mode);
+    TRACER_END("reader.seek");
 }
 
 instruction_reader_offset_t instruction_reader_tell(instruction_reader_t *reader) {
-    return reader->tell_callback(reader->sender);
+    instruction_reader_offset_t offset;
+
+    TRACER_BEGIN("reader.tell");
+    offset = reader->tell_callback(reader->sender);
+    TRACER_END("reader.tell");
+    return offset;
 }
@@ -10,9 +10,10 @@
 #ifndef ZODIAC_INSTRUCTION_READER_H
 #define ZODIAC_INSTRUCTION_READER_H
 
-#include "instruction_reader_read_callback.h"  // Callback for the read operation.
-#include "instruction_reader_seek_callback.h"  // Callback for the seek operation.
-#include "instruction_reader_tell_callback.h"  // Callback for the tell operation.
+#include "instruction_reader_read_callback.h"       // Callback for the read operation.
+#include "instruction_reader_read_many_callback.h"  // Callback for the batch read operation.
+#include "instruction_reader_seek_callback.h"       // Callback for the seek operation.
+#include "instruction_reader_tell_callback.h"       // Callback for the tell operation.
 
 /**
  * @struct instruction_reader_s
@@ -24,10 +25,11 @@
  * reporting of the current reading position within the stream of instructions.
  */
 typedef struct instruction_reader_s {
-    callback_sender sender;                           ///< Context object for the callbacks.
-    instruction_reader_read_callback_t read_callback; ///< Callback function for reading instructions.
-    instruction_reader_seek_callback_t seek_callback; ///< Callback function for seeking in the instruction stream.
-    instruction_reader_tell_callback_t tell_callback; ///< Callback function for reporting the current position.
+    callback_sender sender;                                     ///< Context object for the callbacks.
+    instruction_reader_read_callback_t read_callback;           ///< Callback function for reading instructions.
+    instruction_reader_seek_callback_t seek_callback;           ///< Callback function for seeking in the instruction stream.
+    instruction_reader_tell_callback_t tell_callback;           ///< Callback function for reporting the current position.
+    instruction_reader_read_many_callback_t read_many_callback; ///< Optional callback for reading batches of instructions.
 } instruction_reader_t;
 
 /**
@@ -35,7 +37,8 @@ typedef struct instruction_reader_s {
  *
  * Sets up an instruction reader by attaching the provided context and callbacks for read, seek,
  * and tell operations. This allows the reader to perform these operations when interacting with
- * an instruction stream.
+ * an instruction stream. The optional batch read callback is left unset, see
+ * instruction_reader_set_read_many_callback().
  *
  * @param[out] reader Pointer to the instruction reader structure to initialize.
  * @param[in] sender The context to pass to the callbacks.
@@ -61,6 +64,32 @@ void instruction_reader_init(instruction_reader_t *reader,
 instruction_reader_read_error_t instruction_reader_read(instruction_reader_t *reader,
                                                         instruction_t *instruction);
 
+/**
+ * @brief Attaches the optional batch read callback to an instruction reader.
+ *
+ * @param[in,out] reader Pointer to the instruction reader.
+ * @param[in] read_many_callback The function to call for reading batches of instructions, or nullptr.
+ */
+void instruction_reader_set_read_many_callback(instruction_reader_t *reader,
+                                               instruction_reader_read_many_callback_t read_many_callback);
+
+/**
+ * @brief Reads a batch of instructions.
+ *
+ * Invokes the reader's batch read callback when one is attached, otherwise falls back to
+ * calling the read callback once per instruction.
+ *
+ * @param[in] reader Pointer to the instruction reader from which to read.
+ * @param[out] instructions Array receiving the read instructions.
+ * @param[in] number_of_instructions Number of elements in the array.
+ * @param[out] number_of_read_instructions Number of instructions actually read.
+ * @return INSTRUCTION_READER_READ_ERROR_OK if the whole batch was read, otherwise the error that stopped it.
+ */
+instruction_reader_read_error_t instruction_reader_read_many(instruction_reader_t *reader,
+                                                             instruction_t *instructions,
+                                                             size_t number_of_instructions,
+                                                             size_t *number_of_read_instructions);
+
 /**
  * @brief Seeks within the instruction stream using the reader's seek callback.
  *
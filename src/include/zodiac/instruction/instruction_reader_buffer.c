@@ -0,0 +1,64 @@
+#include "instruction_reader_buffer.h"
+
+#include <string.h>
+
+void instruction_reader_buffer_init(instruction_reader_buffer_t *buffer, const void *data, size_t size) {
+    buffer->data = data;
+    buffer->size = data != nullptr ? size : 0;
+    buffer->position = 0;
+}
+
+void instruction_reader_init_buffer(instruction_reader_t *reader, instruction_reader_buffer_t *buffer) {
+    instruction_reader_init(reader, buffer,
+                            instruction_reader_buffer_read,
+                            instruction_reader_buffer_seek,
+                            instruction_reader_buffer_tell);
+
+    instruction_reader_set_read_many_callback(reader, instruction_reader_buffer_read_many);
+}
+
+instruction_reader_read_error_t instruction_reader_buffer_read(callback_sender sender, instruction_t *instruction) {
+    instruction_view_t view;
+    instruction_reader_read_error_t error = instruction_reader_buffer_view(sender, &view);
+
+    if (error == INSTRUCTION_READER_READ_ERROR_OK) {
+        instruction->header = *view.header;
+        memcpy(instruction->operands, view.operands, view.header->number_of_operands);
+    }
+
+    return error;
+}
+
+instruction_reader_read_error_t instruction_reader_buffer_read_many(callback_sender sender,
+                                                                    instruction_t *instructions,
+                                                                    size_t number_of_instructions,
+                                                                    size_t *number_of_read_instructions) {
+
+    instruction_reader_read_error_t error = INSTRUCTION_READER_READ_ERROR_OK;
+    instruction_view_t view;
+    size_t index;
+
+    for (index = 0; index < number_of_instructions; ++index) {
+        error = instruction_reader_buffer_view(sender, &view);
+        if (error != INSTRUCTION_READER_READ_ERROR_OK) {
+            break;
+        }
+
+        instructions[index].header = *view.header;
+        memcpy(instructions[index].operands, view.operands, view.header->number_of_operands);
+    }
+
+    *number_of_read_instructions = index;
+    return error;
+}
+
+void instruction_reader_buffer_seek(callback_sender sender,
+                                    instruction_reader_offset_t offset,
+                                    instruction_reader_seek_mode_t mode) {
+
+    instruction_reader_buffer_move(sender, offset, mode);
+}
+
+instruction_reader_offset_t instruction_reader_buffer_tell(callback_sender sender) {
+    return instruction_reader_buffer_position(sender);
+}
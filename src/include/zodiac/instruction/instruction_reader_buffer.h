@@ -0,0 +1,131 @@
+/**
+ * @file instruction_reader_buffer.h
+ * @brief Defines an instruction reader over a byte buffer already resident in memory.
+ *
+ * Intended for embedded and test use where the program is at hand as a plain sequence of
+ * instructions in the packed format described in instruction_packed.h. The buffer is
+ * neither copied nor owned by the reader.
+ *
+ * Besides the callbacks used by instruction_reader_t, the cursor operations are available
+ * as forced inline functions. Code that knows it reads from a buffer calls them directly
+ * and so avoids the indirect calls of the generic reader, and receives views into the
+ * buffer instead of copies of the operands. The specialized variants of the generic
+ * functions are defined as well, see instruction_reader_specialize.h.
+ */
+
+#ifndef ZODIAC_INSTRUCTION_READER_BUFFER_H
+#define ZODIAC_INSTRUCTION_READER_BUFFER_H
+
+#include "instruction_packed.h"              // Packed instruction accessors.
+#include "instruction_reader.h"              // Generic instruction reader.
+#include "instruction_reader_specialize.h"   // Specialized reader functions.
+
+/**
+ * @struct instruction_reader_buffer_s
+ * @brief Structure that holds the buffer being read and the current read position.
+ */
+typedef struct instruction_reader_buffer_s {
+    const uint8_t *data;  ///< Start of the buffer, may be nullptr for an empty buffer.
+    size_t size;          ///< Size of the buffer in bytes.
+    size_t position;      ///< Offset of the next instruction to read.
+} instruction_reader_buffer_t;
+
+/**
+ * @brief Initializes the reader state over a buffer.
+ *
+ * @param[out] buffer Pointer to the reader state to initialize.
+ * @param[in] data Start of the packed instructions, which must outlive the reader.
+ * @param[in] size Number of bytes at `data`.
+ */
+void instruction_reader_buffer_init(instruction_reader_buffer_t *buffer, const void *data, size_t size);
+
+/**
+ * @brief Initializes an instruction reader that reads from a buffer.
+ *
+ * @param[out] reader Pointer to the instruction reader structure to initialize.
+ * @param[in] buffer The initialized reader state used as the callback context.
+ */
+void instruction_reader_init_buffer(instruction_reader_t *reader, instruction_reader_buffer_t *buffer);
+
+/**
+ * @brief Returns a view of the next instruction and advances past it.
+ *
+ * The view is checked against the bounds of the buffer, a truncated instruction is
+ * reported and leaves the position unchanged.
+ *
+ * @param[in,out] buffer Pointer to the reader state.
+ * @param[out] view The view to fill with pointers into the buffer.
+ * @return instruction_reader_read_error_t Error code resulting from the read operation.
+ */
+ZDC_STATIC ZDC_FORCE_INLINE instruction_reader_read_error_t instruction_reader_buffer_view(instruction_reader_buffer_t *buffer,
+                                                                                          instruction_view_t *view) {
+
+    instruction_reader_read_error_t error = instruction_packed_decode(buffer->data, buffer->size,
+                                                                      buffer->position, view);
+
+    if (error == INSTRUCTION_READER_READ_ERROR_OK) {
+        buffer->position += instruction_packed_size(view->header);
+    }
+
+    return error;
+}
+
+/**
+ * @brief Moves the read position, clamped to the bounds of the buffer.
+ *
+ * @param[in,out] buffer Pointer to the reader state.
+ * @param[in] offset Offset to apply from the seek mode's starting point.
+ * @param[in] mode The seek mode defining the starting point for the offset.
+ */
+ZDC_STATIC ZDC_FORCE_INLINE void instruction_reader_buffer_move(instruction_reader_buffer_t *buffer,
+                                                               instruction_reader_offset_t offset,
+                                                               instruction_reader_seek_mode_t mode) {
+
+    buffer->position = instruction_packed_seek(buffer->position, buffer->size, offset, mode);
+}
+
+/**
+ * @brief Returns the read position.
+ *
+ * @param[in] buffer Pointer to the reader state.
+ * @return The offset of the next instruction to read.
+ */
+ZDC_STATIC ZDC_FORCE_INLINE instruction_reader_offset_t instruction_reader_buffer_position(const instruction_reader_buffer_t *buffer) {
+    return (instruction_reader_offset_t) buffer->position;
+}
+
+/**
+ * @brief Read callback copying the next instruction out of the buffer.
+ * @see instruction_reader_read_callback_t
+ */
+instruction_reader_read_error_t instruction_reader_buffer_read(callback_sender sender, instruction_t *instruction);
+
+/**
+ * @brief Batch read callback copying consecutive instructions out of the buffer.
+ * @see instruction_reader_read_many_callback_t
+ */
+instruction_reader_read_error_t instruction_reader_buffer_read_many(callback_sender sender,
+                                                                    instruction_t *instructions,
+                                                                    size_t number_of_instructions,
+                                                                    size_t *number_of_read_instructions);
+
+/**
+ * @brief Seek callback moving the read position within the buffer.
+ *
+ * The resulting position is clamped to the bounds of the buffer.
+ *
+ * @see instruction_reader_seek_callback_t
+ */
+void instruction_reader_buffer_seek(callback_sender sender,
+                                    instruction_reader_offset_t offset,
+                                    instruction_reader_seek_mode_t mode);
+
+/**
+ * @brief Tell callback reporting the read position within the buffer.
+ * @see instruction_reader_tell_callback_t
+ */
+instruction_reader_offset_t instruction_reader_buffer_tell(callback_sender sender);
+
+INSTRUCTION_READER_SPECIALIZE(buffer, instruction_reader_buffer_t)
+
+#endif // ZODIAC_INSTRUCTION_READER_BUFFER_H
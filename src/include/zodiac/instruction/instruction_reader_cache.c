@@ -0,0 +1,145 @@
+#include "instruction_reader_cache.h"
+
+#include <string.h>
+
+/**
+ * @brief Returns the entry an offset maps to.
+ *
+ * Offsets are spread with a multiplicative hash, since the offsets of consecutive
+ * instructions are close to each other.
+ */
+static instruction_reader_cache_entry_t *instruction_reader_cache_entry(const instruction_reader_cache_t *cache,
+                                                                        instruction_reader_offset_t offset) {
+
+    return &cache->entries[((uint64_t) offset * UINT64_C(0x9E3779B97F4A7C15)) >> cache->shift];
+}
+
+instruction_reader_cache_error_t instruction_reader_cache_init(instruction_reader_cache_t *cache,
+                                                               instruction_reader_t *source,
+                                                               size_t capacity,
+                                                               const platform_allocator_t *allocator) {
+
+    size_t number_of_entries = 2;
+    unsigned int bits = 1;
+
+    if (capacity == 0) {
+        capacity = INSTRUCTION_READER_CACHE_DEFAULT_CAPACITY;
+    }
+
+    while (number_of_entries < capacity) {
+        number_of_entries <<= 1;
+        ++bits;
+    }
+
+    cache->entries = platform_memory_allocate(allocator, number_of_entries * sizeof(instruction_reader_cache_entry_t));
+    if (cache->entries == nullptr) {
+        return INSTRUCTION_READER_CACHE_ERROR_MEMORY;
+    }
+
+    cache->source = source;
+    cache->shift = 64 - bits;
+    cache->allocator = allocator;
+    cache->position = instruction_reader_tell(source);
+    cache->source_position = cache->position;
+    cache->number_of_hits = 0;
+    cache->number_of_misses = 0;
+
+    instruction_reader_cache_invalidate(cache);
+    return INSTRUCTION_READER_CACHE_ERROR_OK;
+}
+
+void instruction_reader_cache_free(instruction_reader_cache_t *cache) {
+    platform_memory_release(cache->allocator, cache->entries);
+    cache->entries = nullptr;
+}
+
+void instruction_reader_cache_invalidate(instruction_reader_cache_t *cache) {
+    size_t number_of_entries = (size_t) 1 << (64 - cache->shift);
+
+    for (size_t index = 0; index < number_of_entries; ++index) {
+        cache->entries[index].offset = -1;
+    }
+
+    cache->size = -1;
+}
+
+void instruction_reader_init_cache(instruction_reader_t *reader, instruction_reader_cache_t *cache) {
+    instruction_reader_init(reader, cache,
+                            instruction_reader_cache_read,
+                            instruction_reader_cache_seek,
+                            instruction_reader_cache_tell);
+}
+
+instruction_reader_read_error_t instruction_reader_cache_read(callback_sender sender, instruction_t *instruction) {
+    instruction_reader_cache_t *cache = sender;
+    instruction_reader_cache_entry_t *entry = instruction_reader_cache_entry(cache, cache->position);
+    instruction_reader_read_error_t read_error;
+
+    if (entry->offset == cache->position) {
+        instruction->header = entry->instruction.header;
+        memcpy(instruction->operands, entry->instruction.operands, entry->instruction.header.number_of_operands);
+
+        cache->position = entry->next_offset;
+        ++cache->number_of_hits;
+        return INSTRUCTION_READER_READ_ERROR_OK;
+    }
+
+    ++cache->number_of_misses;
+
+    if (cache->source_position != cache->position) {
+        instruction_reader_seek(cache->source, cache->position, INSTRUCTION_READER_SEEK_SET);
+    }
+
+    read_error = instruction_reader_read(cache->source, instruction);
+    cache->source_position = instruction_reader_tell(cache->source);
+
+    if (read_error == INSTRUCTION_READER_READ_ERROR_END && (cache->size < 0 || cache->position < cache->size)) {
+        cache->size = cache->position;
+    }
+
+    if (read_error != INSTRUCTION_READER_READ_ERROR_OK) {
+        return read_error;
+    }
+
+    entry->offset = cache->position;
+    entry->next_offset = cache->source_position;
+    entry->instruction.header = instruction->header;
+    memcpy(entry->instruction.operands, instruction->operands, instruction->header.number_of_operands);
+
+    cache->position = cache->source_position;
+    return INSTRUCTION_READER_READ_ERROR_OK;
+}
+
+void instruction_reader_cache_seek(callback_sender sender,
+                                   instruction_reader_offset_t offset,
+                                   instruction_reader_seek_mode_t mode) {
+
+    instruction_reader_cache_t *cache = sender;
+
+    switch (mode) {
+        case INSTRUCTION_READER_SEEK_END:
+            instruction_reader_seek(cache->source, offset, mode);
+            cache->source_position = instruction_reader_tell(cache->source);
+            cache->position = cache->source_position;
+            return;
+        case INSTRUCTION_READER_SEEK_CUR:
+            offset += cache->position;
+            break;
+        default:
+            break;
+    }
+
+    // Probing the size would seek the source, which fails for good on pipes.
+    if (offset < 0) {
+        offset = 0;
+    } else if (cache->size >= 0 && offset > cache->size) {
+        offset = cache->size;
+    }
+
+    cache->position = offset;
+}
+
+instruction_reader_offset_t instruction_reader_cache_tell(callback_sender sender) {
+    const instruction_reader_cache_t *cache = sender;
+    return cache->position;
+}
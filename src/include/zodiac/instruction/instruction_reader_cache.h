@@ -0,0 +1,123 @@
+/**
+ * @file instruction_reader_cache.h
+ * @brief Defines a caching layer wrapped around any instruction reader.
+ *
+ * The cache keeps the instructions already decoded from a source reader in a
+ * direct-mapped table keyed by their offset. Reading an instruction the program has
+ * visited before, typically after a backward seek of a loop or a call, is served from
+ * the table without touching the source. Only misses read from the source, which is
+ * then sought to the requested offset first, so seeking the cache is cheap as well.
+ *
+ * Sources must not change while they are cached; call instruction_reader_cache_invalidate()
+ * otherwise.
+ */
+
+#ifndef ZODIAC_INSTRUCTION_READER_CACHE_H
+#define ZODIAC_INSTRUCTION_READER_CACHE_H
+
+#include "instruction_reader.h"             // Generic instruction reader.
+#include "../platform/platform_memory.h"    // Source of the memory of the table.
+
+/**
+ * @brief Default number of entries of the table.
+ */
+#define INSTRUCTION_READER_CACHE_DEFAULT_CAPACITY 1024
+
+/**
+ * @enum instruction_reader_cache_error_e
+ * @brief Enumerates possible errors that can occur when creating a cache.
+ */
+typedef enum instruction_reader_cache_error_e {
+    INSTRUCTION_READER_CACHE_ERROR_OK,      ///< No error occurred, the cache is ready.
+    INSTRUCTION_READER_CACHE_ERROR_MEMORY   ///< The table could not be allocated.
+} instruction_reader_cache_error_t;
+
+/**
+ * @struct instruction_reader_cache_entry_s
+ * @brief Structure that holds a cached instruction.
+ */
+typedef struct instruction_reader_cache_entry_s {
+    instruction_reader_offset_t offset;        ///< Offset of the instruction, negative for an empty entry.
+    instruction_reader_offset_t next_offset;   ///< Offset of the instruction following it.
+    instruction_t instruction;                 ///< The decoded instruction.
+} instruction_reader_cache_entry_t;
+
+/**
+ * @struct instruction_reader_cache_s
+ * @brief Structure that holds the table of a cache and its position.
+ */
+typedef struct instruction_reader_cache_s {
+    instruction_reader_t *source;                  ///< The cached reader.
+    instruction_reader_cache_entry_t *entries;     ///< The direct-mapped table.
+    unsigned int shift;                            ///< Shift reducing a hashed offset to an entry index.
+    instruction_reader_offset_t position;          ///< Offset of the next instruction to read.
+    instruction_reader_offset_t source_position;   ///< Position of the source reader.
+    instruction_reader_offset_t size;              ///< End of the source once a read reached it, negative before.
+    uint64_t number_of_hits;                       ///< Number of reads served from the table.
+    uint64_t number_of_misses;                     ///< Number of reads served by the source.
+    const platform_allocator_t *allocator;         ///< Source of the memory of the table.
+} instruction_reader_cache_t;
+
+/**
+ * @brief Creates a cache in front of a source reader, starting at the position of the source.
+ *
+ * @param[out] cache Pointer to the cache to initialize.
+ * @param[in,out] source The reader to cache, which must outlive the cache.
+ * @param[in] capacity Number of entries, rounded up to a power of two, or 0 for the default.
+ * @param[in] allocator The allocator of the table, or nullptr for the default allocator.
+ * @return instruction_reader_cache_error_t Error code resulting from the operation.
+ */
+instruction_reader_cache_error_t instruction_reader_cache_init(instruction_reader_cache_t *cache,
+                                                               instruction_reader_t *source,
+                                                               size_t capacity,
+                                                               const platform_allocator_t *allocator);
+
+/**
+ * @brief Releases the table of a cache.
+ *
+ * @param[in,out] cache Pointer to the cache.
+ */
+void instruction_reader_cache_free(instruction_reader_cache_t *cache);
+
+/**
+ * @brief Empties the table of a cache and forgets the end of the source.
+ *
+ * @param[in,out] cache Pointer to the cache.
+ */
+void instruction_reader_cache_invalidate(instruction_reader_cache_t *cache);
+
+/**
+ * @brief Initializes an instruction reader that reads through a cache.
+ *
+ * @param[out] reader Pointer to the instruction reader structure to initialize.
+ * @param[in] cache The cache used as the callback context.
+ */
+void instruction_reader_init_cache(instruction_reader_t *reader, instruction_reader_cache_t *cache);
+
+/**
+ * @brief Read callback serving the next instruction from the table or the source.
+ * @see instruction_reader_read_callback_t
+ */
+instruction_reader_read_error_t instruction_reader_cache_read(callback_sender sender, instruction_t *instruction);
+
+/**
+ * @brief Seek callback moving the position of the cache.
+ *
+ * Seeking from the start or the current position is deferred to the next miss and
+ * clamped at 0, and at the end of the source once a read has reached it; the source is
+ * never sought to learn its size, which would break pipes. Seeking from the end is
+ * forwarded to the source.
+ *
+ * @see instruction_reader_seek_callback_t
+ */
+void instruction_reader_cache_seek(callback_sender sender,
+                                   instruction_reader_offset_t offset,
+                                   instruction_reader_seek_mode_t mode);
+
+/**
+ * @brief Tell callback reporting the position of the cache.
+ * @see instruction_reader_tell_callback_t
+ */
+instruction_reader_offset_t instruction_reader_cache_tell(callback_sender sender);
+
+#endif // ZODIAC_INSTRUCTION_READER_CACHE_H
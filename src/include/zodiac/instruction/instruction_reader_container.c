@@ -0,0 +1,297 @@
+#include "instruction_reader_container.h"
+#include "instruction_packed.h"
+#include "../platform/platform_memory.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief Reads exactly the given number of bytes at an offset of the container.
+ */
+static bool instruction_reader_container_pread(const instruction_reader_container_t *container,
+                                               void *data, size_t size, uint64_t offset) {
+
+    uint8_t *cursor = data;
+    ssize_t received;
+
+    while (size != 0) {
+        received = pread(container->fd, cursor, size, (off_t) (container->origin + offset));
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (received <= 0) {
+            return false;
+        }
+
+        cursor += received;
+        offset += (uint64_t) received;
+        size -= (size_t) received;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Loads a value of the given number of bytes stored in little-endian byte order.
+ */
+static uint64_t instruction_reader_container_get(const uint8_t *cursor, size_t size) {
+    uint64_t value = 0;
+
+    for (size_t index = 0; index < size; ++index) {
+        value |= (uint64_t) cursor[index] << (index * 8);
+    }
+    return value;
+}
+
+/**
+ * @brief Reads the header and the block index and allocates the buffers.
+ */
+static instruction_reader_container_error_t instruction_reader_container_setup(instruction_reader_container_t *container,
+                                                                               int fd,
+                                                                               bool owns_fd) {
+
+    uint8_t header[INSTRUCTION_CONTAINER_HEADER_SIZE];
+    uint8_t entry[INSTRUCTION_CONTAINER_INDEX_ENTRY_SIZE];
+    size_t largest_stored_size = 0;
+    uint64_t size;
+    off_t origin;
+
+    container->fd = fd;
+    container->owns_fd = owns_fd;
+    container->failed = false;
+    container->blocks = nullptr;
+    container->block = nullptr;
+    container->compressed = nullptr;
+    container->block_index = SIZE_MAX;
+    container->block_length = 0;
+    container->position = 0;
+
+    origin = lseek(fd, 0, SEEK_CUR);
+    container->origin = origin > 0 ? (instruction_reader_offset_t) origin : 0;
+
+    if (!instruction_reader_container_pread(container, header, sizeof(header), 0)
+        || memcmp(header, INSTRUCTION_CONTAINER_MAGIC, INSTRUCTION_CONTAINER_MAGIC_SIZE) != 0) {
+        return INSTRUCTION_READER_CONTAINER_ERROR_FORMAT;
+    }
+
+    container->block_size = instruction_reader_container_get(header + 8, 4);
+    container->number_of_blocks = instruction_reader_container_get(header + 12, 4);
+    size = instruction_reader_container_get(header + 16, 8);
+
+    if (container->block_size == 0
+        || container->block_size > INSTRUCTION_CONTAINER_MAX_BLOCK_SIZE
+        || size > INT64_MAX
+        || container->number_of_blocks != (size + container->block_size - 1) / container->block_size) {
+        return INSTRUCTION_READER_CONTAINER_ERROR_FORMAT;
+    }
+
+    container->size = (instruction_reader_offset_t) size;
+
+    container->blocks = platform_memory_allocate(nullptr,
+                                                 (container->number_of_blocks + 1)
+                                                 * sizeof(instruction_container_block_t));
+    if (container->blocks == nullptr) {
+        return INSTRUCTION_READER_CONTAINER_ERROR_MEMORY;
+    }
+
+    for (size_t index = 0; index < container->number_of_blocks; ++index) {
+        instruction_container_block_t *block = &container->blocks[index];
+        uint32_t stored_size;
+
+        if (!instruction_reader_container_pread(container, entry, sizeof(entry),
+                                                INSTRUCTION_CONTAINER_HEADER_SIZE
+                                                + index * INSTRUCTION_CONTAINER_INDEX_ENTRY_SIZE)) {
+            return INSTRUCTION_READER_CONTAINER_ERROR_FORMAT;
+        }
+
+        stored_size = (uint32_t) instruction_reader_container_get(entry + 8, 4);
+
+        block->offset = instruction_reader_container_get(entry, 8);
+        block->raw = (stored_size & INSTRUCTION_CONTAINER_BLOCK_RAW) != 0;
+        block->stored_size = stored_size & ~INSTRUCTION_CONTAINER_BLOCK_RAW;
+
+        if (block->stored_size > (block->raw
+                                   ? container->block_size
+                                   : instruction_container_bound(container->block_size))) {
+            return INSTRUCTION_READER_CONTAINER_ERROR_FORMAT;
+        }
+
+        if (!block->raw && block->stored_size > largest_stored_size) {
+            largest_stored_size = block->stored_size;
+        }
+    }
+
+    container->block = platform_memory_allocate(nullptr, container->block_size);
+    container->compressed = platform_memory_allocate(nullptr, largest_stored_size + 1);
+    if (container->block == nullptr || container->compressed == nullptr) {
+        return INSTRUCTION_READER_CONTAINER_ERROR_MEMORY;
+    }
+
+    return INSTRUCTION_READER_CONTAINER_ERROR_OK;
+}
+
+/**
+ * @brief Makes the block holding the current position the current block.
+ *
+ * @return Whether the block holds unread bytes.
+ */
+static bool instruction_reader_container_load(instruction_reader_container_t *container) {
+    size_t index;
+    const instruction_container_block_t *block;
+    size_t expected_length;
+    size_t length;
+
+    if (container->position >= container->size || container->failed) {
+        return false;
+    }
+
+    index = (size_t) container->position / container->block_size;
+    if (index == container->block_index) {
+        return true;
+    }
+
+    block = &container->blocks[index];
+    expected_length = (size_t) (container->size - (instruction_reader_offset_t) (index * container->block_size));
+    if (expected_length > container->block_size) {
+        expected_length = container->block_size;
+    }
+
+    container->block_index = SIZE_MAX;
+
+    if (block->raw) {
+        length = block->stored_size;
+        if (!instruction_reader_container_pread(container, container->block, length, block->offset)) {
+            length = SIZE_MAX;
+        }
+    } else if (instruction_reader_container_pread(container, container->compressed, block->stored_size,
+                                                  block->offset)) {
+        length = instruction_container_decompress(container->compressed, block->stored_size,
+                                                  container->block, container->block_size);
+    } else {
+        length = SIZE_MAX;
+    }
+
+    if (length != expected_length) {
+        container->failed = true;
+        return false;
+    }
+
+    container->block_index = index;
+    container->block_length = length;
+    return true;
+}
+
+instruction_reader_container_error_t instruction_reader_container_open(instruction_reader_container_t *container,
+                                                                       const char *path) {
+
+    instruction_reader_container_error_t error;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        container->fd = -1;
+        container->owns_fd = false;
+        container->blocks = nullptr;
+        container->block = nullptr;
+        container->compressed = nullptr;
+        return INSTRUCTION_READER_CONTAINER_ERROR_OPEN;
+    }
+
+    error = instruction_reader_container_setup(container, fd, true);
+    if (error != INSTRUCTION_READER_CONTAINER_ERROR_OK) {
+        instruction_reader_container_close(container);
+    }
+
+    return error;
+}
+
+instruction_reader_container_error_t instruction_reader_container_attach(instruction_reader_container_t *container,
+                                                                         int fd) {
+
+    instruction_reader_container_error_t error = instruction_reader_container_setup(container, fd, false);
+
+    if (error != INSTRUCTION_READER_CONTAINER_ERROR_OK) {
+        instruction_reader_container_close(container);
+    }
+
+    return error;
+}
+
+void instruction_reader_container_close(instruction_reader_container_t *container) {
+    if (container->owns_fd && container->fd >= 0) {
+        close(container->fd);
+    }
+
+    platform_memory_release(nullptr, container->blocks);
+    platform_memory_release(nullptr, container->block);
+    platform_memory_release(nullptr, container->compressed);
+    container->blocks = nullptr;
+    container->block = nullptr;
+    container->compressed = nullptr;
+    container->fd = -1;
+    container->owns_fd = false;
+}
+
+void instruction_reader_init_container(instruction_reader_t *reader, instruction_reader_container_t *container) {
+    instruction_reader_init(reader, container,
+                            instruction_reader_container_read,
+                            instruction_reader_container_seek,
+                            instruction_reader_container_tell);
+}
+
+size_t instruction_reader_container_copy(instruction_reader_container_t *container, void *data, size_t size) {
+    uint8_t *cursor = data;
+    size_t copied = 0;
+
+    while (copied < size && instruction_reader_container_load(container)) {
+        size_t start = (size_t) container->position - container->block_index * container->block_size;
+        size_t length = container->block_length - start;
+
+        if (length > size - copied) {
+            length = size - copied;
+        }
+
+        memcpy(cursor + copied, container->block + start, length);
+        copied += length;
+        container->position += (instruction_reader_offset_t) length;
+    }
+
+    return copied;
+}
+
+instruction_reader_read_error_t instruction_reader_container_read(callback_sender sender, instruction_t *instruction) {
+    instruction_reader_container_t *container = sender;
+    size_t copied = instruction_reader_container_copy(container, &instruction->header, sizeof(instruction_header_t));
+
+    if (copied != sizeof(instruction_header_t)) {
+        return copied == 0 && !container->failed
+               ? INSTRUCTION_READER_READ_ERROR_END
+               : INSTRUCTION_READER_READ_ERROR_HEADER;
+    }
+
+    if (instruction_reader_container_copy(container, instruction->operands, instruction->header.number_of_operands)
+        != instruction->header.number_of_operands) {
+        return INSTRUCTION_READER_READ_ERROR_OPERANDS;
+    }
+
+    return INSTRUCTION_READER_READ_ERROR_OK;
+}
+
+void instruction_reader_container_seek(callback_sender sender,
+                                       instruction_reader_offset_t offset,
+                                       instruction_reader_seek_mode_t mode) {
+
+    instruction_reader_container_t *container = sender;
+
+    container->position = (instruction_reader_offset_t) instruction_packed_seek((size_t) container->position,
+                                                                                (size_t) container->size,
+                                                                                offset, mode);
+    container->failed = false;
+}
+
+instruction_reader_offset_t instruction_reader_container_tell(callback_sender sender) {
+    const instruction_reader_container_t *container = sender;
+    return container->position;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file instruction_reader_container.h
+ * @brief Defines an instruction reader decompressing a program container on the fly.
+ *
+ * The reader loads the block index of a container (see instruction_container.h) when it
+ * is opened and afterwards keeps a single decompressed block in memory. Offsets seen by
+ * seek and tell are offsets of the uncompressed instruction stream; reading at any offset
+ * decompresses only the block holding it, fetched with pread(), so random access never
+ * decompresses the container from its start.
+ */
+
+#ifndef ZODIAC_INSTRUCTION_READER_CONTAINER_H
+#define ZODIAC_INSTRUCTION_READER_CONTAINER_H
+
+#include "instruction_container.h"  // Container format.
+#include "instruction_reader.h"     // Generic instruction reader.
+
+/**
+ * @enum instruction_reader_container_error_e
+ * @brief Enumerates possible errors that can occur when opening a container.
+ */
+typedef enum instruction_reader_container_error_e {
+    INSTRUCTION_READER_CONTAINER_ERROR_OK,       ///< No error occurred, the container is ready.
+    INSTRUCTION_READER_CONTAINER_ERROR_OPEN,     ///< The file could not be opened.
+    INSTRUCTION_READER_CONTAINER_ERROR_FORMAT,   ///< The file is not a container or its index is corrupt.
+    INSTRUCTION_READER_CONTAINER_ERROR_MEMORY    ///< The index or the buffers could not be allocated.
+} instruction_reader_container_error_t;
+
+/**
+ * @struct instruction_reader_container_s
+ * @brief Structure that holds the block index, the current block and the read position.
+ */
+typedef struct instruction_reader_container_s {
+    int fd;                                    ///< The file descriptor of the container.
+    bool owns_fd;                              ///< Whether the descriptor is closed by the reader.
+    bool failed;                               ///< Whether fetching or decompressing a block failed.
+    size_t block_size;                         ///< Uncompressed size of a block.
+    size_t number_of_blocks;                   ///< Number of blocks of the container.
+    instruction_container_block_t *blocks;     ///< The block index.
+    uint8_t *block;                            ///< The current block, decompressed.
+    uint8_t *compressed;                       ///< Stored bytes of the block being fetched.
+    size_t block_index;                        ///< Index of the current block, SIZE_MAX if none.
+    size_t block_length;                       ///< Number of bytes of the current block.
+    instruction_reader_offset_t size;          ///< Size of the uncompressed stream.
+    instruction_reader_offset_t position;      ///< Offset of the next instruction to read.
+    instruction_reader_offset_t origin;        ///< Position of the descriptor where the container starts.
+} instruction_reader_container_t;
+
+/**
+ * @brief Opens a container file.
+ *
+ * @param[out] container Pointer to the reader state to initialize.
+ * @param[in] path Path of the container file.
+ * @return instruction_reader_container_error_t Error code resulting from the operation.
+ */
+instruction_reader_container_error_t instruction_reader_container_open(instruction_reader_container_t *container,
+                                                                       const char *path);
+
+/**
+ * @brief Reads a container starting at the current position of a descriptor.
+ *
+ * The descriptor must support pread() and stays open when the reader is closed.
+ *
+ * @param[out] container Pointer to the reader state to initialize.
+ * @param[in] fd The file descriptor to read from.
+ * @return instruction_reader_container_error_t Error code resulting from the operation.
+ */
+instruction_reader_container_error_t instruction_reader_container_attach(instruction_reader_container_t *container,
+                                                                         int fd);
+
+/**
+ * @brief Releases the index and the buffers and closes an owned descriptor.
+ *
+ * @param[in,out] container Pointer to the reader state.
+ */
+void instruction_reader_container_close(instruction_reader_container_t *container);
+
+/**
+ * @brief Initializes an instruction reader that reads from a container.
+ *
+ * @param[out] reader Pointer to the instruction reader structure to initialize.
+ * @param[in] container The reader state used as the callback context.
+ */
+void instruction_reader_init_container(instruction_reader_t *reader, instruction_reader_container_t *container);
+
+/**
+ * @brief Copies bytes of the uncompressed stream and advances the position past them.
+ *
+ * @param[in,out] container Pointer to the reader state.
+ * @param[out] data Receives the bytes.
+ * @param[in] size Number of bytes to copy.
+ * @return Number of bytes copied, smaller than `size` at the end of the stream or on failure.
+ */
+size_t instruction_reader_container_copy(instruction_reader_container_t *container, void *data, size_t size);
+
+/**
+ * @brief Read callback decoding the next instruction of the container.
+ * @see instruction_reader_read_callback_t
+ */
+instruction_reader_read_error_t instruction_reader_container_read(callback_sender sender, instruction_t *instruction);
+
+/**
+ * @brief Seek callback moving the position within the uncompressed stream.
+ * @see instruction_reader_seek_callback_t
+ */
+void instruction_reader_container_seek(callback_sender sender,
+                                       instruction_reader_offset_t offset,
+                                       instruction_reader_seek_mode_t mode);
+
+/**
+ * @brief Tell callback reporting the position within the uncompressed stream.
+ * @see instruction_reader_tell_callback_t
+ */
+instruction_reader_offset_t instruction_reader_container_tell(callback_sender sender);
+
+#endif // ZODIAC_INSTRUCTION_READER_CONTAINER_H
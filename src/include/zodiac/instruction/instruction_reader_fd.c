@@ -0,0 +1,247 @@
+#include "instruction_reader_fd.h"
+#include "../platform/platform_memory.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief Makes at least `required` unread bytes available in the buffer.
+ *
+ * The unread bytes are moved to the front of the buffer and the remainder is filled
+ * from the descriptor, requesting at most `read_ahead` bytes per read() call.
+ *
+ * @return Whether the requested number of bytes is available.
+ */
+static bool instruction_reader_fd_fill(instruction_reader_fd_t *fd_reader, size_t required) {
+    size_t available = fd_reader->end - fd_reader->start;
+    size_t requested;
+    ssize_t received;
+
+    if (available >= required) {
+        return true;
+    }
+
+    if (fd_reader->end_of_file || fd_reader->failed) {
+        return false;
+    }
+
+    memmove(fd_reader->buffer, fd_reader->buffer + fd_reader->start, available);
+    fd_reader->buffer_offset += (instruction_reader_offset_t) fd_reader->start;
+    fd_reader->start = 0;
+    fd_reader->end = available;
+
+    while (fd_reader->end < required) {
+        requested = fd_reader->buffer_size - fd_reader->end;
+        if (requested > fd_reader->read_ahead) {
+            requested = fd_reader->read_ahead;
+        }
+
+        received = read(fd_reader->fd, fd_reader->buffer + fd_reader->end, requested);
+        if (received < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            fd_reader->failed = true;
+            return false;
+        }
+
+        if (received == 0) {
+            fd_reader->end_of_file = true;
+            return false;
+        }
+
+        fd_reader->end += (size_t) received;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Fills the reader state for the given descriptor and allocates the buffer.
+ */
+static instruction_reader_fd_error_t instruction_reader_fd_setup(instruction_reader_fd_t *fd_reader,
+                                                                 int fd,
+                                                                 bool owns_fd,
+                                                                 const instruction_reader_fd_options_t *options) {
+
+    instruction_reader_fd_options_t defaults;
+    off_t origin;
+
+    if (options == nullptr) {
+        instruction_reader_fd_options_init(&defaults);
+        options = &defaults;
+    }
+
+    fd_reader->fd = fd;
+    fd_reader->owns_fd = owns_fd;
+    fd_reader->end_of_file = false;
+    fd_reader->failed = false;
+    fd_reader->buffer_size = options->buffer_size > INSTRUCTION_READER_FD_MIN_BUFFER_SIZE
+                             ? options->buffer_size
+                             : INSTRUCTION_READER_FD_MIN_BUFFER_SIZE;
+    fd_reader->read_ahead = options->read_ahead != 0 ? options->read_ahead : fd_reader->buffer_size;
+    fd_reader->start = 0;
+    fd_reader->end = 0;
+    fd_reader->buffer_offset = 0;
+
+    origin = lseek(fd, 0, SEEK_CUR);
+    fd_reader->origin = origin > 0 ? (instruction_reader_offset_t) origin : 0;
+
+    fd_reader->buffer = platform_memory_allocate(nullptr, fd_reader->buffer_size);
+    if (fd_reader->buffer == nullptr) {
+        return INSTRUCTION_READER_FD_ERROR_MEMORY;
+    }
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    return INSTRUCTION_READER_FD_ERROR_OK;
+}
+
+void instruction_reader_fd_options_init(instruction_reader_fd_options_t *options) {
+    options->buffer_size = INSTRUCTION_READER_FD_DEFAULT_BUFFER_SIZE;
+    options->read_ahead = 0;
+}
+
+instruction_reader_fd_error_t instruction_reader_fd_open(instruction_reader_fd_t *fd_reader,
+                                                         const char *path,
+                                                         const instruction_reader_fd_options_t *options) {
+
+    instruction_reader_fd_error_t error;
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        fd_reader->buffer = nullptr;
+        fd_reader->fd = -1;
+        fd_reader->owns_fd = false;
+        return INSTRUCTION_READER_FD_ERROR_OPEN;
+    }
+
+    error = instruction_reader_fd_setup(fd_reader, fd, true, options);
+    if (error != INSTRUCTION_READER_FD_ERROR_OK) {
+        instruction_reader_fd_close(fd_reader);
+    }
+
+    return error;
+}
+
+instruction_reader_fd_error_t instruction_reader_fd_attach(instruction_reader_fd_t *fd_reader,
+                                                           int fd,
+                                                           const instruction_reader_fd_options_t *options) {
+
+    return instruction_reader_fd_setup(fd_reader, fd, false, options);
+}
+
+void instruction_reader_fd_close(instruction_reader_fd_t *fd_reader) {
+    if (fd_reader->owns_fd && fd_reader->fd >= 0) {
+        close(fd_reader->fd);
+    }
+
+    platform_memory_release(nullptr, fd_reader->buffer);
+    fd_reader->buffer = nullptr;
+    fd_reader->fd = -1;
+    fd_reader->owns_fd = false;
+}
+
+void instruction_reader_init_fd(instruction_reader_t *reader, instruction_reader_fd_t *fd_reader) {
+    instruction_reader_init(reader, fd_reader,
+                            instruction_reader_fd_read,
+                            instruction_reader_fd_seek,
+                            instruction_reader_fd_tell);
+
+    instruction_reader_set_read_many_callback(reader, instruction_reader_fd_read_many);
+}
+
+instruction_reader_read_error_t instruction_reader_fd_read(callback_sender sender, instruction_t *instruction) {
+    instruction_reader_fd_t *fd_reader = sender;
+    const uint8_t *data;
+
+    if (!instruction_reader_fd_fill(fd_reader, sizeof(instruction_header_t))) {
+        return fd_reader->start == fd_reader->end && !fd_reader->failed
+               ? INSTRUCTION_READER_READ_ERROR_END
+               : INSTRUCTION_READER_READ_ERROR_HEADER;
+    }
+
+    memcpy(&instruction->header, fd_reader->buffer + fd_reader->start, sizeof(instruction_header_t));
+    if (!instruction_reader_fd_fill(fd_reader, instruction_packed_size(&instruction->header))) {
+        return INSTRUCTION_READER_READ_ERROR_OPERANDS;
+    }
+
+    data = fd_reader->buffer + fd_reader->start;
+    memcpy(instruction->operands, data + sizeof(instruction_header_t), instruction->header.number_of_operands);
+    fd_reader->start += instruction_packed_size(&instruction->header);
+    return INSTRUCTION_READER_READ_ERROR_OK;
+}
+
+instruction_reader_read_error_t instruction_reader_fd_read_many(callback_sender sender,
+                                                                instruction_t *instructions,
+                                                                size_t number_of_instructions,
+                                                                size_t *number_of_read_instructions) {
+
+    instruction_reader_read_error_t error = INSTRUCTION_READER_READ_ERROR_OK;
+    size_t index;
+
+    for (index = 0; index < number_of_instructions; ++index) {
+        error = instruction_reader_fd_read(sender, &instructions[index]);
+        if (error != INSTRUCTION_READER_READ_ERROR_OK) {
+            break;
+        }
+    }
+
+    *number_of_read_instructions = index;
+    return error;
+}
+
+void instruction_reader_fd_seek(callback_sender sender,
+                                instruction_reader_offset_t offset,
+                                instruction_reader_seek_mode_t mode) {
+
+    instruction_reader_fd_t *fd_reader = sender;
+    instruction_reader_offset_t target;
+    off_t end;
+
+    switch (mode) {
+        case INSTRUCTION_READER_SEEK_CUR:
+            target = instruction_reader_fd_tell(fd_reader) + offset;
+            break;
+        case INSTRUCTION_READER_SEEK_END:
+            end = lseek(fd_reader->fd, 0, SEEK_END);
+            if (end < 0) {
+                fd_reader->failed = true;
+                return;
+            }
+
+            target = (instruction_reader_offset_t) end - fd_reader->origin + offset;
+            break;
+        default:
+            target = offset;
+            break;
+    }
+
+    if (target < 0) {
+        target = 0;
+    }
+
+    if (mode != INSTRUCTION_READER_SEEK_END &&
+        target >= fd_reader->buffer_offset &&
+        target <= fd_reader->buffer_offset + (instruction_reader_offset_t) fd_reader->end) {
+
+        fd_reader->start = (size_t) (target - fd_reader->buffer_offset);
+        return;
+    }
+
+    fd_reader->start = 0;
+    fd_reader->end = 0;
+    fd_reader->buffer_offset = target;
+    fd_reader->end_of_file = false;
+    fd_reader->failed = lseek(fd_reader->fd, (off_t) (fd_reader->origin + target), SEEK_SET) < 0;
+}
+
+instruction_reader_offset_t instruction_reader_fd_tell(callback_sender sender) {
+    const instruction_reader_fd_t *fd_reader = sender;
+    return fd_reader->buffer_offset + (instruction_reader_offset_t) fd_reader->start;
+}
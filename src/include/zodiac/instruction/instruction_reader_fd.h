@@ -0,0 +1,153 @@
+/**
+ * @file instruction_reader_fd.h
+ * @brief Defines a buffered instruction reader backed by a file descriptor.
+ *
+ * The reader pulls the packed instruction stream (see instruction_packed.h) from a file
+ * descriptor through a private buffer, so a whole read-ahead window is fetched with a
+ * single read() call instead of one call per header and per operand array. Regular files
+ * are additionally hinted for sequential access with posix_fadvise().
+ *
+ * Seeking inside the buffered window only moves the cursor; seeking outside of it
+ * repositions the file descriptor and discards the buffer. Descriptors that cannot
+ * seek, such as pipes, therefore support seeking only within the buffered window.
+ */
+
+#ifndef ZODIAC_INSTRUCTION_READER_FD_H
+#define ZODIAC_INSTRUCTION_READER_FD_H
+
+#include "instruction_packed.h"  // Packed instruction accessors.
+#include "instruction_reader.h"  // Generic instruction reader.
+
+/**
+ * @brief Default size of the buffer of a file descriptor reader in bytes.
+ */
+#define INSTRUCTION_READER_FD_DEFAULT_BUFFER_SIZE (64 * 1024)
+
+/**
+ * @brief Minimal size of the buffer of a file descriptor reader in bytes.
+ * The buffer must hold at least one instruction with the maximum number of operands.
+ */
+#define INSTRUCTION_READER_FD_MIN_BUFFER_SIZE 512
+
+/**
+ * @enum instruction_reader_fd_error_e
+ * @brief Enumerates possible errors that can occur when setting up a file descriptor reader.
+ */
+typedef enum instruction_reader_fd_error_e {
+    INSTRUCTION_READER_FD_ERROR_OK,      ///< No error occurred, the reader is ready.
+    INSTRUCTION_READER_FD_ERROR_OPEN,    ///< The file could not be opened.
+    INSTRUCTION_READER_FD_ERROR_MEMORY   ///< The buffer could not be allocated.
+} instruction_reader_fd_error_t;
+
+/**
+ * @struct instruction_reader_fd_options_s
+ * @brief Structure that configures the buffering of a file descriptor reader.
+ */
+typedef struct instruction_reader_fd_options_s {
+    size_t buffer_size;  ///< Size of the buffer, raised to INSTRUCTION_READER_FD_MIN_BUFFER_SIZE if smaller.
+    size_t read_ahead;   ///< Maximal number of bytes requested per read() call, 0 to fill the whole buffer.
+} instruction_reader_fd_options_t;
+
+/**
+ * @struct instruction_reader_fd_s
+ * @brief Structure that holds the file descriptor, the buffer and the current read position.
+ *
+ * The buffer holds the bytes of the stream starting at `buffer_offset`; the bytes in
+ * [start, end) have been fetched but not consumed yet.
+ */
+typedef struct instruction_reader_fd_s {
+    int fd;                                    ///< The file descriptor to read from.
+    bool owns_fd;                              ///< Whether the descriptor is closed by the reader.
+    bool end_of_file;                          ///< Whether the descriptor reported the end of the file.
+    bool failed;                               ///< Whether reading or repositioning the descriptor failed.
+    uint8_t *buffer;                           ///< Buffered bytes of the stream.
+    size_t buffer_size;                        ///< Size of the buffer in bytes.
+    size_t read_ahead;                         ///< Maximal number of bytes requested per read() call.
+    size_t start;                              ///< Index of the next unread byte in the buffer.
+    size_t end;                                ///< Index past the last fetched byte in the buffer.
+    instruction_reader_offset_t buffer_offset; ///< Offset in the stream of the first byte of the buffer.
+    instruction_reader_offset_t origin;        ///< Position of the descriptor corresponding to offset 0.
+} instruction_reader_fd_t;
+
+/**
+ * @brief Returns the default buffering options.
+ *
+ * @param[out] options The options to fill with the defaults.
+ */
+void instruction_reader_fd_options_init(instruction_reader_fd_options_t *options);
+
+/**
+ * @brief Opens a program file for buffered reading.
+ *
+ * @param[out] fd_reader Pointer to the reader state to initialize.
+ * @param[in] path Path of the program file.
+ * @param[in] options The buffering options, or nullptr for the defaults.
+ * @return instruction_reader_fd_error_t Error code resulting from the operation.
+ */
+instruction_reader_fd_error_t instruction_reader_fd_open(instruction_reader_fd_t *fd_reader,
+                                                         const char *path,
+                                                         const instruction_reader_fd_options_t *options);
+
+/**
+ * @brief Sets up buffered reading from an already open file descriptor.
+ *
+ * The descriptor is read from its current position, which is reported as offset 0,
+ * and is not closed by instruction_reader_fd_close().
+ *
+ * @param[out] fd_reader Pointer to the reader state to initialize.
+ * @param[in] fd The file descriptor to read from.
+ * @param[in] options The buffering options, or nullptr for the defaults.
+ * @return instruction_reader_fd_error_t Error code resulting from the operation.
+ */
+instruction_reader_fd_error_t instruction_reader_fd_attach(instruction_reader_fd_t *fd_reader,
+                                                           int fd,
+                                                           const instruction_reader_fd_options_t *options);
+
+/**
+ * @brief Releases the buffer and closes the descriptor if it is owned by the reader.
+ *
+ * @param[in,out] fd_reader Pointer to the reader state.
+ */
+void instruction_reader_fd_close(instruction_reader_fd_t *fd_reader);
+
+/**
+ * @brief Initializes an instruction reader that reads from a file descriptor.
+ *
+ * @param[out] reader Pointer to the instruction reader structure to initialize.
+ * @param[in] fd_reader The reader state used as the callback context.
+ */
+void instruction_reader_init_fd(instruction_reader_t *reader, instruction_reader_fd_t *fd_reader);
+
+/**
+ * @brief Read callback copying the next instruction out of the buffer.
+ * @see instruction_reader_read_callback_t
+ */
+instruction_reader_read_error_t instruction_reader_fd_read(callback_sender sender, instruction_t *instruction);
+
+/**
+ * @brief Batch read callback copying consecutive instructions out of the buffer.
+ * @see instruction_reader_read_many_callback_t
+ */
+instruction_reader_read_error_t instruction_reader_fd_read_many(callback_sender sender,
+                                                                instruction_t *instructions,
+                                                                size_t number_of_instructions,
+                                                                size_t *number_of_read_instructions);
+
+/**
+ * @brief Seek callback moving the read position within the stream.
+ *
+ * Positions before the start of the stream are clamped to 0.
+ *
+ * @see instruction_reader_seek_callback_t
+ */
+void instruction_reader_fd_seek(callback_sender sender,
+                                instruction_reader_offset_t offset,
+                                instruction_reader_seek_mode_t mode);
+
+/**
+ * @brief Tell callback reporting the read position within the stream.
+ * @see instruction_reader_tell_callback_t
+ */
+instruction_reader_offset_t instruction_reader_fd_tell(callback_sender sender);
+
+#endif // ZODIAC_INSTRUCTION_READER_FD_H
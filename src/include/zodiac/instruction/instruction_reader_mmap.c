@@ -0,0 +1,123 @@
+#include "instruction_reader_mmap.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+instruction_reader_mmap_error_t instruction_reader_mmap_open(instruction_reader_mmap_t *mapping, const char *path) {
+    struct stat status;
+    void *data;
+    int fd;
+
+    mapping->data = nullptr;
+    mapping->size = 0;
+    mapping->position = 0;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return INSTRUCTION_READER_MMAP_ERROR_OPEN;
+    }
+
+    if (fstat(fd, &status) != 0) {
+        close(fd);
+        return INSTRUCTION_READER_MMAP_ERROR_STAT;
+    }
+
+    if (status.st_size == 0) {
+        close(fd);
+        return INSTRUCTION_READER_MMAP_ERROR_OK;
+    }
+
+    data = mmap(nullptr, (size_t) status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED) {
+        return INSTRUCTION_READER_MMAP_ERROR_MAP;
+    }
+
+    mapping->data = data;
+    mapping->size = (size_t) status.st_size;
+    return INSTRUCTION_READER_MMAP_ERROR_OK;
+}
+
+void instruction_reader_mmap_close(instruction_reader_mmap_t *mapping) {
+    if (mapping->data != nullptr) {
+        munmap((void *) mapping->data, mapping->size);
+    }
+
+    mapping->data = nullptr;
+    mapping->size = 0;
+    mapping->position = 0;
+}
+
+void instruction_reader_init_mmap(instruction_reader_t *reader, instruction_reader_mmap_t *mapping) {
+    instruction_reader_init(reader, mapping,
+                            instruction_reader_mmap_read,
+                            instruction_reader_mmap_seek,
+                            instruction_reader_mmap_tell);
+
+    instruction_reader_set_read_many_callback(reader, instruction_reader_mmap_read_many);
+}
+
+instruction_reader_read_error_t instruction_reader_mmap_view(instruction_reader_mmap_t *mapping,
+                                                             instruction_view_t *view) {
+
+    instruction_reader_read_error_t error = instruction_packed_decode(mapping->data, mapping->size,
+                                                                      mapping->position, view);
+
+    if (error == INSTRUCTION_READER_READ_ERROR_OK) {
+        mapping->position += instruction_packed_size(view->header);
+    }
+
+    return error;
+}
+
+instruction_reader_read_error_t instruction_reader_mmap_read(callback_sender sender, instruction_t *instruction) {
+    instruction_view_t view;
+    instruction_reader_read_error_t error = instruction_reader_mmap_view(sender, &view);
+
+    if (error == INSTRUCTION_READER_READ_ERROR_OK) {
+        instruction->header = *view.header;
+        memcpy(instruction->operands, view.operands, view.header->number_of_operands);
+    }
+
+    return error;
+}
+
+instruction_reader_read_error_t instruction_reader_mmap_read_many(callback_sender sender,
+                                                                  instruction_t *instructions,
+                                                                  size_t number_of_instructions,
+                                                                  size_t *number_of_read_instructions) {
+
+    instruction_reader_read_error_t error = INSTRUCTION_READER_READ_ERROR_OK;
+    instruction_view_t view;
+    size_t index;
+
+    for (index = 0; index < number_of_instructions; ++index) {
+        error = instruction_reader_mmap_view(sender, &view);
+        if (error != INSTRUCTION_READER_READ_ERROR_OK) {
+            break;
+        }
+
+        instructions[index].header = *view.header;
+        memcpy(instructions[index].operands, view.operands, view.header->number_of_operands);
+    }
+
+    *number_of_read_instructions = index;
+    return error;
+}
+
+void instruction_reader_mmap_seek(callback_sender sender,
+                                  instruction_reader_offset_t offset,
+                                  instruction_reader_seek_mode_t mode) {
+
+    instruction_reader_mmap_t *mapping = sender;
+    mapping->position = instruction_packed_seek(mapping->position, mapping->size, offset, mode);
+}
+
+instruction_reader_offset_t instruction_reader_mmap_tell(callback_sender sender) {
+    const instruction_reader_mmap_t *mapping = sender;
+    return (instruction_reader_offset_t) mapping->position;
+}
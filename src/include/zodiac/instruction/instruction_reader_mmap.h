@@ -0,0 +1,109 @@
+/**
+ * @file instruction_reader_mmap.h
+ * @brief Defines an instruction reader backed by a memory-mapped program file.
+ *
+ * The program file is mapped read-only into memory and instructions are decoded
+ * straight from the mapping, so pages are loaded lazily on first access. Besides the
+ * read, seek and tell callbacks used by instruction_reader_t, the reader exposes a
+ * view API returning pointers into the mapping without copying the instruction.
+ *
+ * The program file is a plain sequence of instructions in the packed format
+ * described in instruction_packed.h.
+ */
+
+#ifndef ZODIAC_INSTRUCTION_READER_MMAP_H
+#define ZODIAC_INSTRUCTION_READER_MMAP_H
+
+#include "instruction_packed.h"  // Packed instruction accessors.
+#include "instruction_reader.h"  // Generic instruction reader.
+
+/**
+ * @enum instruction_reader_mmap_error_e
+ * @brief Enumerates possible errors that can occur when mapping a program file.
+ */
+typedef enum instruction_reader_mmap_error_e {
+    INSTRUCTION_READER_MMAP_ERROR_OK,     ///< No error occurred, the file is mapped.
+    INSTRUCTION_READER_MMAP_ERROR_OPEN,   ///< The file could not be opened.
+    INSTRUCTION_READER_MMAP_ERROR_STAT,   ///< The size of the file could not be determined.
+    INSTRUCTION_READER_MMAP_ERROR_MAP     ///< The file could not be mapped into memory.
+} instruction_reader_mmap_error_t;
+
+/**
+ * @struct instruction_reader_mmap_s
+ * @brief Structure that holds a mapped program file and the current read position.
+ */
+typedef struct instruction_reader_mmap_s {
+    const uint8_t *data;  ///< Start of the mapping, nullptr for an empty file.
+    size_t size;          ///< Size of the mapping in bytes.
+    size_t position;      ///< Offset of the next instruction to read.
+} instruction_reader_mmap_t;
+
+/**
+ * @brief Maps a program file into memory.
+ *
+ * @param[out] mapping Pointer to the mapped reader state to initialize.
+ * @param[in] path Path of the program file.
+ * @return instruction_reader_mmap_error_t Error code resulting from the mapping.
+ */
+instruction_reader_mmap_error_t instruction_reader_mmap_open(instruction_reader_mmap_t *mapping, const char *path);
+
+/**
+ * @brief Unmaps a program file mapped with instruction_reader_mmap_open().
+ *
+ * Views obtained from the reader become invalid.
+ *
+ * @param[in,out] mapping Pointer to the mapped reader state.
+ */
+void instruction_reader_mmap_close(instruction_reader_mmap_t *mapping);
+
+/**
+ * @brief Initializes an instruction reader that reads from a mapped program file.
+ *
+ * @param[out] reader Pointer to the instruction reader structure to initialize.
+ * @param[in] mapping The mapped reader state used as the callback context.
+ */
+void instruction_reader_init_mmap(instruction_reader_t *reader, instruction_reader_mmap_t *mapping);
+
+/**
+ * @brief Returns a view of the next instruction and advances past it.
+ *
+ * @param[in,out] mapping Pointer to the mapped reader state.
+ * @param[out] view The view to fill with pointers into the mapping.
+ * @return instruction_reader_read_error_t Error code resulting from the read operation.
+ */
+instruction_reader_read_error_t instruction_reader_mmap_view(instruction_reader_mmap_t *mapping,
+                                                             instruction_view_t *view);
+
+/**
+ * @brief Read callback copying the next instruction out of the mapping.
+ * @see instruction_reader_read_callback_t
+ */
+instruction_reader_read_error_t instruction_reader_mmap_read(callback_sender sender, instruction_t *instruction);
+
+/**
+ * @brief Batch read callback copying consecutive instructions out of the mapping.
+ * @see instruction_reader_read_many_callback_t
+ */
+instruction_reader_read_error_t instruction_reader_mmap_read_many(callback_sender sender,
+                                                                  instruction_t *instructions,
+                                                                  size_t number_of_instructions,
+                                                                  size_t *number_of_read_instructions);
+
+/**
+ * @brief Seek callback moving the read position within the mapping.
+ *
+ * The resulting position is clamped to the bounds of the mapping.
+ *
+ * @see instruction_reader_seek_callback_t
+ */
+void instruction_reader_mmap_seek(callback_sender sender,
+                                  instruction_reader_offset_t offset,
+                                  instruction_reader_seek_mode_t mode);
+
+/**
+ * @brief Tell callback reporting the read position within the mapping.
+ * @see instruction_reader_tell_callback_t
+ */
+instruction_reader_offset_t instruction_reader_mmap_tell(callback_sender sender);
+
+#endif // ZODIAC_INSTRUCTION_READER_MMAP_H
@@ -0,0 +1,321 @@
+#include "instruction_reader_prefetch.h"
+
+#include <sched.h>
+#include <string.h>
+
+/// Max number of slots the producer thread fills before publishing them.
+#define INSTRUCTION_READER_PREFETCH_BATCH_SIZE 32
+
+/// Number of times the consumer yields while waiting for the producer before it sleeps.
+#define INSTRUCTION_READER_PREFETCH_SPIN_COUNT 64
+
+/// Number of slots ahead of the consumer whose memory is prefetched on every read.
+#define INSTRUCTION_READER_PREFETCH_DISTANCE 2
+
+/// Size of a cache line assumed when prefetching a slot.
+#define INSTRUCTION_READER_PREFETCH_LINE_SIZE 64
+
+/**
+ * @brief Reads instructions of the source into the slots starting at `head`.
+ *
+ * @param[out] ended Set when the last filled slot holds a failed read.
+ * @return The number of filled slots.
+ */
+static size_t instruction_reader_prefetch_fill(instruction_reader_prefetch_t *prefetch,
+                                               size_t head,
+                                               size_t number_of_slots,
+                                               bool *ended) {
+
+    instruction_reader_offset_t offset = instruction_reader_tell(prefetch->source);
+    size_t index = 0;
+
+    *ended = false;
+
+    while (index < number_of_slots) {
+        instruction_reader_prefetch_slot_t *slot = &prefetch->slots[(head + index++) & prefetch->mask];
+
+        slot->offset = offset;
+        slot->error = instruction_reader_read(prefetch->source, &slot->instruction);
+
+        if (slot->error != INSTRUCTION_READER_READ_ERROR_OK) {
+            *ended = true;
+            break;
+        }
+
+        offset = instruction_reader_tell(prefetch->source);
+    }
+
+    return index;
+}
+
+/**
+ * @brief Returns the number of slots the producer thread fills at once.
+ */
+static size_t instruction_reader_prefetch_batch_size(const instruction_reader_prefetch_t *prefetch) {
+    size_t batch_size = (prefetch->mask + 1) / 2;
+    return batch_size < INSTRUCTION_READER_PREFETCH_BATCH_SIZE ? batch_size : INSTRUCTION_READER_PREFETCH_BATCH_SIZE;
+}
+
+/**
+ * @brief Entry point of the producer thread.
+ *
+ * Refills the ring in small batches, published at once, and sleeps while less than a
+ * batch is free or the ring ends with a failed read, unless a seek is pending.
+ */
+static void *instruction_reader_prefetch_producer(void *argument) {
+    instruction_reader_prefetch_t *prefetch = argument;
+    size_t number_of_slots = prefetch->mask + 1;
+    size_t batch_size = instruction_reader_prefetch_batch_size(prefetch);
+
+    pthread_mutex_lock(&prefetch->mutex);
+
+    while (prefetch->running) {
+        size_t head = atomic_load_explicit(&prefetch->head, memory_order_relaxed);
+        size_t number_of_free_slots;
+        size_t number_of_filled_slots;
+        uint64_t generation;
+        bool ended;
+
+        if (prefetch->seek_pending) {
+            instruction_reader_seek(prefetch->source, prefetch->seek_offset, prefetch->seek_mode);
+            prefetch->seek_pending = false;
+            prefetch->ended = false;
+        }
+
+        atomic_store(&prefetch->producer_waiting, true);
+        number_of_free_slots = number_of_slots - (head - atomic_load(&prefetch->tail));
+
+        if (prefetch->ended || number_of_free_slots < batch_size) {
+            pthread_cond_wait(&prefetch->consumed, &prefetch->mutex);
+            atomic_store_explicit(&prefetch->producer_waiting, false, memory_order_relaxed);
+            continue;
+        }
+
+        atomic_store_explicit(&prefetch->producer_waiting, false, memory_order_relaxed);
+        generation = prefetch->generation;
+        pthread_mutex_unlock(&prefetch->mutex);
+
+        number_of_filled_slots = instruction_reader_prefetch_fill(prefetch, head, batch_size, &ended);
+
+        pthread_mutex_lock(&prefetch->mutex);
+
+        // A seek during the fill makes the batch stale; it is dropped and the seek applied.
+        if (generation == prefetch->generation) {
+            atomic_store_explicit(&prefetch->head, head + number_of_filled_slots, memory_order_release);
+            prefetch->ended = ended;
+            pthread_cond_signal(&prefetch->produced);
+        }
+    }
+
+    pthread_mutex_unlock(&prefetch->mutex);
+    return nullptr;
+}
+
+/**
+ * @brief Returns the slot of the next instruction, filling the ring or waiting for the producer if it is empty.
+ *
+ * @param[out] position The position of the slot.
+ */
+static instruction_reader_prefetch_slot_t *instruction_reader_prefetch_front(instruction_reader_prefetch_t *prefetch,
+                                                                            size_t *position) {
+
+    size_t tail = atomic_load_explicit(&prefetch->tail, memory_order_relaxed);
+    bool ended;
+
+    if (atomic_load_explicit(&prefetch->head, memory_order_acquire) == tail) {
+        if (!prefetch->threaded) {
+            size_t number_of_filled_slots = instruction_reader_prefetch_fill(prefetch, tail, prefetch->mask + 1,
+                                                                             &ended);
+
+            atomic_store_explicit(&prefetch->head, tail + number_of_filled_slots, memory_order_relaxed);
+        } else {
+            for (size_t spin = 0; spin < INSTRUCTION_READER_PREFETCH_SPIN_COUNT; ++spin) {
+                if (atomic_load_explicit(&prefetch->head, memory_order_acquire) != tail) {
+                    *position = tail;
+                    return &prefetch->slots[tail & prefetch->mask];
+                }
+
+                sched_yield();
+            }
+
+            pthread_mutex_lock(&prefetch->mutex);
+
+            while (atomic_load_explicit(&prefetch->head, memory_order_acquire) == tail) {
+                pthread_cond_wait(&prefetch->produced, &prefetch->mutex);
+            }
+
+            pthread_mutex_unlock(&prefetch->mutex);
+        }
+    }
+
+    *position = tail;
+    return &prefetch->slots[tail & prefetch->mask];
+}
+
+/**
+ * @brief Moves the consumer to a position of the ring and wakes the producer if enough slots are free.
+ */
+static void instruction_reader_prefetch_advance(instruction_reader_prefetch_t *prefetch, size_t tail) {
+    size_t head;
+
+    if (!prefetch->threaded) {
+        atomic_store_explicit(&prefetch->tail, tail, memory_order_relaxed);
+        return;
+    }
+
+    atomic_store(&prefetch->tail, tail);
+
+    if (atomic_load(&prefetch->producer_waiting)) {
+        head = atomic_load_explicit(&prefetch->head, memory_order_relaxed);
+
+        if (prefetch->mask + 1 - (head - tail) >= instruction_reader_prefetch_batch_size(prefetch)) {
+            pthread_mutex_lock(&prefetch->mutex);
+            pthread_cond_signal(&prefetch->consumed);
+            pthread_mutex_unlock(&prefetch->mutex);
+        }
+    }
+}
+
+instruction_reader_prefetch_error_t instruction_reader_prefetch_init(instruction_reader_prefetch_t *prefetch,
+                                                                     instruction_reader_t *source,
+                                                                     size_t lookahead,
+                                                                     bool threaded,
+                                                                     const platform_allocator_t *allocator) {
+
+    size_t number_of_slots = 2;
+
+    if (lookahead == 0) {
+        lookahead = INSTRUCTION_READER_PREFETCH_DEFAULT_LOOKAHEAD;
+    }
+
+    while (number_of_slots < lookahead) {
+        number_of_slots <<= 1;
+    }
+
+    prefetch->slots = platform_memory_allocate(allocator, number_of_slots * sizeof(instruction_reader_prefetch_slot_t));
+    if (prefetch->slots == nullptr) {
+        return INSTRUCTION_READER_PREFETCH_ERROR_MEMORY;
+    }
+
+    prefetch->source = source;
+    prefetch->mask = number_of_slots - 1;
+    prefetch->threaded = threaded;
+    prefetch->ended = false;
+    prefetch->running = threaded;
+    prefetch->seek_pending = false;
+    prefetch->seek_offset = 0;
+    prefetch->seek_mode = INSTRUCTION_READER_SEEK_SET;
+    prefetch->generation = 0;
+    prefetch->allocator = allocator;
+
+    atomic_init(&prefetch->head, 0);
+    atomic_init(&prefetch->tail, 0);
+    atomic_init(&prefetch->producer_waiting, false);
+
+    pthread_mutex_init(&prefetch->mutex, nullptr);
+    pthread_cond_init(&prefetch->produced, nullptr);
+    pthread_cond_init(&prefetch->consumed, nullptr);
+
+    if (threaded && pthread_create(&prefetch->thread, nullptr, instruction_reader_prefetch_producer, prefetch) != 0) {
+        prefetch->threaded = false;
+        instruction_reader_prefetch_free(prefetch);
+        return INSTRUCTION_READER_PREFETCH_ERROR_THREAD;
+    }
+
+    return INSTRUCTION_READER_PREFETCH_ERROR_OK;
+}
+
+void instruction_reader_prefetch_free(instruction_reader_prefetch_t *prefetch) {
+    if (prefetch->threaded) {
+        pthread_mutex_lock(&prefetch->mutex);
+        prefetch->running = false;
+        pthread_cond_signal(&prefetch->consumed);
+        pthread_mutex_unlock(&prefetch->mutex);
+
+        pthread_join(prefetch->thread, nullptr);
+        prefetch->threaded = false;
+    }
+
+    pthread_cond_destroy(&prefetch->consumed);
+    pthread_cond_destroy(&prefetch->produced);
+    pthread_mutex_destroy(&prefetch->mutex);
+
+    platform_memory_release(prefetch->allocator, prefetch->slots);
+    prefetch->slots = nullptr;
+}
+
+void instruction_reader_init_prefetch(instruction_reader_t *reader, instruction_reader_prefetch_t *prefetch) {
+    instruction_reader_init(reader, prefetch,
+                            instruction_reader_prefetch_read,
+                            instruction_reader_prefetch_seek,
+                            instruction_reader_prefetch_tell);
+}
+
+instruction_reader_read_error_t instruction_reader_prefetch_read(callback_sender sender, instruction_t *instruction) {
+    instruction_reader_prefetch_t *prefetch = sender;
+    size_t tail;
+    const instruction_reader_prefetch_slot_t *slot = instruction_reader_prefetch_front(prefetch, &tail);
+    const instruction_reader_prefetch_slot_t *ahead = &prefetch->slots[(tail + INSTRUCTION_READER_PREFETCH_DISTANCE)
+                                                                       & prefetch->mask];
+
+    // The failed read stays at the front, so reading again reports it again.
+    if (slot->error != INSTRUCTION_READER_READ_ERROR_OK) {
+        return slot->error;
+    }
+
+    ZDC_PREFETCH(ahead);
+    ZDC_PREFETCH((const uint8_t *) ahead + INSTRUCTION_READER_PREFETCH_LINE_SIZE);
+
+    instruction->header = slot->instruction.header;
+    memcpy(instruction->operands, slot->instruction.operands, slot->instruction.header.number_of_operands);
+
+    instruction_reader_prefetch_advance(prefetch, tail + 1);
+    return INSTRUCTION_READER_READ_ERROR_OK;
+}
+
+void instruction_reader_prefetch_seek(callback_sender sender,
+                                      instruction_reader_offset_t offset,
+                                      instruction_reader_seek_mode_t mode) {
+
+    instruction_reader_prefetch_t *prefetch = sender;
+    size_t tail = atomic_load_explicit(&prefetch->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&prefetch->head, memory_order_acquire);
+
+    if (mode == INSTRUCTION_READER_SEEK_CUR) {
+        offset += instruction_reader_prefetch_tell(prefetch);
+        mode = INSTRUCTION_READER_SEEK_SET;
+        head = atomic_load_explicit(&prefetch->head, memory_order_acquire);
+    }
+
+    // Forward jumps landing on an instruction read ahead keep the rest of the ring.
+    if (mode == INSTRUCTION_READER_SEEK_SET) {
+        for (size_t position = tail; position != head; ++position) {
+            if (prefetch->slots[position & prefetch->mask].offset == offset) {
+                instruction_reader_prefetch_advance(prefetch, position);
+                return;
+            }
+        }
+    }
+
+    if (!prefetch->threaded) {
+        instruction_reader_seek(prefetch->source, offset, mode);
+        atomic_store_explicit(&prefetch->tail, head, memory_order_relaxed);
+        return;
+    }
+
+    pthread_mutex_lock(&prefetch->mutex);
+
+    ++prefetch->generation;
+    prefetch->seek_pending = true;
+    prefetch->seek_offset = offset;
+    prefetch->seek_mode = mode;
+    atomic_store(&prefetch->tail, atomic_load_explicit(&prefetch->head, memory_order_relaxed));
+
+    pthread_cond_signal(&prefetch->consumed);
+    pthread_mutex_unlock(&prefetch->mutex);
+}
+
+instruction_reader_offset_t instruction_reader_prefetch_tell(callback_sender sender) {
+    size_t tail;
+    return instruction_reader_prefetch_front(sender, &tail)->offset;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file instruction_reader_prefetch.h
+ * @brief Defines a lookahead stage reading ahead of the executor from any instruction reader.
+ *
+ * The stage decodes up to a fixed number of instructions ahead of the consumer into a
+ * single-producer, single-consumer ring. The producer either runs on its own thread, so
+ * I/O and decoding of a streaming source overlap with execution, or inline, refilling
+ * the ring in batches whenever the consumer drains it. Reading prefetches the slots the
+ * consumer reaches next into its cache. The producer thread only pays off with a core to
+ * spare; otherwise the inline producer amortizes the reads of the source over a batch.
+ *
+ * Seeking to an instruction already read ahead skips to it; any other seek discards the
+ * instructions read ahead and the producer restarts from the target offset. Programs
+ * branching often are better served by instruction_reader_cache.h, which the stage can wrap.
+ *
+ * The source belongs to the stage while it exists and must not be used otherwise.
+ */
+
+#ifndef ZODIAC_INSTRUCTION_READER_PREFETCH_H
+#define ZODIAC_INSTRUCTION_READER_PREFETCH_H
+
+#include "instruction_reader.h"             // Generic instruction reader.
+#include "../platform/platform_memory.h"    // Source of the memory of the ring.
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+/**
+ * @brief Default number of instructions read ahead.
+ */
+#define INSTRUCTION_READER_PREFETCH_DEFAULT_LOOKAHEAD 256
+
+/**
+ * @enum instruction_reader_prefetch_error_e
+ * @brief Enumerates possible errors that can occur when creating a lookahead stage.
+ */
+typedef enum instruction_reader_prefetch_error_e {
+    INSTRUCTION_READER_PREFETCH_ERROR_OK,       ///< No error occurred, the stage is ready.
+    INSTRUCTION_READER_PREFETCH_ERROR_MEMORY,   ///< The ring could not be allocated.
+    INSTRUCTION_READER_PREFETCH_ERROR_THREAD    ///< The producer thread could not be started.
+} instruction_reader_prefetch_error_t;
+
+/**
+ * @struct instruction_reader_prefetch_slot_s
+ * @brief Structure that holds an instruction read ahead.
+ */
+typedef struct instruction_reader_prefetch_slot_s {
+    instruction_reader_offset_t offset;       ///< Offset of the instruction within the source.
+    instruction_reader_read_error_t error;    ///< Result of the read, the ring stops at the first failure.
+    instruction_t instruction;                ///< The decoded instruction.
+} instruction_reader_prefetch_slot_t;
+
+/**
+ * @struct instruction_reader_prefetch_s
+ * @brief Structure that holds the ring of a lookahead stage and its producer.
+ *
+ * Positions count slots since the creation of the stage and are reduced with `mask`.
+ * The mutex guards the fields marked as such and the sleeping of both sides.
+ */
+typedef struct instruction_reader_prefetch_s {
+    instruction_reader_t *source;                  ///< The reader read ahead of.
+    instruction_reader_prefetch_slot_t *slots;     ///< The ring.
+    size_t mask;                                   ///< Number of slots minus one.
+    atomic_size_t head;                            ///< Position of the next slot published by the producer.
+    atomic_size_t tail;                            ///< Position of the next slot consumed by the reader.
+    bool threaded;                                 ///< Whether the producer runs on its own thread.
+    bool ended;                                    ///< Whether the ring ends with a failed read, guarded.
+    bool running;                                  ///< Whether the producer thread keeps going, guarded.
+    bool seek_pending;                             ///< Whether the producer must seek the source, guarded.
+    instruction_reader_offset_t seek_offset;       ///< Offset of the pending seek, guarded.
+    instruction_reader_seek_mode_t seek_mode;      ///< Mode of the pending seek, guarded.
+    uint64_t generation;                           ///< Number of seeks so far, guarded.
+    atomic_bool producer_waiting;                  ///< Whether the producer sleeps until slots are freed.
+    pthread_mutex_t mutex;                         ///< Guards the state shared with the producer thread.
+    pthread_cond_t produced;                       ///< Signaled when the producer publishes slots.
+    pthread_cond_t consumed;                       ///< Signaled when the producer has work again.
+    pthread_t thread;                              ///< The producer thread, if threaded.
+    const platform_allocator_t *allocator;         ///< Source of the memory of the ring.
+} instruction_reader_prefetch_t;
+
+/**
+ * @brief Creates a lookahead stage in front of a source reader, starting at the position of the source.
+ *
+ * @param[out] prefetch Pointer to the stage to initialize.
+ * @param[in,out] source The reader to read ahead of, which must outlive the stage.
+ * @param[in] lookahead Number of instructions read ahead, rounded up to a power of two, or 0 for the default.
+ * @param[in] threaded Whether the producer runs on its own thread.
+ * @param[in] allocator The allocator of the ring, or nullptr for the default allocator.
+ * @return instruction_reader_prefetch_error_t Error code resulting from the operation.
+ */
+instruction_reader_prefetch_error_t instruction_reader_prefetch_init(instruction_reader_prefetch_t *prefetch,
+                                                                     instruction_reader_t *source,
+                                                                     size_t lookahead,
+                                                                     bool threaded,
+                                                                     const platform_allocator_t *allocator);
+
+/**
+ * @brief Stops the producer and releases the ring of a lookahead stage.
+ *
+ * The source is left after the last instruction read ahead, not at the position of the stage.
+ *
+ * @param[in,out] prefetch Pointer to the stage.
+ */
+void instruction_reader_prefetch_free(instruction_reader_prefetch_t *prefetch);
+
+/**
+ * @brief Initializes an instruction reader that reads through a lookahead stage.
+ *
+ * @param[out] reader Pointer to the instruction reader structure to initialize.
+ * @param[in] prefetch The stage used as the callback context.
+ */
+void instruction_reader_init_prefetch(instruction_reader_t *reader, instruction_reader_prefetch_t *prefetch);
+
+/**
+ * @brief Read callback serving the next instruction from the ring, waiting for the producer if needed.
+ * @see instruction_reader_read_callback_t
+ */
+instruction_reader_read_error_t instruction_reader_prefetch_read(callback_sender sender, instruction_t *instruction);
+
+/**
+ * @brief Seek callback skipping to an instruction read ahead, or restarting the producer at the target.
+ * @see instruction_reader_seek_callback_t
+ */
+void instruction_reader_prefetch_seek(callback_sender sender,
+                                      instruction_reader_offset_t offset,
+                                      instruction_reader_seek_mode_t mode);
+
+/**
+ * @brief Tell callback reporting the offset of the next instruction served by the ring.
+ * @see instruction_reader_tell_callback_t
+ */
+instruction_reader_offset_t instruction_reader_prefetch_tell(callback_sender sender);
+
+#endif // ZODIAC_INSTRUCTION_READER_PREFETCH_H
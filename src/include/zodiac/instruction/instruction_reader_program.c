@@ -0,0 +1,80 @@
+#include "instruction_reader_program.h"
+
+#include <string.h>
+
+void instruction_reader_init_program(instruction_reader_t *reader,
+                                     instruction_reader_program_t *cursor,
+                                     const instruction_program_t *program) {
+
+    cursor->program = program;
+    cursor->position = 0;
+
+    instruction_reader_init(reader, cursor,
+                            instruction_reader_program_read,
+                            instruction_reader_program_seek,
+                            instruction_reader_program_tell);
+
+    instruction_reader_set_read_many_callback(reader, instruction_reader_program_read_many);
+}
+
+instruction_reader_read_error_t instruction_reader_program_view(instruction_reader_program_t *cursor,
+                                                                instruction_view_t *view) {
+
+    instruction_reader_read_error_t error = instruction_program_view(cursor->program,
+                                                                     (instruction_reader_offset_t) cursor->position,
+                                                                     view);
+
+    if (error == INSTRUCTION_READER_READ_ERROR_OK) {
+        cursor->position += instruction_packed_size(view->header);
+    }
+
+    return error;
+}
+
+instruction_reader_read_error_t instruction_reader_program_read(callback_sender sender, instruction_t *instruction) {
+    instruction_view_t view;
+    instruction_reader_read_error_t error = instruction_reader_program_view(sender, &view);
+
+    if (error == INSTRUCTION_READER_READ_ERROR_OK) {
+        instruction->header = *view.header;
+        memcpy(instruction->operands, view.operands, view.header->number_of_operands);
+    }
+
+    return error;
+}
+
+instruction_reader_read_error_t instruction_reader_program_read_many(callback_sender sender,
+                                                                     instruction_t *instructions,
+                                                                     size_t number_of_instructions,
+                                                                     size_t *number_of_read_instructions) {
+
+    instruction_reader_read_error_t error = INSTRUCTION_READER_READ_ERROR_OK;
+    instruction_view_t view;
+    size_t index;
+
+    for (index = 0; index < number_of_instructions; ++index) {
+        error = instruction_reader_program_view(sender, &view);
+        if (error != INSTRUCTION_READER_READ_ERROR_OK) {
+            break;
+        }
+
+        instructions[index].header = *view.header;
+        memcpy(instructions[index].operands, view.operands, view.header->number_of_operands);
+    }
+
+    *number_of_read_instructions = index;
+    return error;
+}
+
+void instruction_reader_program_seek(callback_sender sender,
+                                     instruction_reader_offset_t offset,
+                                     instruction_reader_seek_mode_t mode) {
+
+    instruction_reader_program_t *cursor = sender;
+    cursor->position = instruction_packed_seek(cursor->position, cursor->program->size, offset, mode);
+}
+
+instruction_reader_offset_t instruction_reader_program_tell(callback_sender sender) {
+    const instruction_reader_program_t *cursor = sender;
+    return (instruction_reader_offset_t) cursor->position;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file instruction_reader_program.h
+ * @brief Defines an instruction reader over a decoded program.
+ *
+ * Lets a program held in the packed in-memory format be consumed through the generic
+ * instruction_reader_t interface, using the same accessors as the executor.
+ */
+
+#ifndef ZODIAC_INSTRUCTION_READER_PROGRAM_H
+#define ZODIAC_INSTRUCTION_READER_PROGRAM_H
+
+#include "instruction_program.h"  // Decoded program.
+
+/**
+ * @struct instruction_reader_program_s
+ * @brief Structure that holds the program being read and the current read position.
+ */
+typedef struct instruction_reader_program_s {
+    const instruction_program_t *program; ///< The program being read.
+    size_t position;                      ///< Offset of the next instruction to read.
+} instruction_reader_program_t;
+
+/**
+ * @brief Initializes an instruction reader that reads from a decoded program.
+ *
+ * @param[out] reader Pointer to the instruction reader structure to initialize.
+ * @param[out] cursor The reader state used as the callback context.
+ * @param[in] program The program to read, which must outlive the reader.
+ */
+void instruction_reader_init_program(instruction_reader_t *reader,
+                                     instruction_reader_program_t *cursor,
+                                     const instruction_program_t *program);
+
+/**
+ * @brief Returns a view of the next instruction and advances past it.
+ *
+ * @param[in,out] cursor Pointer to the reader state.
+ * @param[out] view The view to fill with pointers into the program.
+ * @return instruction_reader_read_error_t Error code resulting from the read operation.
+ */
+instruction_reader_read_error_t instruction_reader_program_view(instruction_reader_program_t *cursor,
+                                                                instruction_view_t *view);
+
+/**
+ * @brief Read callback copying the next instruction out of the program.
+ * @see instruction_reader_read_callback_t
+ */
+instruction_reader_read_error_t instruction_reader_program_read(callback_sender sender, instruction_t *instruction);
+
+/**
+ * @brief Batch read callback copying consecutive instructions out of the program.
+ * @see instruction_reader_read_many_callback_t
+ */
+instruction_reader_read_error_t instruction_reader_program_read_many(callback_sender sender,
+                                                                     instruction_t *instructions,
+                                                                     size_t number_of_instructions,
+                                                                     size_t *number_of_read_instructions);
+
+/**
+ * @brief Seek callback moving the read position within the program.
+ *
+ * The resulting position is clamped to the bounds of the program.
+ *
+ * @see instruction_reader_seek_callback_t
+ */
+void instruction_reader_program_seek(callback_sender sender,
+                                     instruction_reader_offset_t offset,
+                                     instruction_reader_seek_mode_t mode);
+
+/**
+ * @brief Tell callback reporting the read position within the program.
+ * @see instruction_reader_tell_callback_t
+ */
+instruction_reader_offset_t instruction_reader_program_tell(callback_sender sender);
+
+#endif // ZODIAC_INSTRUCTION_READER_PROGRAM_H
@@ -21,7 +21,8 @@
 typedef enum instruction_reader_read_error_e {
     INSTRUCTION_READER_READ_ERROR_OK,         ///< No error occurred, instruction read successfully.
     INSTRUCTION_READER_READ_ERROR_HEADER,     ///< Error occurred while reading the instruction header.
-    INSTRUCTION_READER_READ_ERROR_OPERANDS    ///< Error occurred while reading the instruction operands.
+    INSTRUCTION_READER_READ_ERROR_OPERANDS,   ///< Error occurred while reading the instruction operands.
+    INSTRUCTION_READER_READ_ERROR_END         ///< The end of the instruction stream has been reached.
 } instruction_reader_read_error_t;
 
 /**
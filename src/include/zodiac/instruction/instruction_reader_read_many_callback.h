@@ -0,0 +1,34 @@
+/**
+ * @file instruction_reader_read_many_callback.h
+ * @brief Defines the callback for reading a batch of instructions.
+ *
+ * This file contains the definition of the optional callback an instruction reader can
+ * provide to read several instructions in a single call, amortizing the cost of the
+ * indirect call and of the error check over the whole batch.
+ */
+
+#ifndef ZODIAC_INSTRUCTION_READER_READ_MANY_CALLBACK_H
+#define ZODIAC_INSTRUCTION_READER_READ_MANY_CALLBACK_H
+
+#include "instruction_reader_read_callback.h"  ///< Include the read errors.
+
+/**
+ * @typedef instruction_reader_read_many_callback_t
+ * @brief Function pointer type for the callback used for reading a batch of instructions.
+ *
+ * The callback reads up to `number_of_instructions` instructions into consecutive
+ * elements of `instructions`. It stops at the first instruction that cannot be read and
+ * reports the reason, so a batch cut short by the end of the stream returns
+ * INSTRUCTION_READER_READ_ERROR_END together with the number of instructions read before it.
+ *
+ * @param[in] sender The context from which the callback is being invoked.
+ * @param[out] instructions Array receiving the read instructions.
+ * @param[in] number_of_instructions Number of elements in the array.
+ * @param[out] number_of_read_instructions Number of instructions actually read.
+ * @return INSTRUCTION_READER_READ_ERROR_OK if the whole batch was read, otherwise the error that stopped it.
+ */
+typedef instruction_reader_read_error_t (*instruction_reader_read_many_callback_t)
+        (callback_sender sender, instruction_t *instructions, size_t number_of_instructions,
+         size_t *number_of_read_instructions);
+
+#endif // ZODIAC_INSTRUCTION_READER_READ_MANY_CALLBACK_H
@@ -0,0 +1,77 @@
+/**
+ * @file instruction_reader_specialize.h
+ * @brief Generates header-only read, seek and tell functions specialized for a reader backend.
+ *
+ * instruction_reader_read() and its siblings are out-of-line functions making an indirect
+ * call, so the compiler can never inline through them. A backend exposing its cursor as
+ * forced inline functions can be specialized with INSTRUCTION_READER_SPECIALIZE(), which
+ * defines static inline variants of the generic functions that call the backend directly.
+ * Code built against a known backend, such as a run loop of the executor, uses them to
+ * get devirtualized, inlined reads.
+ *
+ * A backend named `name` with the state type `state_type` must provide:
+ * - `instruction_reader_name_read`, its read callback, identifying readers of the backend;
+ * - `instruction_reader_name_view(state_type *, instruction_view_t *)`;
+ * - `instruction_reader_name_move(state_type *, instruction_reader_offset_t, instruction_reader_seek_mode_t)`;
+ * - `instruction_reader_name_position(const state_type *)`.
+ */
+
+#ifndef ZODIAC_INSTRUCTION_READER_SPECIALIZE_H
+#define ZODIAC_INSTRUCTION_READER_SPECIALIZE_H
+
+#include "instruction_reader.h"  // Generic instruction reader.
+#include "instruction_view.h"    // Non-owning instruction view.
+
+#include <string.h>
+
+/**
+ * @brief Defines the specialized functions of a reader backend.
+ *
+ * Expands to:
+ * - `instruction_reader_is_name(reader)`, whether a reader was initialized for the backend;
+ * - `instruction_reader_view_name(reader, view)`, returning a view of the next instruction;
+ * - `instruction_reader_read_name(reader, instruction)`, copying the next instruction;
+ * - `instruction_reader_seek_name(reader, offset, mode)`;
+ * - `instruction_reader_tell_name(reader)`.
+ *
+ * All but the first require a reader of the backend. Tracing spans of the generic
+ * functions are not recorded.
+ *
+ * @param name Name of the backend.
+ * @param state_type Type of the state the readers of the backend use as sender.
+ */
+#define INSTRUCTION_READER_SPECIALIZE(name, state_type)                                                     \
+    ZDC_STATIC ZDC_FORCE_INLINE bool instruction_reader_is_##name(const instruction_reader_t *reader) {     \
+        return reader->read_callback == instruction_reader_##name##_read;                                   \
+    }                                                                                                       \
+                                                                                                            \
+    ZDC_STATIC ZDC_FORCE_INLINE instruction_reader_read_error_t                                             \
+    instruction_reader_view_##name(instruction_reader_t *reader, instruction_view_t *view) {                \
+        return instruction_reader_##name##_view((state_type *) reader->sender, view);                       \
+    }                                                                                                       \
+                                                                                                            \
+    ZDC_STATIC ZDC_FORCE_INLINE instruction_reader_read_error_t                                             \
+    instruction_reader_read_##name(instruction_reader_t *reader, instruction_t *instruction) {              \
+        instruction_view_t view;                                                                            \
+        instruction_reader_read_error_t error = instruction_reader_view_##name(reader, &view);               \
+                                                                                                            \
+        if (error == INSTRUCTION_READER_READ_ERROR_OK) {                                                    \
+            instruction->header = *view.header;                                                             \
+            memcpy(instruction->operands, view.operands, view.header->number_of_operands);                  \
+        }                                                                                                   \
+                                                                                                            \
+        return error;                                                                                       \
+    }                                                                                                       \
+                                                                                                            \
+    ZDC_STATIC ZDC_FORCE_INLINE void instruction_reader_seek_##name(instruction_reader_t *reader,           \
+                                                                    instruction_reader_offset_t offset,     \
+                                                                    instruction_reader_seek_mode_t mode) {  \
+        instruction_reader_##name##_move((state_type *) reader->sender, offset, mode);                      \
+    }                                                                                                       \
+                                                                                                            \
+    ZDC_STATIC ZDC_FORCE_INLINE instruction_reader_offset_t                                                 \
+    instruction_reader_tell_##name(const instruction_reader_t *reader) {                                    \
+        return instruction_reader_##name##_position((const state_type *) reader->sender);                   \
+    }
+
+#endif // ZODIAC_INSTRUCTION_READER_SPECIALIZE_H
@@ -0,0 +1,24 @@
+/**
+ * @file instruction_view.h
+ * @brief Definition of a non-owning view of an instruction.
+ *
+ * A view refers to the header and operands of an instruction where they already reside
+ * in memory, for instance inside a mapped program file, instead of copying them into
+ * an instruction_t.
+ */
+
+#ifndef ZODIAC_INSTRUCTION_VIEW_H
+#define ZODIAC_INSTRUCTION_VIEW_H
+
+#include "instruction.h"  ///< Include the definition for instruction_header_t
+
+/**
+ * @brief Structure that defines a view of an instruction residing in memory.
+ * The operands pointer refers to exactly `header->number_of_operands` bytes.
+ */
+typedef struct instruction_view_s {
+    const instruction_header_t *header;     ///< Header of the viewed instruction.
+    const instruction_operand_t *operands;  ///< Operands of the viewed instruction.
+} instruction_view_t;
+
+#endif // ZODIAC_INSTRUCTION_VIEW_H
@@ -26,4 +26,14 @@
 #   error "Unknown architecture"  ///< Error directive if the architecture is not recognized.
 #endif
 
+/**
+ * @brief Identifies the instruction set family, used to pick the kernels that can be
+ *        selected at run time, see platform_cpu.h.
+ */
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#   define ZODIAC_PLATFORM_X86    ///< Architecture is x86 or x86-64.
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#   define ZODIAC_PLATFORM_ARM64  ///< Architecture is AArch64.
+#endif
+
 #endif // ZODIAC_PLATFORM_ARCH_H
\ No newline at end of file
@@ -0,0 +1,59 @@
+/**
+ * @file platform_bits.h
+ * @brief Defines portable bit counting helpers for 64-bit words.
+ *
+ * The helpers map to single instructions on compilers providing the corresponding
+ * builtins, with plain C fallbacks elsewhere.
+ */
+
+#ifndef ZODIAC_PLATFORM_BITS_H
+#define ZODIAC_PLATFORM_BITS_H
+
+#include "platform.h"  ///< Include the platform abstraction layer
+
+#if defined(ZODIAC_COMPILER_GCC) || defined(ZODIAC_COMPILER_CLANG) || defined(ZODIAC_COMPILER_LLVM) || \
+    defined(ZODIAC_COMPILER_INTEL)
+/// Defined when the bit counting builtins are available.
+#   define ZODIAC_PLATFORM_BITS_BUILTINS
+#endif
+
+/**
+ * @brief Returns the number of set bits of a word.
+ */
+ZDC_STATIC_INLINE unsigned int platform_bits_count(uint64_t word) {
+#ifdef ZODIAC_PLATFORM_BITS_BUILTINS
+    return (unsigned int) __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & UINT64_C(0x5555555555555555));
+    word = (word & UINT64_C(0x3333333333333333)) + ((word >> 2) & UINT64_C(0x3333333333333333));
+    word = (word + (word >> 4)) & UINT64_C(0x0F0F0F0F0F0F0F0F);
+    return (unsigned int) ((word * UINT64_C(0x0101010101010101)) >> 56);
+#endif
+}
+
+/**
+ * @brief Returns the index of the lowest set bit of a word, which must not be zero.
+ */
+ZDC_STATIC_INLINE unsigned int platform_bits_lowest(uint64_t word) {
+#ifdef ZODIAC_PLATFORM_BITS_BUILTINS
+    return (unsigned int) __builtin_ctzll(word);
+#else
+    return platform_bits_count((word & (0 - word)) - 1);
+#endif
+}
+
+/**
+ * @brief Returns the index of the set bit of a word preceded by `rank` set bits.
+ *
+ * @param[in] word The word, holding more than `rank` set bits.
+ * @param[in] rank Number of set bits below the requested one.
+ */
+ZDC_STATIC_INLINE unsigned int platform_bits_select(uint64_t word, unsigned int rank) {
+    while (rank-- != 0) {
+        word &= word - 1;
+    }
+
+    return platform_bits_lowest(word);
+}
+
+#endif // ZODIAC_PLATFORM_BITS_H
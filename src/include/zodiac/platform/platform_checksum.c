@@ -0,0 +1,104 @@
+#include "platform_checksum.h"
+#include "platform_cpu.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <string.h>
+
+#ifdef ZODIAC_PLATFORM_X86
+#   include <immintrin.h>
+#endif
+
+/// Reflected CRC32C polynomial.
+#define PLATFORM_CHECKSUM_CRC32C_POLYNOMIAL UINT32_C(0x82F63B78)
+
+/**
+ * @brief Signature of the kernels computing CRC32C over inverted checksums.
+ */
+typedef uint32_t (*platform_checksum_kernel_t)(uint32_t crc, const uint8_t *data, size_t size);
+
+/// Remainders of every byte value, filled once by the resolver.
+static uint32_t platform_checksum_table[256];
+
+/// Guards the filling of the lookup table.
+static pthread_once_t platform_checksum_table_once = PTHREAD_ONCE_INIT;
+
+static uint32_t platform_checksum_crc32c_resolve(uint32_t crc, const uint8_t *data, size_t size);
+
+/// The selected kernel, the resolver until the first call.
+static _Atomic(platform_checksum_kernel_t) platform_checksum_kernel = platform_checksum_crc32c_resolve;
+
+/**
+ * @brief Computes CRC32C one byte at a time with the lookup table.
+ */
+static uint32_t platform_checksum_crc32c_table(uint32_t crc, const uint8_t *data, size_t size) {
+    for (size_t index = 0; index < size; ++index) {
+        crc = platform_checksum_table[(crc ^ data[index]) & 0xFF] ^ (crc >> 8);
+    }
+
+    return crc;
+}
+
+#if defined(ZODIAC_PLATFORM_X86) && defined(ZODIAC_COMPILER_TARGET_ATTRIBUTE)
+/**
+ * @brief Computes CRC32C eight bytes at a time with the SSE4.2 CRC32 instruction.
+ */
+ZDC_TARGET("sse4.2")
+static uint32_t platform_checksum_crc32c_sse42(uint32_t crc, const uint8_t *data, size_t size) {
+#ifdef ZODIAC_PLATFORM_64_BIT
+    uint64_t wide = crc;
+    uint64_t word;
+
+    for (; size >= sizeof(word); size -= sizeof(word), data += sizeof(word)) {
+        memcpy(&word, data, sizeof(word));
+        wide = _mm_crc32_u64(wide, word);
+    }
+
+    crc = (uint32_t) wide;
+#endif
+
+    for (; size != 0; --size, ++data) {
+        crc = _mm_crc32_u8(crc, *data);
+    }
+
+    return crc;
+}
+#endif
+
+/**
+ * @brief Fills the lookup table of the table kernel.
+ */
+static void platform_checksum_fill_table(void) {
+    for (uint32_t value = 0; value < 256; ++value) {
+        uint32_t remainder = value;
+
+        for (int bit = 0; bit < 8; ++bit) {
+            remainder = (remainder >> 1) ^ (PLATFORM_CHECKSUM_CRC32C_POLYNOMIAL & (0u - (remainder & 1)));
+        }
+
+        platform_checksum_table[value] = remainder;
+    }
+}
+
+/**
+ * @brief Selects the kernel on the first call and forwards the call to it.
+ */
+static uint32_t platform_checksum_crc32c_resolve(uint32_t crc, const uint8_t *data, size_t size) {
+    platform_checksum_kernel_t kernel = platform_checksum_crc32c_table;
+
+    pthread_once(&platform_checksum_table_once, platform_checksum_fill_table);
+
+#if defined(ZODIAC_PLATFORM_X86) && defined(ZODIAC_COMPILER_TARGET_ATTRIBUTE)
+    if (platform_cpu_has(PLATFORM_CPU_FEATURE_SSE42)) {
+        kernel = platform_checksum_crc32c_sse42;
+    }
+#endif
+
+    atomic_store_explicit(&platform_checksum_kernel, kernel, memory_order_release);
+    return kernel(crc, data, size);
+}
+
+uint32_t platform_checksum_crc32c(uint32_t checksum, const void *data, size_t size) {
+    platform_checksum_kernel_t kernel = atomic_load_explicit(&platform_checksum_kernel, memory_order_acquire);
+    return ~kernel(~checksum, data, size);
+}
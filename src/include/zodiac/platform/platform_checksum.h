@@ -0,0 +1,27 @@
+/**
+ * @file platform_checksum.h
+ * @brief Provides the CRC32C checksum used to verify stored programs.
+ *
+ * CRC32C (Castagnoli) is computed with the SSE4.2 CRC32 instruction when the processor
+ * has it and with a lookup table otherwise; the kernel is selected on the first call,
+ * see platform_cpu.h. Both kernels produce the same checksums.
+ */
+
+#ifndef ZODIAC_PLATFORM_CHECKSUM_H
+#define ZODIAC_PLATFORM_CHECKSUM_H
+
+#include "platform.h"  ///< Include the platform abstraction layer
+
+#include <stddef.h>
+
+/**
+ * @brief Extends a CRC32C checksum with the given bytes.
+ *
+ * @param[in] checksum The checksum of the preceding bytes, 0 for the first bytes.
+ * @param[in] data The bytes to add.
+ * @param[in] size Number of bytes to add.
+ * @return The checksum of the preceding bytes followed by `data`.
+ */
+uint32_t platform_checksum_crc32c(uint32_t checksum, const void *data, size_t size);
+
+#endif // ZODIAC_PLATFORM_CHECKSUM_H
@@ -0,0 +1,60 @@
+/**
+ * @file platform_clock.h
+ * @brief Defines portable accessors for the system clocks.
+ *
+ * The accessors return nanoseconds as 64-bit unsigned integers, which is the unit used
+ * for timestamps throughout the Zodiac runtime.
+ */
+
+#ifndef ZODIAC_PLATFORM_CLOCK_H
+#define ZODIAC_PLATFORM_CLOCK_H
+
+#include "platform.h"  ///< Include the platform abstraction layer
+
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#   include <x86intrin.h>
+#endif
+
+/**
+ * @brief Returns the wall-clock time in nanoseconds since the Unix epoch.
+ */
+ZDC_STATIC_INLINE uint64_t platform_clock_realtime(void) {
+    struct timespec time;
+    timespec_get(&time, TIME_UTC);
+    return (uint64_t) time.tv_sec * 1000000000u + (uint64_t) time.tv_nsec;
+}
+
+/**
+ * @brief Returns a monotonic time in nanoseconds, suitable for measuring intervals.
+ */
+ZDC_STATIC_INLINE uint64_t platform_clock_monotonic(void) {
+    struct timespec time;
+#ifdef CLOCK_MONOTONIC
+    clock_gettime(CLOCK_MONOTONIC, &time);
+#else
+    timespec_get(&time, TIME_UTC);
+#endif
+    return (uint64_t) time.tv_sec * 1000000000u + (uint64_t) time.tv_nsec;
+}
+
+/**
+ * @brief Returns a fast, monotonically increasing cycle count for measuring short intervals.
+ *
+ * Reads the time stamp counter on x86 and the virtual counter on AArch64. Elsewhere it
+ * falls back to platform_clock_monotonic(), so the unit is then nanoseconds.
+ */
+ZDC_STATIC_INLINE uint64_t platform_clock_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t cycles;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(cycles));
+    return cycles;
+#else
+    return platform_clock_monotonic();
+#endif
+}
+
+#endif // ZODIAC_PLATFORM_CLOCK_H
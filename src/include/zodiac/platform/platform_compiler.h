@@ -61,4 +61,23 @@
 #   error "Unknown compiler"
 #endif
 
+/**
+ * @def ZODIAC_COMPILER_COMPUTED_GOTO
+ * Defined when the compiler supports the "labels as values" extension
+ * (`&&label` and `goto *address`), which allows building threaded dispatch tables.
+ */
+#if defined(ZODIAC_COMPILER_GCC) || defined(ZODIAC_COMPILER_CLANG) || defined(ZODIAC_COMPILER_LLVM) || \
+    defined(ZODIAC_COMPILER_INTEL)
+#   define ZODIAC_COMPILER_COMPUTED_GOTO
+#endif
+
+/**
+ * @def ZODIAC_COMPILER_TARGET_ATTRIBUTE
+ * Defined when the compiler can build single functions for an extended instruction set
+ * with `__attribute__((target(...)))`, without enabling it for the whole program.
+ */
+#if defined(ZODIAC_COMPILER_GCC) || defined(ZODIAC_COMPILER_CLANG) || defined(ZODIAC_COMPILER_LLVM)
+#   define ZODIAC_COMPILER_TARGET_ATTRIBUTE
+#endif
+
 #endif // ZODIAC_PLATFORM_COMPILER_H
@@ -50,6 +50,23 @@
 /// Specifies that the structure or union should have the smallest possible alignment.
 #define ZDC_PACKED __attribute__((packed))
 
+#ifdef ZODIAC_COMPILER_TARGET_ATTRIBUTE
+/// Builds a function for the given instruction set extensions, e.g. ZDC_TARGET("avx2").
+#   define ZDC_TARGET(features) __attribute__((target(features)))
+#else
+/// Building single functions for other instruction sets is not supported.
+#   define ZDC_TARGET(features)
+#endif
+
+#if defined(ZODIAC_COMPILER_GCC) || defined(ZODIAC_COMPILER_CLANG) || defined(ZODIAC_COMPILER_LLVM) || \
+    defined(ZODIAC_COMPILER_INTEL)
+/// Hints the processor to load the cache line holding an address, which is about to be read.
+#   define ZDC_PREFETCH(address) __builtin_prefetch((address), 0, 3)
+#else
+/// Prefetching is not supported, the hint is dropped.
+#   define ZDC_PREFETCH(address) ((void) (address))
+#endif
+
 #ifdef ZODIAC_PLATFORM_WINDOWS
 /// Defines the export marker for dynamic linking in Windows.
 #   define ZDC_DLLEXPORT __declspec(dllexport)
@@ -31,6 +31,38 @@
  */
 // #define USE_PLATFORM_BOOL
 
+/**
+ * @def ZODIAC_LOGGER_MIN_LEVEL
+ * @brief Minimum severity compiled into the LOGGER_LOG_* and RUNTIME_LOG_* macros.
+ *
+ * Macros for less severe levels expand to nothing, so neither the call nor the
+ * evaluation of its arguments remains in the binary. The value follows the order of
+ * logger_level_t: 0 for DEBUG, 1 for INFO, 2 for NOTICE, 3 for WARNING, 4 for ERROR,
+ * 5 for CRITICAL, 6 for ALERT and 7 for EMERGENCY. Defaults to 0, keeping every level.
+ * The CMake option ZODIAC_LOGGER_MIN_LEVEL sets it by level name.
+ */
+// #define ZODIAC_LOGGER_MIN_LEVEL 0
+
+/**
+ * @def ZODIAC_PROFILER
+ * @brief Enables the per-operation execution profiler of the executor.
+ *
+ * When defined, the executor counts the hits and cycles of every dispatched operation
+ * into its attached profiler_t. When not defined, the instrumentation is compiled out.
+ * The CMake option ZODIAC_PROFILER defines it.
+ */
+// #define ZODIAC_PROFILER
+
+/**
+ * @def ZODIAC_TRACER
+ * @brief Enables the event tracer of the runtime.
+ *
+ * When defined, executor slices, reader callbacks and logger flushes record begin and
+ * end events into per-thread rings exported as a Chrome trace. When not defined, the
+ * instrumentation is compiled out. The CMake option ZODIAC_TRACER defines it.
+ */
+// #define ZODIAC_TRACER
+
 // -------------------------------------------------------------------------------
 // End of platform configuration
 // -------------------------------------------------------------------------------
@@ -43,4 +75,8 @@
 #   include <stdbool.h> ///< Include standard boolean type if USE_PLATFORM_BOOL is not defined.
 #endif
 
+#ifndef ZODIAC_LOGGER_MIN_LEVEL
+#   define ZODIAC_LOGGER_MIN_LEVEL 0 ///< Keep every logging level if ZODIAC_LOGGER_MIN_LEVEL is not defined.
+#endif
+
 #endif // ZODIAC_PLATFORM_CONFIG_H
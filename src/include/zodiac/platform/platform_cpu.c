@@ -0,0 +1,130 @@
+#include "platform_cpu.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#ifdef ZODIAC_PLATFORM_X86
+#   include <cpuid.h>
+#endif
+
+/// Marks the cached features as detected, above any feature bit.
+#define PLATFORM_CPU_DETECTED (UINT32_C(1) << 31)
+
+/// Detected features with PLATFORM_CPU_DETECTED, 0 until the processor is queried.
+static atomic_uint_fast32_t platform_cpu_detected_features;
+
+/// Features kept by platform_cpu_restrict().
+static atomic_uint_fast32_t platform_cpu_allowed_features = UINT32_MAX;
+
+#ifdef ZODIAC_PLATFORM_X86
+/**
+ * @brief Reads the extended control register telling which register states the OS saves.
+ */
+static uint64_t platform_cpu_xgetbv(void) {
+    uint32_t low;
+    uint32_t high;
+
+    __asm__ volatile ("xgetbv" : "=a" (low), "=d" (high) : "c" (0));
+    return ((uint64_t) high << 32) | low;
+}
+#endif
+
+/**
+ * @brief Queries the processor for its extensions.
+ */
+static platform_cpu_features_t platform_cpu_detect(void) {
+    platform_cpu_features_t features = 0;
+
+#ifdef ZODIAC_PLATFORM_X86
+    unsigned int eax;
+    unsigned int ebx;
+    unsigned int ecx;
+    unsigned int edx;
+    unsigned int max_leaf = __get_cpuid_max(0, nullptr);
+    uint64_t xcr0 = 0;
+
+    if (max_leaf < 1 || !__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return 0;
+    }
+
+    if (edx & bit_SSE2) {
+        features |= PLATFORM_CPU_FEATURE_SSE2;
+    }
+
+    if (ecx & bit_SSE4_2) {
+        features |= PLATFORM_CPU_FEATURE_SSE42;
+    }
+
+    // Vector extensions are only usable when the OS saves the wider registers.
+    if (ecx & bit_OSXSAVE) {
+        xcr0 = platform_cpu_xgetbv();
+    }
+
+    if (max_leaf >= 7 && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        bool avx_state = (xcr0 & 0x6) == 0x6;
+        bool avx512_state = (xcr0 & 0xE6) == 0xE6;
+
+        if (avx_state && (ebx & bit_AVX2)) {
+            features |= PLATFORM_CPU_FEATURE_AVX2;
+        }
+
+        if (avx512_state && (ebx & bit_AVX512F)) {
+            features |= PLATFORM_CPU_FEATURE_AVX512F;
+
+            if (ebx & bit_AVX512BW) {
+                features |= PLATFORM_CPU_FEATURE_AVX512BW;
+            }
+        }
+
+        if (ebx & bit_BMI2) {
+            features |= PLATFORM_CPU_FEATURE_BMI2;
+        }
+    }
+#endif
+
+    return features;
+}
+
+platform_cpu_features_t platform_cpu_features(void) {
+    uint_fast32_t features = atomic_load_explicit(&platform_cpu_detected_features, memory_order_relaxed);
+    const char *mask;
+
+    if (features == 0) {
+        features = platform_cpu_detect();
+
+        mask = getenv("ZODIAC_CPU_FEATURES");
+        if (mask != nullptr && *mask != '\0') {
+            features &= (uint_fast32_t) strtoul(mask, nullptr, 16);
+        }
+
+        // Racing threads detect the same features, so the last store wins harmlessly.
+        atomic_store_explicit(&platform_cpu_detected_features, features | PLATFORM_CPU_DETECTED,
+                              memory_order_relaxed);
+    }
+
+    return (platform_cpu_features_t) (features & ~PLATFORM_CPU_DETECTED
+                                      & atomic_load_explicit(&platform_cpu_allowed_features, memory_order_relaxed));
+}
+
+void platform_cpu_restrict(platform_cpu_features_t features) {
+    atomic_store_explicit(&platform_cpu_allowed_features, features, memory_order_relaxed);
+}
+
+const char *platform_cpu_feature_name(platform_cpu_feature_t feature) {
+    switch (feature) {
+        case PLATFORM_CPU_FEATURE_SSE2:
+            return "sse2";
+        case PLATFORM_CPU_FEATURE_SSE42:
+            return "sse4.2";
+        case PLATFORM_CPU_FEATURE_AVX2:
+            return "avx2";
+        case PLATFORM_CPU_FEATURE_AVX512F:
+            return "avx512f";
+        case PLATFORM_CPU_FEATURE_AVX512BW:
+            return "avx512bw";
+        case PLATFORM_CPU_FEATURE_BMI2:
+            return "bmi2";
+        default:
+            return "unknown";
+    }
+}
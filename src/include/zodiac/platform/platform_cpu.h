@@ -0,0 +1,76 @@
+/**
+ * @file platform_cpu.h
+ * @brief Detects the instruction set extensions of the processor at run time.
+ *
+ * A single binary built for the baseline instruction set selects faster kernels on
+ * processors that support them. Kernels built with ZDC_TARGET() are reached through a
+ * function pointer that starts at a resolver: the first call asks platform_cpu_features()
+ * for the extensions, stores the best kernel in the pointer and forwards the call, so
+ * later calls go straight to the selected kernel.
+ *
+ * The detected extensions can be narrowed with platform_cpu_restrict() before the first
+ * kernel is resolved, or with the ZODIAC_CPU_FEATURES environment variable holding the
+ * hexadecimal mask of the allowed extensions, e.g. ZODIAC_CPU_FEATURES=0 for the
+ * baseline kernels only.
+ */
+
+#ifndef ZODIAC_PLATFORM_CPU_H
+#define ZODIAC_PLATFORM_CPU_H
+
+#include "platform.h"  ///< Include the platform abstraction layer
+
+/**
+ * @enum platform_cpu_feature_e
+ * @brief Enumerates the instruction set extensions kernels are selected by.
+ */
+typedef enum platform_cpu_feature_e {
+    PLATFORM_CPU_FEATURE_SSE2      = 1u << 0,   ///< SSE2 128-bit integer vectors.
+    PLATFORM_CPU_FEATURE_SSE42     = 1u << 1,   ///< SSE4.2, including the CRC32C instructions.
+    PLATFORM_CPU_FEATURE_AVX2      = 1u << 2,   ///< AVX2 256-bit integer vectors.
+    PLATFORM_CPU_FEATURE_AVX512F   = 1u << 3,   ///< AVX-512 foundation.
+    PLATFORM_CPU_FEATURE_AVX512BW  = 1u << 4,   ///< AVX-512 byte and word vectors.
+    PLATFORM_CPU_FEATURE_BMI2      = 1u << 5    ///< BMI2 bit manipulation.
+} platform_cpu_feature_t;
+
+/**
+ * @brief Bit set of platform_cpu_feature_t values.
+ */
+typedef uint32_t platform_cpu_features_t;
+
+/**
+ * @brief Returns the extensions the processor and the operating system support.
+ *
+ * The processor is queried once; later calls return the cached result.
+ *
+ * @return The supported extensions, narrowed by platform_cpu_restrict() and ZODIAC_CPU_FEATURES.
+ */
+platform_cpu_features_t platform_cpu_features(void);
+
+/**
+ * @brief Returns whether all of the given extensions are supported.
+ *
+ * @param[in] features The extensions to test.
+ * @return Whether every extension is supported.
+ */
+ZDC_STATIC_INLINE bool platform_cpu_has(platform_cpu_features_t features) {
+    return (platform_cpu_features() & features) == features;
+}
+
+/**
+ * @brief Narrows the extensions reported by platform_cpu_features().
+ *
+ * Only affects kernels resolved afterwards, so it is meant to be called at startup.
+ *
+ * @param[in] features The extensions kernels may use.
+ */
+void platform_cpu_restrict(platform_cpu_features_t features);
+
+/**
+ * @brief Returns the name of an extension.
+ *
+ * @param[in] feature A single extension.
+ * @return The lower-case name of the extension, or "unknown".
+ */
+const char *platform_cpu_feature_name(platform_cpu_feature_t feature);
+
+#endif // ZODIAC_PLATFORM_CPU_H
@@ -0,0 +1,282 @@
+#include "platform_memory.h"
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Rounds a size up to a multiple of PLATFORM_MEMORY_ALIGNMENT.
+#define PLATFORM_MEMORY_ALIGN(size) \
+    (((size) + PLATFORM_MEMORY_ALIGNMENT - 1) & ~(PLATFORM_MEMORY_ALIGNMENT - 1))
+
+/// Offset of the memory of a chunk from its header.
+#define PLATFORM_ARENA_CHUNK_HEADER_SIZE PLATFORM_MEMORY_ALIGN(sizeof(platform_arena_chunk_t))
+
+/// Size of the header storing the size of the blocks handed out by the allocator of an arena.
+#define PLATFORM_ARENA_BLOCK_HEADER_SIZE PLATFORM_MEMORY_ALIGN(sizeof(size_t))
+
+static void *platform_memory_malloc(callback_sender sender, size_t size) {
+    (void) sender;
+    return malloc(size);
+}
+
+static void *platform_memory_realloc(callback_sender sender, void *memory, size_t size) {
+    (void) sender;
+    return realloc(memory, size);
+}
+
+static void platform_memory_free(callback_sender sender, void *memory) {
+    (void) sender;
+    free(memory);
+}
+
+/// The allocator used when nullptr is given.
+static platform_allocator_t platform_memory_default_allocator = {
+        nullptr, platform_memory_malloc, platform_memory_realloc, platform_memory_free
+};
+
+/// Whether the default allocator was used, after which it can no longer be replaced.
+static atomic_bool platform_memory_default_allocator_used;
+
+/**
+ * @brief Returns the default allocator, marking it as used.
+ */
+static const platform_allocator_t *platform_memory_use_default_allocator(void) {
+    // Loading first keeps the cache line shared once the flag is set.
+    if (!atomic_load_explicit(&platform_memory_default_allocator_used, memory_order_relaxed)) {
+        atomic_store_explicit(&platform_memory_default_allocator_used, true, memory_order_relaxed);
+    }
+
+    return &platform_memory_default_allocator;
+}
+
+bool platform_memory_set_default_allocator(const platform_allocator_t *allocator) {
+    static const platform_allocator_t system_allocator = {
+            nullptr, platform_memory_malloc, platform_memory_realloc, platform_memory_free
+    };
+
+    assert(!atomic_load(&platform_memory_default_allocator_used)
+           && "the default allocator must be replaced before it is used");
+
+    if (atomic_load(&platform_memory_default_allocator_used)) {
+        return false;
+    }
+
+    platform_memory_default_allocator = allocator != nullptr ? *allocator : system_allocator;
+    return true;
+}
+
+void *platform_memory_allocate(const platform_allocator_t *allocator, size_t size) {
+    if (allocator == nullptr) {
+        allocator = platform_memory_use_default_allocator();
+    }
+
+    return allocator->allocate(allocator->sender, size);
+}
+
+void *platform_memory_allocate_zeroed(const platform_allocator_t *allocator, size_t size) {
+    void *memory = platform_memory_allocate(allocator, size);
+
+    if (memory != nullptr) {
+        memset(memory, 0, size);
+    }
+
+    return memory;
+}
+
+void *platform_memory_reallocate(const platform_allocator_t *allocator, void *memory, size_t size) {
+    if (allocator == nullptr) {
+        allocator = platform_memory_use_default_allocator();
+    }
+
+    return allocator->reallocate(allocator->sender, memory, size);
+}
+
+void platform_memory_release(const platform_allocator_t *allocator, void *memory) {
+    if (memory == nullptr) {
+        return;
+    }
+
+    if (allocator == nullptr) {
+        allocator = platform_memory_use_default_allocator();
+    }
+
+    allocator->release(allocator->sender, memory);
+}
+
+static void *platform_arena_allocator_allocate(callback_sender sender, size_t size) {
+    uint8_t *block = platform_arena_allocate(sender, PLATFORM_ARENA_BLOCK_HEADER_SIZE + size);
+
+    if (block == nullptr) {
+        return nullptr;
+    }
+
+    *(size_t *) block = size;
+    return block + PLATFORM_ARENA_BLOCK_HEADER_SIZE;
+}
+
+static void *platform_arena_allocator_reallocate(callback_sender sender, void *memory, size_t size) {
+    size_t previous_size;
+    void *block;
+
+    if (memory == nullptr) {
+        return platform_arena_allocator_allocate(sender, size);
+    }
+
+    previous_size = *(size_t *) ((uint8_t *) memory - PLATFORM_ARENA_BLOCK_HEADER_SIZE);
+    if (size <= previous_size) {
+        return memory;
+    }
+
+    block = platform_arena_allocator_allocate(sender, size);
+    if (block != nullptr) {
+        memcpy(block, memory, previous_size);
+    }
+
+    return block;
+}
+
+static void platform_arena_allocator_release(callback_sender sender, void *memory) {
+    (void) sender;
+    (void) memory;
+}
+
+void platform_arena_init(platform_arena_t *arena, const platform_allocator_t *parent, size_t chunk_size) {
+    arena->parent = parent;
+    arena->chunk = nullptr;
+    arena->chunk_size = chunk_size != 0 ? chunk_size : PLATFORM_ARENA_DEFAULT_CHUNK_SIZE;
+    arena->allocator.sender = arena;
+    arena->allocator.allocate = platform_arena_allocator_allocate;
+    arena->allocator.reallocate = platform_arena_allocator_reallocate;
+    arena->allocator.release = platform_arena_allocator_release;
+}
+
+void *platform_arena_allocate(platform_arena_t *arena, size_t size) {
+    platform_arena_chunk_t *chunk = arena->chunk;
+    uint8_t *memory;
+
+    size = PLATFORM_MEMORY_ALIGN(size);
+
+    if (chunk == nullptr || chunk->size - chunk->used < size) {
+        size_t chunk_size = size > arena->chunk_size ? size : arena->chunk_size;
+
+        chunk = platform_memory_allocate(arena->parent, PLATFORM_ARENA_CHUNK_HEADER_SIZE + chunk_size);
+        if (chunk == nullptr) {
+            return nullptr;
+        }
+
+        chunk->previous = arena->chunk;
+        chunk->size = chunk_size;
+        chunk->used = 0;
+        arena->chunk = chunk;
+    }
+
+    memory = (uint8_t *) chunk + PLATFORM_ARENA_CHUNK_HEADER_SIZE + chunk->used;
+    chunk->used += size;
+    return memory;
+}
+
+void platform_arena_reset(platform_arena_t *arena) {
+    platform_arena_chunk_t *largest = arena->chunk;
+    platform_arena_chunk_t *chunk = arena->chunk;
+
+    while (chunk != nullptr) {
+        platform_arena_chunk_t *previous = chunk->previous;
+
+        if (chunk != largest) {
+            if (chunk->size > largest->size) {
+                platform_memory_release(arena->parent, largest);
+                largest = chunk;
+            } else {
+                platform_memory_release(arena->parent, chunk);
+            }
+        }
+
+        chunk = previous;
+    }
+
+    if (largest != nullptr) {
+        largest->previous = nullptr;
+        largest->used = 0;
+    }
+
+    arena->chunk = largest;
+}
+
+void platform_arena_free(platform_arena_t *arena) {
+    platform_arena_chunk_t *chunk = arena->chunk;
+
+    while (chunk != nullptr) {
+        platform_arena_chunk_t *previous = chunk->previous;
+        platform_memory_release(arena->parent, chunk);
+        chunk = previous;
+    }
+
+    arena->chunk = nullptr;
+}
+
+void platform_pool_init(platform_pool_t *pool,
+                        const platform_allocator_t *parent,
+                        size_t object_size,
+                        size_t objects_per_slab) {
+
+    pool->parent = parent;
+    pool->slabs = nullptr;
+    pool->free_list = nullptr;
+    pool->object_size = PLATFORM_MEMORY_ALIGN(object_size > sizeof(void *) ? object_size : sizeof(void *));
+    pool->objects_per_slab = objects_per_slab != 0 ? objects_per_slab : PLATFORM_POOL_DEFAULT_OBJECTS_PER_SLAB;
+    pool->number_of_objects = 0;
+}
+
+void *platform_pool_allocate(platform_pool_t *pool) {
+    void *object = pool->free_list;
+
+    if (object == nullptr) {
+        // Carve a new slab: its first aligned word links the slabs, the objects follow.
+        uint8_t *slab = platform_memory_allocate(pool->parent,
+                                                 PLATFORM_MEMORY_ALIGNMENT +
+                                                 pool->object_size * pool->objects_per_slab);
+        if (slab == nullptr) {
+            return nullptr;
+        }
+
+        *(void **) slab = pool->slabs;
+        pool->slabs = slab;
+
+        for (size_t index = pool->objects_per_slab; index-- > 0;) {
+            uint8_t *carved = slab + PLATFORM_MEMORY_ALIGNMENT + index * pool->object_size;
+            *(void **) carved = pool->free_list;
+            pool->free_list = carved;
+        }
+
+        object = pool->free_list;
+    }
+
+    pool->free_list = *(void **) object;
+    ++pool->number_of_objects;
+    return object;
+}
+
+void platform_pool_release(platform_pool_t *pool, void *object) {
+    if (object == nullptr) {
+        return;
+    }
+
+    *(void **) object = pool->free_list;
+    pool->free_list = object;
+    --pool->number_of_objects;
+}
+
+void platform_pool_free(platform_pool_t *pool) {
+    void *slab = pool->slabs;
+
+    while (slab != nullptr) {
+        void *next = *(void **) slab;
+        platform_memory_release(pool->parent, slab);
+        slab = next;
+    }
+
+    pool->slabs = nullptr;
+    pool->free_list = nullptr;
+    pool->number_of_objects = 0;
+}
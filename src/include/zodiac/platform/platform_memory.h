@@ -0,0 +1,236 @@
+/**
+ * @file platform_memory.h
+ * @brief Defines the memory management abstraction of the Zodiac platform layer.
+ *
+ * Every allocation of the runtime goes through a platform_allocator_t. Components that
+ * own memory accept an allocator, nullptr standing for the process-wide default, which
+ * wraps malloc() unless replaced with platform_memory_set_default_allocator() at startup.
+ *
+ * Two allocators are provided on top of it:
+ * - a bump arena, which hands out memory from large chunks and releases everything at
+ *   once with platform_arena_reset(), so tearing down a VM instance is a single call;
+ * - a slab pool, which recycles objects of one fixed size through a free list.
+ *
+ * Arenas and pools are not synchronized; give each thread or VM instance its own, which
+ * also keeps instances from contending on the global heap.
+ */
+
+#ifndef ZODIAC_PLATFORM_MEMORY_H
+#define ZODIAC_PLATFORM_MEMORY_H
+
+#include "platform.h"  ///< Include the platform abstraction layer
+
+#include <stddef.h>
+
+/**
+ * @brief Alignment of the memory returned by the allocators.
+ */
+#define PLATFORM_MEMORY_ALIGNMENT (_Alignof(max_align_t))
+
+/**
+ * @brief Default size of the chunks of an arena in bytes.
+ */
+#define PLATFORM_ARENA_DEFAULT_CHUNK_SIZE (64 * 1024)
+
+/**
+ * @brief Default number of objects of the slabs of a pool.
+ */
+#define PLATFORM_POOL_DEFAULT_OBJECTS_PER_SLAB 64
+
+/**
+ * @typedef platform_allocate_callback_t
+ * @brief Allocates `size` bytes aligned to PLATFORM_MEMORY_ALIGNMENT, or returns nullptr.
+ */
+typedef void *(*platform_allocate_callback_t)(callback_sender sender, size_t size);
+
+/**
+ * @typedef platform_reallocate_callback_t
+ * @brief Resizes a block to `size` bytes like realloc(), or returns nullptr leaving it untouched.
+ */
+typedef void *(*platform_reallocate_callback_t)(callback_sender sender, void *memory, size_t size);
+
+/**
+ * @typedef platform_release_callback_t
+ * @brief Releases a block; nullptr is ignored.
+ */
+typedef void (*platform_release_callback_t)(callback_sender sender, void *memory);
+
+/**
+ * @struct platform_allocator_s
+ * @brief Represents a source of memory.
+ */
+typedef struct platform_allocator_s {
+    callback_sender sender;                       ///< Passed to the callbacks.
+    platform_allocate_callback_t allocate;        ///< Allocates a block.
+    platform_reallocate_callback_t reallocate;    ///< Resizes a block.
+    platform_release_callback_t release;          ///< Releases a block.
+} platform_allocator_t;
+
+/**
+ * @struct platform_arena_chunk_s
+ * @brief Header of a chunk of an arena, followed by its memory.
+ */
+typedef struct platform_arena_chunk_s {
+    struct platform_arena_chunk_s *previous;   ///< The chunk filled before this one.
+    size_t size;                               ///< Number of bytes following the header.
+    size_t used;                               ///< Number of bytes handed out.
+} platform_arena_chunk_t;
+
+/**
+ * @struct platform_arena_s
+ * @brief Represents a bump arena.
+ */
+typedef struct platform_arena_s {
+    const platform_allocator_t *parent;   ///< Source of the chunks, nullptr for the default allocator.
+    platform_arena_chunk_t *chunk;        ///< The chunk memory is handed out from.
+    size_t chunk_size;                    ///< Minimum size of new chunks in bytes.
+    platform_allocator_t allocator;       ///< Allocator handing out memory from the arena.
+} platform_arena_t;
+
+/**
+ * @struct platform_pool_s
+ * @brief Represents a pool of fixed-size objects.
+ */
+typedef struct platform_pool_s {
+    const platform_allocator_t *parent;   ///< Source of the slabs, nullptr for the default allocator.
+    void *slabs;                          ///< The slabs, linked through their first word.
+    void *free_list;                      ///< The released objects, linked through their first word.
+    size_t object_size;                   ///< Size of the objects, rounded up to the alignment.
+    size_t objects_per_slab;              ///< Number of objects carved from each slab.
+    size_t number_of_objects;             ///< Number of objects handed out and not released.
+} platform_pool_t;
+
+/**
+ * @brief Replaces the default allocator of the process.
+ *
+ * Only possible before the default allocator is first used, since blocks are released
+ * through the allocator that was the default when they were allocated and other threads
+ * may be using it. Later calls are refused, and fail an assertion in debug builds.
+ * Components needing a different allocator afterwards take it explicitly instead.
+ *
+ * @param allocator The new default allocator, copied, or nullptr to restore malloc().
+ * @return Whether the default allocator was replaced.
+ */
+bool platform_memory_set_default_allocator(const platform_allocator_t *allocator);
+
+/**
+ * @brief Allocates a block.
+ *
+ * @param allocator The allocator, or nullptr for the default allocator.
+ * @param size Number of bytes.
+ * @return The block, or nullptr if it could not be allocated.
+ */
+void *platform_memory_allocate(const platform_allocator_t *allocator, size_t size);
+
+/**
+ * @brief Allocates a zero-filled block.
+ *
+ * @param allocator The allocator, or nullptr for the default allocator.
+ * @param size Number of bytes.
+ * @return The block, or nullptr if it could not be allocated.
+ */
+void *platform_memory_allocate_zeroed(const platform_allocator_t *allocator, size_t size);
+
+/**
+ * @brief Resizes a block, keeping its content up to the smaller of both sizes.
+ *
+ * @param allocator The allocator of the block, or nullptr for the default allocator.
+ * @param memory The block, or nullptr to allocate a new one.
+ * @param size New number of bytes.
+ * @return The resized block, or nullptr if it could not be resized, leaving it untouched.
+ */
+void *platform_memory_reallocate(const platform_allocator_t *allocator, void *memory, size_t size);
+
+/**
+ * @brief Releases a block.
+ *
+ * @param allocator The allocator of the block, or nullptr for the default allocator.
+ * @param memory The block, or nullptr.
+ */
+void platform_memory_release(const platform_allocator_t *allocator, void *memory);
+
+/**
+ * @brief Initializes an empty arena.
+ *
+ * @param arena Pointer to the arena to initialize.
+ * @param parent Source of the chunks, or nullptr for the default allocator.
+ * @param chunk_size Minimum size of the chunks, or 0 for PLATFORM_ARENA_DEFAULT_CHUNK_SIZE.
+ */
+void platform_arena_init(platform_arena_t *arena, const platform_allocator_t *parent, size_t chunk_size);
+
+/**
+ * @brief Hands out memory from an arena.
+ *
+ * @param arena Pointer to the arena.
+ * @param size Number of bytes.
+ * @return The memory, aligned to PLATFORM_MEMORY_ALIGNMENT, or nullptr if a chunk could not be allocated.
+ */
+void *platform_arena_allocate(platform_arena_t *arena, size_t size);
+
+/**
+ * @brief Releases everything handed out by an arena at once.
+ *
+ * The largest chunk is kept for reuse, the others are returned to the parent allocator.
+ *
+ * @param arena Pointer to the arena.
+ */
+void platform_arena_reset(platform_arena_t *arena);
+
+/**
+ * @brief Returns every chunk of an arena to the parent allocator.
+ *
+ * @param arena Pointer to the arena.
+ */
+void platform_arena_free(platform_arena_t *arena);
+
+/**
+ * @brief Returns an allocator handing out memory from an arena.
+ *
+ * Blocks released through it are only reclaimed when the arena is reset; resizing
+ * copies into a new block. Any component accepting an allocator can thus place its
+ * memory in the arena of a VM instance.
+ *
+ * @param arena Pointer to the arena, which must outlive the allocator.
+ * @return The allocator.
+ */
+ZDC_STATIC_INLINE const platform_allocator_t *platform_arena_allocator(const platform_arena_t *arena) {
+    return &arena->allocator;
+}
+
+/**
+ * @brief Initializes an empty pool.
+ *
+ * @param pool Pointer to the pool to initialize.
+ * @param parent Source of the slabs, or nullptr for the default allocator.
+ * @param object_size Size of the objects in bytes.
+ * @param objects_per_slab Number of objects per slab, or 0 for PLATFORM_POOL_DEFAULT_OBJECTS_PER_SLAB.
+ */
+void platform_pool_init(platform_pool_t *pool,
+                        const platform_allocator_t *parent,
+                        size_t object_size,
+                        size_t objects_per_slab);
+
+/**
+ * @brief Takes an object from a pool.
+ *
+ * @param pool Pointer to the pool.
+ * @return The object, or nullptr if a slab could not be allocated.
+ */
+void *platform_pool_allocate(platform_pool_t *pool);
+
+/**
+ * @brief Returns an object to its pool.
+ *
+ * @param pool Pointer to the pool.
+ * @param object The object, or nullptr.
+ */
+void platform_pool_release(platform_pool_t *pool, void *object);
+
+/**
+ * @brief Returns every slab of a pool to the parent allocator.
+ *
+ * @param pool Pointer to the pool.
+ */
+void platform_pool_free(platform_pool_t *pool);
+
+#endif // ZODIAC_PLATFORM_MEMORY_H
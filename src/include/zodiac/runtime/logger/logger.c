@@ -3,8 +3,15 @@
 void logger_init(logger_t *logger, callback_sender_t sender, logger_log_callback_t log_callback) {
     logger->sender = sender;
     logger->log_callback = log_callback;
+    logger->level = LOGGER_LEVEL_DEBUG;
+}
+
+void logger_set_level(logger_t *logger, logger_level_t logger_level) {
+    logger->level = logger_level;
 }
 
 void logger_log(logger_t *logger, logger_level_t logger_level, const char *message) {
-    logger->log_callback(logger->sender, logger_level, message);
+    if (logger_is_enabled(logger, logger_level)) {
+        logger->log_callback(logger->sender, logger_level, message);
+    }
 }
@@ -33,28 +33,51 @@ typedef void(*logger_log_callback_t)(callback_sender_t sender, logger_level_t lo
  * @brief Represents a logger with a callback for logging messages.
  *
  * This structure is used for maintaining the state of a logger, including
- * its source (sender) and the associated callback function that performs
- * the actual logging.
+ * its source (sender), the associated callback function that performs
+ * the actual logging and the minimum level of the messages it accepts.
  */
 typedef struct logger_s {
     callback_sender_t sender;             /*!< The source associated with the logger */
     logger_log_callback_t log_callback;   /*!< The callback function for logging messages */
+    logger_level_t level;                 /*!< Messages below this level are discarded */
 } logger_t;
 
 /**
  * @brief Initializes the logger with a provided sender and log callback function.
  *
+ * The logger accepts messages of every level until logger_set_level() is called.
+ *
  * @param logger Pointer to the logger to initialize.
  * @param sender Instance of the sender to associate this logger with.
  * @param log_callback The function to be called when a log message is generated.
  */
 void logger_init(logger_t *logger, callback_sender_t sender, logger_log_callback_t log_callback);
 
+/**
+ * @brief Sets the minimum level of the messages a logger accepts.
+ *
+ * @param logger Pointer to the logger.
+ * @param logger_level Messages below this level are discarded.
+ */
+void logger_set_level(logger_t *logger, logger_level_t logger_level);
+
+/**
+ * @brief Tells whether a logger accepts messages of a specified severity level.
+ *
+ * @param logger Pointer to the logger.
+ * @param logger_level The severity level to check.
+ * @return Whether messages of this level reach the logging callback.
+ */
+ZDC_STATIC_INLINE bool logger_is_enabled(const logger_t *logger, logger_level_t logger_level) {
+    return logger_level >= logger->level;
+}
+
 /**
  * @brief Logs a message with a specified severity level.
  *
  * This function will call the registered logging callback (if any) with
- * the specified logger, level, and message.
+ * the specified logger, level, and message, provided the logger accepts
+ * the level.
  *
  * @param logger Pointer to the logger to use for the log message.
  * @param logger_level The severity level of the log message.
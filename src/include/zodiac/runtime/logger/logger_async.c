@@ -0,0 +1,239 @@
+#include "logger_async.h"
+#include "../../platform/platform_clock.h"
+#include "../../platform/platform_memory.h"
+#include "../tracer/tracer.h"
+
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief Delivers the next message of the ring, if any.
+ *
+ * @return Whether a message was delivered.
+ */
+static bool logger_async_drain_one(logger_async_t *async) {
+    size_t position = atomic_load_explicit(&async->dequeue_position, memory_order_relaxed);
+    logger_async_entry_t *entry = &async->entries[position & async->mask];
+
+    if (atomic_load_explicit(&entry->sequence, memory_order_acquire) != position + 1) {
+        return false;
+    }
+
+    async->timestamp = entry->timestamp;
+
+    TRACER_BEGIN("logger.write");
+    logger_log(&async->target, entry->level, entry->message);
+    TRACER_END("logger.write");
+
+    atomic_store_explicit(&entry->sequence, position + async->mask + 1, memory_order_release);
+    atomic_store_explicit(&async->dequeue_position, position + 1, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Parks the writer thread until a message is published or the logger is stopped.
+ *
+ * Producers only take the mutex when they see writer_waiting set, so the flag is raised
+ * before the ring is checked a last time; a message published after the check finds it
+ * raised and signals under the mutex, which the writer only releases by waiting.
+ */
+static void logger_async_wait(logger_async_t *async) {
+    size_t position;
+
+    pthread_mutex_lock(&async->mutex);
+    atomic_store(&async->writer_waiting, true);
+
+    position = atomic_load_explicit(&async->dequeue_position, memory_order_relaxed);
+    if (atomic_load(&async->running)
+        && atomic_load(&async->entries[position & async->mask].sequence) != position + 1) {
+        pthread_cond_wait(&async->published, &async->mutex);
+    }
+
+    atomic_store_explicit(&async->writer_waiting, false, memory_order_relaxed);
+    pthread_mutex_unlock(&async->mutex);
+}
+
+/**
+ * @brief Wakes the writer thread up if it is parked.
+ */
+static void logger_async_wake(logger_async_t *async) {
+    if (atomic_load(&async->writer_waiting)) {
+        pthread_mutex_lock(&async->mutex);
+        pthread_cond_signal(&async->published);
+        pthread_mutex_unlock(&async->mutex);
+    }
+}
+
+/**
+ * @brief Reports the messages discarded since the previous report.
+ */
+static void logger_async_report_dropped(logger_async_t *async) {
+    char message[LOGGER_ASYNC_MESSAGE_SIZE];
+    uint_fast64_t number_of_dropped_messages;
+
+    if (async->overflow != LOGGER_ASYNC_OVERFLOW_COUNT) {
+        return;
+    }
+
+    number_of_dropped_messages = atomic_exchange_explicit(&async->number_of_dropped_messages, 0,
+                                                          memory_order_relaxed);
+    if (number_of_dropped_messages == 0) {
+        return;
+    }
+
+    snprintf(message, sizeof(message), "%llu log messages dropped, the logger ring was full",
+             (unsigned long long) number_of_dropped_messages);
+
+    async->timestamp = platform_clock_realtime();
+    logger_log(&async->target, LOGGER_LEVEL_WARNING, message);
+}
+
+/**
+ * @brief Entry point of the writer thread.
+ */
+static void *logger_async_writer(void *argument) {
+    logger_async_t *async = argument;
+
+    while (atomic_load_explicit(&async->running, memory_order_acquire)) {
+        if (!logger_async_drain_one(async)) {
+            logger_async_report_dropped(async);
+            logger_async_wait(async);
+        }
+    }
+
+    while (logger_async_drain_one(async)) {
+    }
+
+    logger_async_report_dropped(async);
+    return nullptr;
+}
+
+void logger_async_options_init(logger_async_options_t *options) {
+    options->capacity = LOGGER_ASYNC_DEFAULT_CAPACITY;
+    options->overflow = LOGGER_ASYNC_OVERFLOW_COUNT;
+}
+
+logger_async_error_t logger_async_start(logger_async_t *async,
+                                        callback_sender_t sender,
+                                        logger_log_callback_t log_callback,
+                                        const logger_async_options_t *options) {
+
+    logger_async_options_t defaults;
+    size_t capacity = 1;
+
+    if (options == nullptr) {
+        logger_async_options_init(&defaults);
+        options = &defaults;
+    }
+
+    while (capacity < options->capacity) {
+        capacity <<= 1;
+    }
+
+    async->entries = platform_memory_allocate(nullptr, capacity * sizeof(logger_async_entry_t));
+    if (async->entries == nullptr) {
+        return LOGGER_ASYNC_ERROR_MEMORY;
+    }
+
+    for (size_t index = 0; index < capacity; ++index) {
+        atomic_init(&async->entries[index].sequence, index);
+    }
+
+    logger_init(&async->target, sender, log_callback);
+    async->mask = capacity - 1;
+    async->overflow = options->overflow;
+    async->timestamp = 0;
+    atomic_init(&async->enqueue_position, 0);
+    atomic_init(&async->dequeue_position, 0);
+    atomic_init(&async->number_of_dropped_messages, 0);
+    atomic_init(&async->running, true);
+    atomic_init(&async->writer_waiting, false);
+    pthread_mutex_init(&async->mutex, nullptr);
+    pthread_cond_init(&async->published, nullptr);
+
+    if (pthread_create(&async->thread, nullptr, logger_async_writer, async) != 0) {
+        pthread_cond_destroy(&async->published);
+        pthread_mutex_destroy(&async->mutex);
+        platform_memory_release(nullptr, async->entries);
+        async->entries = nullptr;
+        return LOGGER_ASYNC_ERROR_THREAD;
+    }
+
+    return LOGGER_ASYNC_ERROR_OK;
+}
+
+void logger_async_stop(logger_async_t *async) {
+    pthread_mutex_lock(&async->mutex);
+    atomic_store(&async->running, false);
+    pthread_cond_signal(&async->published);
+    pthread_mutex_unlock(&async->mutex);
+    pthread_join(async->thread, nullptr);
+
+    pthread_cond_destroy(&async->published);
+    pthread_mutex_destroy(&async->mutex);
+
+    platform_memory_release(nullptr, async->entries);
+    async->entries = nullptr;
+}
+
+void logger_async_flush(logger_async_t *async) {
+    size_t position = atomic_load_explicit(&async->enqueue_position, memory_order_acquire);
+
+    TRACER_BEGIN("logger.flush");
+
+    while (atomic_load_explicit(&async->dequeue_position, memory_order_acquire) < position) {
+        sched_yield();
+    }
+
+    TRACER_END("logger.flush");
+}
+
+void logger_init_async(logger_t *logger, logger_async_t *async) {
+    logger_init(logger, async, logger_async_log);
+}
+
+void logger_async_log(callback_sender_t sender, logger_level_t logger_level, const char *message) {
+    logger_async_t *async = sender;
+    uint64_t timestamp = platform_clock_realtime();
+    size_t position = atomic_load_explicit(&async->enqueue_position, memory_order_relaxed);
+    logger_async_entry_t *entry;
+    size_t sequence;
+    size_t length;
+
+    for (;;) {
+        entry = &async->entries[position & async->mask];
+        sequence = atomic_load_explicit(&entry->sequence, memory_order_acquire);
+
+        if (sequence == position) {
+            if (atomic_compare_exchange_weak_explicit(&async->enqueue_position, &position, position + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (sequence < position) {
+            if (async->overflow != LOGGER_ASYNC_OVERFLOW_BLOCK) {
+                atomic_fetch_add_explicit(&async->number_of_dropped_messages, 1, memory_order_relaxed);
+                return;
+            }
+
+            sched_yield();
+            position = atomic_load_explicit(&async->enqueue_position, memory_order_relaxed);
+        } else {
+            position = atomic_load_explicit(&async->enqueue_position, memory_order_relaxed);
+        }
+    }
+
+    entry->level = logger_level;
+    entry->timestamp = timestamp;
+    length = strnlen(message, LOGGER_ASYNC_MESSAGE_SIZE - 1);
+    memcpy(entry->message, message, length);
+    entry->message[length] = '\0';
+
+    // Sequentially consistent, so either the parked writer sees the message or it sees writer_waiting.
+    atomic_store(&entry->sequence, position + 1);
+    logger_async_wake(async);
+}
+
+uint64_t logger_async_timestamp(const logger_async_t *async) {
+    return async->timestamp;
+}
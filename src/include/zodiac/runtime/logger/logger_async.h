@@ -0,0 +1,159 @@
+/**
+ * @file logger_async.h
+ * @brief Provides an asynchronous backend for the Zodiac logger.
+ *
+ * The asynchronous logger is installed as the callback of a regular logger_t, so every
+ * LOGGER_LOG_* and RUNTIME_LOG_* call site benefits from it unchanged. Instead of
+ * calling the target callback on the caller's thread, messages are copied together with
+ * their level and timestamp into a bounded lock-free ring shared by any number of
+ * producer threads. A background writer thread drains the ring and calls the target
+ * callback, so callers never block on I/O. The writer parks on a condition variable
+ * when the ring is empty; producers only take its mutex to wake it up while it sleeps.
+ */
+#ifndef ZODIAC_LOGGER_ASYNC_H
+#define ZODIAC_LOGGER_ASYNC_H
+
+#include "logger.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+/**
+ * @brief Max length of a message kept by the asynchronous logger, including the terminating null.
+ * Longer messages are truncated.
+ */
+#define LOGGER_ASYNC_MESSAGE_SIZE 256
+
+/**
+ * @brief Default number of entries of the ring.
+ */
+#define LOGGER_ASYNC_DEFAULT_CAPACITY 1024
+
+/**
+ * @enum logger_async_overflow_e
+ * @brief Enum representing what happens to a message logged while the ring is full.
+ */
+typedef enum logger_async_overflow_e {
+    LOGGER_ASYNC_OVERFLOW_DROP,   /*!< @brief The message is silently discarded. */
+    LOGGER_ASYNC_OVERFLOW_BLOCK,  /*!< @brief The caller waits until the writer frees an entry. */
+    LOGGER_ASYNC_OVERFLOW_COUNT   /*!< @brief The message is discarded and the writer reports the number of discarded messages. */
+} logger_async_overflow_t;
+
+/**
+ * @enum logger_async_error_e
+ * @brief Enum representing the errors that can occur when starting the asynchronous logger.
+ */
+typedef enum logger_async_error_e {
+    LOGGER_ASYNC_ERROR_OK,        /*!< @brief No error occurred. */
+    LOGGER_ASYNC_ERROR_MEMORY,    /*!< @brief The ring could not be allocated. */
+    LOGGER_ASYNC_ERROR_THREAD     /*!< @brief The writer thread could not be started. */
+} logger_async_error_t;
+
+/**
+ * @struct logger_async_options_s
+ * @brief Represents the configuration of an asynchronous logger.
+ */
+typedef struct logger_async_options_s {
+    size_t capacity;                    /*!< Number of entries of the ring, rounded up to a power of two */
+    logger_async_overflow_t overflow;   /*!< What happens to messages logged while the ring is full */
+} logger_async_options_t;
+
+/**
+ * @struct logger_async_entry_s
+ * @brief Represents a message waiting in the ring.
+ */
+typedef struct logger_async_entry_s {
+    atomic_size_t sequence;                     /*!< Sequence number arbitrating the entry between producers and the writer */
+    logger_level_t level;                       /*!< The severity level of the message */
+    uint64_t timestamp;                         /*!< The wall-clock time of the call in nanoseconds since the epoch */
+    char message[LOGGER_ASYNC_MESSAGE_SIZE];    /*!< The message, truncated to fit */
+} logger_async_entry_t;
+
+/**
+ * @struct logger_async_s
+ * @brief Represents an asynchronous logger forwarding messages to a target logger.
+ */
+typedef struct logger_async_s {
+    logger_t target;                                 /*!< The logger called by the writer thread */
+    logger_async_entry_t *entries;                   /*!< The ring of entries */
+    size_t mask;                                     /*!< Number of entries of the ring minus one */
+    logger_async_overflow_t overflow;                /*!< What happens to messages logged while the ring is full */
+    atomic_size_t enqueue_position;                  /*!< Position of the next entry claimed by a producer */
+    atomic_size_t dequeue_position;                  /*!< Position of the next entry drained by the writer */
+    atomic_uint_fast64_t number_of_dropped_messages; /*!< Number of messages discarded because the ring was full */
+    atomic_bool running;                             /*!< Whether the writer thread keeps waiting for messages */
+    atomic_bool writer_waiting;                      /*!< Whether the writer thread sleeps until a message is published */
+    pthread_mutex_t mutex;                           /*!< Guards the sleep of the writer thread */
+    pthread_cond_t published;                        /*!< Signaled when a message is published or the logger is stopped */
+    uint64_t timestamp;                              /*!< Timestamp of the message being delivered by the writer */
+    pthread_t thread;                                /*!< The writer thread */
+} logger_async_t;
+
+/**
+ * @brief Returns the default configuration of an asynchronous logger.
+ *
+ * @param options Pointer to the options to fill with the defaults.
+ */
+void logger_async_options_init(logger_async_options_t *options);
+
+/**
+ * @brief Allocates the ring and starts the writer thread.
+ *
+ * @param async Pointer to the asynchronous logger to start.
+ * @param sender Instance of the sender passed to the target callback.
+ * @param log_callback The target callback called by the writer thread.
+ * @param options The configuration, or nullptr for the defaults.
+ * @return Error code resulting from the operation.
+ */
+logger_async_error_t logger_async_start(logger_async_t *async,
+                                        callback_sender_t sender,
+                                        logger_log_callback_t log_callback,
+                                        const logger_async_options_t *options);
+
+/**
+ * @brief Delivers the pending messages, stops the writer thread and releases the ring.
+ *
+ * @param async Pointer to the asynchronous logger to stop.
+ */
+void logger_async_stop(logger_async_t *async);
+
+/**
+ * @brief Waits until every message logged before the call has been delivered.
+ *
+ * @param async Pointer to the asynchronous logger.
+ */
+void logger_async_flush(logger_async_t *async);
+
+/**
+ * @brief Initializes a logger that forwards its messages to an asynchronous logger.
+ *
+ * Equivalent to calling logger_init() with the asynchronous logger as the sender and
+ * logger_async_log() as the callback.
+ *
+ * @param logger Pointer to the logger to initialize.
+ * @param async The started asynchronous logger.
+ */
+void logger_init_async(logger_t *logger, logger_async_t *async);
+
+/**
+ * @brief Logging callback enqueuing a message into an asynchronous logger.
+ *
+ * Safe to call concurrently from any number of threads.
+ *
+ * @param sender The asynchronous logger.
+ * @param logger_level The severity level of the message being logged.
+ * @param message The message string to log.
+ */
+void logger_async_log(callback_sender_t sender, logger_level_t logger_level, const char *message);
+
+/**
+ * @brief Returns the timestamp of the message being delivered.
+ *
+ * Only meaningful when called from the target callback, on the writer thread.
+ *
+ * @param async Pointer to the asynchronous logger.
+ * @return The wall-clock time at which the message was logged, in nanoseconds since the epoch.
+ */
+uint64_t logger_async_timestamp(const logger_async_t *async);
+
+#endif // ZODIAC_LOGGER_ASYNC_H
@@ -0,0 +1,201 @@
+#include "logger_binary.h"
+#include "../../platform/platform_clock.h"
+#include "../../platform/platform_memory.h"
+#include "../tracer/tracer.h"
+#include <string.h>
+
+/// Size of the fixed part of a format record in bytes.
+#define LOGGER_BINARY_FORMAT_RECORD_SIZE 5
+
+/// Size of the fixed part of a message record in bytes.
+#define LOGGER_BINARY_MESSAGE_RECORD_SIZE 13
+
+/// Size of an argument holding a number or a pointer in bytes.
+#define LOGGER_BINARY_VALUE_ARGUMENT_SIZE 9
+
+/// Size of the fixed part of a string argument in bytes.
+#define LOGGER_BINARY_STRING_ARGUMENT_SIZE 3
+
+/**
+ * @brief Stores a 16-bit value in little-endian byte order.
+ */
+static uint8_t *logger_binary_put16(uint8_t *cursor, uint16_t value) {
+    cursor[0] = (uint8_t) value;
+    cursor[1] = (uint8_t) (value >> 8);
+    return cursor + 2;
+}
+
+/**
+ * @brief Stores a 64-bit value in little-endian byte order.
+ */
+static uint8_t *logger_binary_put64(uint8_t *cursor, uint64_t value) {
+    for (size_t index = 0; index < 8; ++index) {
+        cursor[index] = (uint8_t) (value >> (index * 8));
+    }
+    return cursor + 8;
+}
+
+/**
+ * @brief Makes room for a record of the given size, flushing the buffer if needed.
+ *
+ * @return Pointer to the reserved bytes, or nullptr if the record does not fit.
+ */
+static uint8_t *logger_binary_reserve(logger_binary_t *binary, size_t size) {
+    if (binary->capacity - binary->size < size) {
+        if (binary->stream == nullptr
+            || logger_binary_flush(binary) != LOGGER_BINARY_ERROR_OK
+            || binary->capacity < size) {
+            return nullptr;
+        }
+    }
+
+    return binary->buffer + binary->size;
+}
+
+logger_binary_error_t logger_binary_open(logger_binary_t *binary, FILE *stream, size_t capacity) {
+    if (capacity < LOGGER_BINARY_MAGIC_SIZE) {
+        capacity = LOGGER_BINARY_DEFAULT_CAPACITY;
+    }
+
+    binary->buffer = platform_memory_allocate(nullptr, capacity);
+    if (binary->buffer == nullptr) {
+        return LOGGER_BINARY_ERROR_MEMORY;
+    }
+
+    binary->stream = stream;
+    binary->capacity = capacity;
+    binary->level = LOGGER_LEVEL_DEBUG;
+    binary->number_of_formats = 0;
+    binary->number_of_dropped_records = 0;
+
+    memcpy(binary->buffer, LOGGER_BINARY_MAGIC, LOGGER_BINARY_MAGIC_SIZE);
+    binary->size = LOGGER_BINARY_MAGIC_SIZE;
+
+    return LOGGER_BINARY_ERROR_OK;
+}
+
+logger_binary_error_t logger_binary_close(logger_binary_t *binary) {
+    logger_binary_error_t error = logger_binary_flush(binary);
+
+    platform_memory_release(nullptr, binary->buffer);
+    binary->buffer = nullptr;
+    binary->capacity = 0;
+    binary->size = 0;
+
+    return error;
+}
+
+logger_binary_error_t logger_binary_flush(logger_binary_t *binary) {
+    if (binary->stream == nullptr || binary->size == 0) {
+        return LOGGER_BINARY_ERROR_OK;
+    }
+
+    TRACER_BEGIN("logger_binary.flush");
+
+    if (fwrite(binary->buffer, 1, binary->size, binary->stream) != binary->size) {
+        TRACER_END("logger_binary.flush");
+        return LOGGER_BINARY_ERROR_WRITE;
+    }
+
+    TRACER_END("logger_binary.flush");
+    binary->size = 0;
+    return LOGGER_BINARY_ERROR_OK;
+}
+
+logger_binary_error_t logger_binary_register_format(logger_binary_t *binary,
+                                                    const char *format,
+                                                    logger_binary_format_t *format_id) {
+
+    size_t length = strnlen(format, UINT16_MAX);
+    uint8_t *cursor;
+
+    if (binary->number_of_formats >= LOGGER_BINARY_MAX_FORMATS) {
+        return LOGGER_BINARY_ERROR_FORMATS;
+    }
+
+    cursor = logger_binary_reserve(binary, LOGGER_BINARY_FORMAT_RECORD_SIZE + length);
+    if (cursor == nullptr) {
+        return LOGGER_BINARY_ERROR_WRITE;
+    }
+
+    *format_id = (logger_binary_format_t) binary->number_of_formats++;
+
+    *cursor++ = LOGGER_BINARY_RECORD_FORMAT;
+    cursor = logger_binary_put16(cursor, *format_id);
+    cursor = logger_binary_put16(cursor, (uint16_t) length);
+    memcpy(cursor, format, length);
+
+    binary->size += LOGGER_BINARY_FORMAT_RECORD_SIZE + length;
+    return LOGGER_BINARY_ERROR_OK;
+}
+
+void logger_binary_log(logger_binary_t *binary,
+                       logger_level_t logger_level,
+                       logger_binary_format_t format_id,
+                       size_t number_of_arguments,
+                       const logger_binary_argument_t *arguments) {
+
+    size_t lengths[LOGGER_BINARY_MAX_ARGUMENTS];
+    size_t size = LOGGER_BINARY_MESSAGE_RECORD_SIZE;
+    uint8_t *cursor;
+
+    if (logger_level < binary->level) {
+        return;
+    }
+
+    if (number_of_arguments > LOGGER_BINARY_MAX_ARGUMENTS) {
+        number_of_arguments = LOGGER_BINARY_MAX_ARGUMENTS;
+    }
+
+    for (size_t index = 0; index < number_of_arguments; ++index) {
+        if (arguments[index].type == LOGGER_BINARY_ARGUMENT_STRING) {
+            lengths[index] = arguments[index].value.string == nullptr
+                             ? 0 : strnlen(arguments[index].value.string, LOGGER_BINARY_MAX_STRING_SIZE);
+            size += LOGGER_BINARY_STRING_ARGUMENT_SIZE + lengths[index];
+        } else {
+            size += LOGGER_BINARY_VALUE_ARGUMENT_SIZE;
+        }
+    }
+
+    cursor = logger_binary_reserve(binary, size);
+    if (cursor == nullptr) {
+        ++binary->number_of_dropped_records;
+        return;
+    }
+
+    *cursor++ = LOGGER_BINARY_RECORD_MESSAGE;
+    cursor = logger_binary_put16(cursor, format_id);
+    *cursor++ = (uint8_t) logger_level;
+    *cursor++ = (uint8_t) number_of_arguments;
+    cursor = logger_binary_put64(cursor, platform_clock_realtime());
+
+    for (size_t index = 0; index < number_of_arguments; ++index) {
+        const logger_binary_argument_t *argument = &arguments[index];
+        uint64_t bits;
+
+        *cursor++ = (uint8_t) argument->type;
+
+        switch (argument->type) {
+            case LOGGER_BINARY_ARGUMENT_STRING:
+                cursor = logger_binary_put16(cursor, (uint16_t) lengths[index]);
+                if (lengths[index] != 0) {
+                    memcpy(cursor, argument->value.string, lengths[index]);
+                    cursor += lengths[index];
+                }
+                continue;
+            case LOGGER_BINARY_ARGUMENT_DOUBLE:
+                memcpy(&bits, &argument->value.floating, sizeof(bits));
+                break;
+            case LOGGER_BINARY_ARGUMENT_POINTER:
+                bits = (uint64_t) (uintptr_t) argument->value.pointer;
+                break;
+            default:
+                bits = argument->value.unsigned_integer;
+                break;
+        }
+
+        cursor = logger_binary_put64(cursor, bits);
+    }
+
+    binary->size += size;
+}
@@ -0,0 +1,273 @@
+/**
+ * @file logger_binary.h
+ * @brief Provides structured binary logging with deferred formatting.
+ *
+ * Instead of formatting messages on the hot path, the binary logger appends the
+ * identifier of a registered printf-style format string together with the raw typed
+ * arguments to a buffer, which is written out in bulk. The zodiac_logdump tool turns
+ * the resulting stream back into text offline.
+ *
+ * The stream starts with LOGGER_BINARY_MAGIC and is followed by records, each starting
+ * with a logger_binary_record_kind_t byte. All multibyte fields are little-endian.
+ * - A format record holds a uint16 format identifier, a uint16 length and the bytes
+ *   of the format string. It precedes every message using the format.
+ * - A message record holds a uint16 format identifier, a uint8 level, a uint8 number
+ *   of arguments and a uint64 timestamp in nanoseconds since the epoch, followed by the
+ *   arguments. Each argument is a logger_binary_argument_type_t byte followed by 8 bytes
+ *   of value, or by a uint16 length and the bytes for strings.
+ *
+ * A binary logger is not synchronized; use one per thread.
+ */
+#ifndef ZODIAC_LOGGER_BINARY_H
+#define ZODIAC_LOGGER_BINARY_H
+
+#include "logger_level.h"
+#include "../../platform/platform.h"
+
+#include <stdio.h>
+
+/**
+ * @brief Magic bytes starting a binary log stream.
+ */
+#define LOGGER_BINARY_MAGIC "ZDCBLOG1"
+
+/**
+ * @brief Length of LOGGER_BINARY_MAGIC in bytes.
+ */
+#define LOGGER_BINARY_MAGIC_SIZE 8
+
+/**
+ * @brief Max number of format strings registered with a binary logger.
+ */
+#define LOGGER_BINARY_MAX_FORMATS 1024
+
+/**
+ * @brief Max number of arguments of a message.
+ */
+#define LOGGER_BINARY_MAX_ARGUMENTS 16
+
+/**
+ * @brief Max number of bytes of a string argument kept in the log; longer strings are truncated.
+ */
+#define LOGGER_BINARY_MAX_STRING_SIZE 1024
+
+/**
+ * @brief Default size of the buffer of a binary logger in bytes.
+ */
+#define LOGGER_BINARY_DEFAULT_CAPACITY (64 * 1024)
+
+/**
+ * @typedef logger_binary_format_t
+ * @brief Identifier of a format string registered with a binary logger.
+ */
+typedef uint16_t logger_binary_format_t;
+
+/**
+ * @enum logger_binary_record_kind_e
+ * @brief Enum representing the kinds of records of a binary log stream.
+ */
+typedef enum logger_binary_record_kind_e {
+    LOGGER_BINARY_RECORD_FORMAT,    /*!< @brief Definition of a format string. */
+    LOGGER_BINARY_RECORD_MESSAGE    /*!< @brief A logged message. */
+} logger_binary_record_kind_t;
+
+/**
+ * @enum logger_binary_argument_type_e
+ * @brief Enum representing the types of the arguments of a message.
+ */
+typedef enum logger_binary_argument_type_e {
+    LOGGER_BINARY_ARGUMENT_INT,       /*!< @brief Signed integer, stored as 64 bits. */
+    LOGGER_BINARY_ARGUMENT_UINT,      /*!< @brief Unsigned integer, stored as 64 bits. */
+    LOGGER_BINARY_ARGUMENT_DOUBLE,    /*!< @brief Floating point number, stored as a double. */
+    LOGGER_BINARY_ARGUMENT_POINTER,   /*!< @brief Pointer, stored as a 64-bit address. */
+    LOGGER_BINARY_ARGUMENT_STRING     /*!< @brief Null-terminated string, copied into the log. */
+} logger_binary_argument_type_t;
+
+/**
+ * @enum logger_binary_error_e
+ * @brief Enum representing the errors reported by the binary logger.
+ */
+typedef enum logger_binary_error_e {
+    LOGGER_BINARY_ERROR_OK,           /*!< @brief No error occurred. */
+    LOGGER_BINARY_ERROR_MEMORY,       /*!< @brief The buffer could not be allocated. */
+    LOGGER_BINARY_ERROR_FORMATS,      /*!< @brief Too many format strings are registered. */
+    LOGGER_BINARY_ERROR_WRITE         /*!< @brief The buffer could not be written to the stream. */
+} logger_binary_error_t;
+
+/**
+ * @struct logger_binary_argument_s
+ * @brief Represents a typed argument of a message.
+ */
+typedef struct logger_binary_argument_s {
+    logger_binary_argument_type_t type;   /*!< The type of the argument */
+    union {
+        int64_t signed_integer;           /*!< Value of a LOGGER_BINARY_ARGUMENT_INT argument */
+        uint64_t unsigned_integer;        /*!< Value of a LOGGER_BINARY_ARGUMENT_UINT argument */
+        double floating;                  /*!< Value of a LOGGER_BINARY_ARGUMENT_DOUBLE argument */
+        const void *pointer;              /*!< Value of a LOGGER_BINARY_ARGUMENT_POINTER argument */
+        const char *string;               /*!< Value of a LOGGER_BINARY_ARGUMENT_STRING argument */
+    } value;                              /*!< The value of the argument */
+} logger_binary_argument_t;
+
+/**
+ * @struct logger_binary_s
+ * @brief Represents a binary logger buffering records for a stream.
+ */
+typedef struct logger_binary_s {
+    FILE *stream;                               /*!< The stream receiving the buffer, or nullptr to keep records in memory */
+    uint8_t *buffer;                            /*!< The buffered records */
+    size_t capacity;                            /*!< Size of the buffer in bytes */
+    size_t size;                                /*!< Number of buffered bytes */
+    logger_level_t level;                       /*!< Messages below this level are discarded */
+    size_t number_of_formats;                   /*!< Number of registered format strings */
+    uint64_t number_of_dropped_records;         /*!< Number of records discarded because the buffer was full */
+} logger_binary_t;
+
+/**
+ * @brief Allocates the buffer of a binary logger and writes the stream header.
+ *
+ * @param binary Pointer to the binary logger to initialize.
+ * @param stream The stream receiving the records, or nullptr to keep them in the buffer.
+ * @param capacity Size of the buffer in bytes, or 0 for LOGGER_BINARY_DEFAULT_CAPACITY.
+ * @return Error code resulting from the operation.
+ */
+logger_binary_error_t logger_binary_open(logger_binary_t *binary, FILE *stream, size_t capacity);
+
+/**
+ * @brief Flushes the buffered records and releases the buffer; the stream is not closed.
+ *
+ * @param binary Pointer to the binary logger.
+ * @return Error code resulting from the final flush.
+ */
+logger_binary_error_t logger_binary_close(logger_binary_t *binary);
+
+/**
+ * @brief Writes the buffered records to the stream.
+ *
+ * Does nothing for a binary logger without a stream.
+ *
+ * @param binary Pointer to the binary logger.
+ * @return Error code resulting from the operation.
+ */
+logger_binary_error_t logger_binary_flush(logger_binary_t *binary);
+
+/**
+ * @brief Registers a printf-style format string.
+ *
+ * The format string is recorded once in the stream; messages then refer to it by
+ * identifier. Conversions are matched with the arguments by kind: integer conversions
+ * take INT or UINT arguments, floating point conversions take DOUBLE arguments, `%s`
+ * takes STRING arguments and `%p` takes POINTER arguments.
+ *
+ * @param binary Pointer to the binary logger.
+ * @param format The format string.
+ * @param[out] format_id The identifier of the registered format string.
+ * @return Error code resulting from the operation.
+ */
+logger_binary_error_t logger_binary_register_format(logger_binary_t *binary,
+                                                    const char *format,
+                                                    logger_binary_format_t *format_id);
+
+/**
+ * @brief Appends a message to the binary log.
+ *
+ * @param binary Pointer to the binary logger.
+ * @param logger_level The severity level of the message.
+ * @param format_id The identifier of the format string of the message.
+ * @param number_of_arguments Number of arguments, at most LOGGER_BINARY_MAX_ARGUMENTS.
+ * @param arguments The arguments of the message.
+ */
+void logger_binary_log(logger_binary_t *binary,
+                       logger_level_t logger_level,
+                       logger_binary_format_t format_id,
+                       size_t number_of_arguments,
+                       const logger_binary_argument_t *arguments);
+
+/// Wraps a signed integer into a binary log argument.
+ZDC_STATIC_INLINE logger_binary_argument_t logger_binary_argument_int(int64_t value) {
+    logger_binary_argument_t argument = {LOGGER_BINARY_ARGUMENT_INT, {.signed_integer = value}};
+    return argument;
+}
+
+/// Wraps an unsigned integer into a binary log argument.
+ZDC_STATIC_INLINE logger_binary_argument_t logger_binary_argument_uint(uint64_t value) {
+    logger_binary_argument_t argument = {LOGGER_BINARY_ARGUMENT_UINT, {.unsigned_integer = value}};
+    return argument;
+}
+
+/// Wraps a floating point number into a binary log argument.
+ZDC_STATIC_INLINE logger_binary_argument_t logger_binary_argument_double(double value) {
+    logger_binary_argument_t argument = {LOGGER_BINARY_ARGUMENT_DOUBLE, {.floating = value}};
+    return argument;
+}
+
+/// Wraps a pointer into a binary log argument.
+ZDC_STATIC_INLINE logger_binary_argument_t logger_binary_argument_pointer(const void *value) {
+    logger_binary_argument_t argument = {LOGGER_BINARY_ARGUMENT_POINTER, {.pointer = value}};
+    return argument;
+}
+
+/// Wraps a null-terminated string into a binary log argument.
+ZDC_STATIC_INLINE logger_binary_argument_t logger_binary_argument_string(const char *value) {
+    logger_binary_argument_t argument = {LOGGER_BINARY_ARGUMENT_STRING, {.string = value}};
+    return argument;
+}
+
+/**
+ * @def LOGGER_BINARY_ARGUMENT
+ * @brief Wraps a value into a binary log argument of the type matching its C type.
+ * @param value The value to wrap.
+ */
+#define LOGGER_BINARY_ARGUMENT(value) _Generic((value),             \
+        _Bool: logger_binary_argument_uint,                         \
+        char: logger_binary_argument_int,                           \
+        signed char: logger_binary_argument_int,                    \
+        short: logger_binary_argument_int,                          \
+        int: logger_binary_argument_int,                            \
+        long: logger_binary_argument_int,                           \
+        long long: logger_binary_argument_int,                      \
+        unsigned char: logger_binary_argument_uint,                 \
+        unsigned short: logger_binary_argument_uint,                \
+        unsigned int: logger_binary_argument_uint,                  \
+        unsigned long: logger_binary_argument_uint,                 \
+        unsigned long long: logger_binary_argument_uint,            \
+        float: logger_binary_argument_double,                       \
+        double: logger_binary_argument_double,                      \
+        char *: logger_binary_argument_string,                      \
+        const char *: logger_binary_argument_string,                \
+        default: logger_binary_argument_pointer)(value)
+
+/// Wraps the arguments of LOGGER_BINARY_LOG, up to LOGGER_BINARY_MAX_ARGUMENTS of them.
+#define LOGGER_BINARY_ARGUMENTS_1(a) LOGGER_BINARY_ARGUMENT(a)
+#define LOGGER_BINARY_ARGUMENTS_2(a, ...) LOGGER_BINARY_ARGUMENT(a), LOGGER_BINARY_ARGUMENTS_1(__VA_ARGS__)
+#define LOGGER_BINARY_ARGUMENTS_3(a, ...) LOGGER_BINARY_ARGUMENT(a), LOGGER_BINARY_ARGUMENTS_2(__VA_ARGS__)
+#define LOGGER_BINARY_ARGUMENTS_4(a, ...) LOGGER_BINARY_ARGUMENT(a), LOGGER_BINARY_ARGUMENTS_3(__VA_ARGS__)
+#define LOGGER_BINARY_ARGUMENTS_5(a, ...) LOGGER_BINARY_ARGUMENT(a), LOGGER_BINARY_ARGUMENTS_4(__VA_ARGS__)
+#define LOGGER_BINARY_ARGUMENTS_6(a, ...) LOGGER_BINARY_ARGUMENT(a), LOGGER_BINARY_ARGUMENTS_5(__VA_ARGS__)
+#define LOGGER_BINARY_ARGUMENTS_7(a, ...) LOGGER_BINARY_ARGUMENT(a), LOGGER_BINARY_ARGUMENTS_6(__VA_ARGS__)
+#define LOGGER_BINARY_ARGUMENTS_8(a, ...) LOGGER_BINARY_ARGUMENT(a), LOGGER_BINARY_ARGUMENTS_7(__VA_ARGS__)
+#define LOGGER_BINARY_ARGUMENTS_SELECT(_1, _2, _3, _4, _5, _6, _7, _8, name, ...) name
+#define LOGGER_BINARY_ARGUMENTS(...) LOGGER_BINARY_ARGUMENTS_SELECT(__VA_ARGS__,                    \
+        LOGGER_BINARY_ARGUMENTS_8, LOGGER_BINARY_ARGUMENTS_7, LOGGER_BINARY_ARGUMENTS_6,            \
+        LOGGER_BINARY_ARGUMENTS_5, LOGGER_BINARY_ARGUMENTS_4, LOGGER_BINARY_ARGUMENTS_3,            \
+        LOGGER_BINARY_ARGUMENTS_2, LOGGER_BINARY_ARGUMENTS_1)(__VA_ARGS__)
+
+/**
+ * @def LOGGER_BINARY_LOG
+ * @brief Appends a message with one to eight arguments to a binary log.
+ *
+ * The types of the arguments are derived from their C types, see LOGGER_BINARY_ARGUMENT.
+ *
+ * @param binary Pointer to the binary logger.
+ * @param logger_level The severity level of the message.
+ * @param format_id The identifier of the format string of the message.
+ */
+#define LOGGER_BINARY_LOG(binary, logger_level, format_id, ...)                                     \
+    do {                                                                                            \
+        const logger_binary_argument_t logger_binary_arguments[] = {LOGGER_BINARY_ARGUMENTS(__VA_ARGS__)}; \
+        logger_binary_log((binary), (logger_level), (format_id),                                    \
+                          sizeof(logger_binary_arguments) / sizeof(logger_binary_arguments[0]),     \
+                          logger_binary_arguments);                                                 \
+    } while (0)
+
+#endif // ZODIAC_LOGGER_BINARY_H
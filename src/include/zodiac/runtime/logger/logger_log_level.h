@@ -5,17 +5,37 @@
  * This set of macros provides a simplified syntax for logging messages at various
  * severity levels by wrapping the `logger_log` function call. Each macro corresponds
  * to one of the predefined logger severity levels.
+ *
+ * Levels below ZODIAC_LOGGER_MIN_LEVEL are removed at compile time: their macros expand
+ * to nothing and the message argument is not evaluated. The remaining macros check the
+ * runtime level of the logger inline, before paying for the call.
  */
 #ifndef ZODIAC_LOGGER_LOG_LEVEL_H
 #define ZODIAC_LOGGER_LOG_LEVEL_H
 
+#include "logger.h"
+
+/**
+ * @def LOGGER_LOG
+ * @brief Log a message if the logger accepts its level.
+ * @param logger The logger to which the message should be logged.
+ * @param logger_level The severity level of the message.
+ * @param message The message to be logged, only evaluated if the level is accepted.
+ */
+#define LOGGER_LOG(logger, logger_level, message) \
+    (logger_is_enabled(logger, logger_level) ? logger_log(logger, logger_level, message) : (void) 0)
+
 /**
  * @def LOGGER_LOG_DEBUG
  * @brief Log a message at the DEBUG level.
  * @param logger The logger to which the message should be logged.
  * @param message The message to be logged.
  */
-#define LOGGER_LOG_DEBUG(logger, message) logger_log(logger, LOGGER_LEVEL_DEBUG, message)
+#if ZODIAC_LOGGER_MIN_LEVEL <= 0
+#   define LOGGER_LOG_DEBUG(logger, message) LOGGER_LOG(logger, LOGGER_LEVEL_DEBUG, message)
+#else
+#   define LOGGER_LOG_DEBUG(logger, message) ((void) 0)
+#endif
 
 /**
  * @def LOGGER_LOG_INFO
@@ -23,7 +43,11 @@
  * @param logger The logger to which the message should be logged.
  * @param message The message to be logged.
  */
-#define LOGGER_LOG_INFO(logger, message) logger_log(logger, LOGGER_LEVEL_INFO, message)
+#if ZODIAC_LOGGER_MIN_LEVEL <= 1
+#   define LOGGER_LOG_INFO(logger, message) LOGGER_LOG(logger, LOGGER_LEVEL_INFO, message)
+#else
+#   define LOGGER_LOG_INFO(logger, message) ((void) 0)
+#endif
 
 /**
  * @def LOGGER_LOG_NOTICE
@@ -31,7 +55,11 @@
  * @param logger The logger to which the message should be logged.
  * @param message The message to be logged.
  */
-#define LOGGER_LOG_NOTICE(logger, message) logger_log(logger, LOGGER_LEVEL_NOTICE, message)
+#if ZODIAC_LOGGER_MIN_LEVEL <= 2
+#   define LOGGER_LOG_NOTICE(logger, message) LOGGER_LOG(logger, LOGGER_LEVEL_NOTICE, message)
+#else
+#   define LOGGER_LOG_NOTICE(logger, message) ((void) 0)
+#endif
 
 /**
  * @def LOGGER_LOG_WARNING
@@ -39,7 +67,11 @@
  * @param logger The logger to which the message should be logged.
  * @param message The message to be logged.
  */
-#define LOGGER_LOG_WARNING(logger, message) logger_log(logger, LOGGER_LEVEL_WARNING, message)
+#if ZODIAC_LOGGER_MIN_LEVEL <= 3
+#   define LOGGER_LOG_WARNING(logger, message) LOGGER_LOG(logger, LOGGER_LEVEL_WARNING, message)
+#else
+#   define LOGGER_LOG_WARNING(logger, message) ((void) 0)
+#endif
 
 /**
  * @def LOGGER_LOG_ERROR
@@ -47,7 +79,11 @@
  * @param logger The logger to which the message should be logged.
  * @param message The message to be logged.
  */
-#define LOGGER_LOG_ERROR(logger, message) logger_log(logger, LOGGER_LEVEL_ERROR, message)
+#if ZODIAC_LOGGER_MIN_LEVEL <= 4
+#   define LOGGER_LOG_ERROR(logger, message) LOGGER_LOG(logger, LOGGER_LEVEL_ERROR, message)
+#else
+#   define LOGGER_LOG_ERROR(logger, message) ((void) 0)
+#endif
 
 /**
  * @def LOGGER_LOG_CRITICAL
@@ -55,7 +91,11 @@
  * @param logger The logger to which the message should be logged.
  * @param message The message to be logged.
  */
-#define LOGGER_LOG_CRITICAL(logger, message) logger_log(logger, LOGGER_LEVEL_CRITICAL, message)
+#if ZODIAC_LOGGER_MIN_LEVEL <= 5
+#   define LOGGER_LOG_CRITICAL(logger, message) LOGGER_LOG(logger, LOGGER_LEVEL_CRITICAL, message)
+#else
+#   define LOGGER_LOG_CRITICAL(logger, message) ((void) 0)
+#endif
 
 /**
  * @def LOGGER_LOG_ALERT
@@ -63,7 +103,11 @@
  * @param logger The logger to which the message should be logged.
  * @param message The message to be logged.
  */
-#define LOGGER_LOG_ALERT(logger, message) logger_log(logger, LOGGER_LEVEL_ALERT, message)
+#if ZODIAC_LOGGER_MIN_LEVEL <= 6
+#   define LOGGER_LOG_ALERT(logger, message) LOGGER_LOG(logger, LOGGER_LEVEL_ALERT, message)
+#else
+#   define LOGGER_LOG_ALERT(logger, message) ((void) 0)
+#endif
 
 /**
  * @def LOGGER_LOG_EMERGENCY
@@ -71,6 +115,10 @@
  * @param logger The logger to which the message should be logged.
  * @param message The message to be logged.
  */
-#define LOGGER_LOG_EMERGENCY(logger, message) logger_log(logger, LOGGER_LEVEL_EMERGENCY, message)
+#if ZODIAC_LOGGER_MIN_LEVEL <= 7
+#   define LOGGER_LOG_EMERGENCY(logger, message) LOGGER_LOG(logger, LOGGER_LEVEL_EMERGENCY, message)
+#else
+#   define LOGGER_LOG_EMERGENCY(logger, message) ((void) 0)
+#endif
 
 #endif // ZODIAC_LOGGER_LOG_LEVEL_H
@@ -0,0 +1,115 @@
+#include "profiler.h"
+
+#include <string.h>
+
+atomic_uint profiler_dump_generation = 0;
+
+/**
+ * @brief Signal handler requesting a dump of the profile.
+ */
+static void profiler_signal_handler(int signal_number) {
+    (void) signal_number;
+    // Lock-free atomics are safe to use from a signal handler.
+    atomic_fetch_add_explicit(&profiler_dump_generation, 1, memory_order_relaxed);
+}
+
+void profiler_init(profiler_t *profiler) {
+    memset(profiler->entries, 0, sizeof(profiler->entries));
+    profiler->dump_path = nullptr;
+    profiler->dump_format = PROFILER_FORMAT_CSV;
+    profiler->dump_generation = atomic_load_explicit(&profiler_dump_generation, memory_order_relaxed);
+}
+
+profiler_error_t profiler_dump(const profiler_t *profiler, FILE *stream, profiler_format_t format) {
+    bool first = true;
+
+    if (format == PROFILER_FORMAT_CSV) {
+        fputs("controller_index,operation_index,hits,cycles,cycles_per_hit\n", stream);
+    } else {
+        fputs("[", stream);
+    }
+
+    for (size_t controller_index = 0; controller_index < MAX_NUMBER_OF_CONTROLLERS; ++controller_index) {
+        for (size_t operation_index = 0; operation_index < MAX_NUMBER_OF_CONTROLLER_OPERATIONS; ++operation_index) {
+            const profiler_entry_t *entry = &profiler->entries[controller_index][operation_index];
+            double cycles_per_hit;
+
+            if (entry->number_of_hits == 0) {
+                continue;
+            }
+
+            cycles_per_hit = (double) entry->number_of_cycles / (double) entry->number_of_hits;
+
+            if (format == PROFILER_FORMAT_CSV) {
+                fprintf(stream, "%zu,%zu,%llu,%llu,%.2f\n", controller_index, operation_index,
+                        (unsigned long long) entry->number_of_hits,
+                        (unsigned long long) entry->number_of_cycles,
+                        cycles_per_hit);
+            } else {
+                fprintf(stream, "%s\n  {\"controller_index\": %zu, \"operation_index\": %zu, "
+                                "\"hits\": %llu, \"cycles\": %llu, \"cycles_per_hit\": %.2f}",
+                        first ? "" : ",", controller_index, operation_index,
+                        (unsigned long long) entry->number_of_hits,
+                        (unsigned long long) entry->number_of_cycles,
+                        cycles_per_hit);
+            }
+
+            first = false;
+        }
+    }
+
+    if (format == PROFILER_FORMAT_JSON) {
+        fputs(first ? "]\n" : "\n]\n", stream);
+    }
+
+    return ferror(stream) ? PROFILER_ERROR_WRITE : PROFILER_ERROR_OK;
+}
+
+profiler_error_t profiler_dump_file(const profiler_t *profiler, const char *path, profiler_format_t format) {
+    profiler_error_t error;
+    FILE *stream = fopen(path, "w");
+
+    if (stream == nullptr) {
+        return PROFILER_ERROR_OPEN;
+    }
+
+    error = profiler_dump(profiler, stream, format);
+
+    if (fclose(stream) != 0 && error == PROFILER_ERROR_OK) {
+        error = PROFILER_ERROR_WRITE;
+    }
+
+    return error;
+}
+
+profiler_error_t profiler_dump_on_signal(profiler_t *profiler,
+                                         int signal_number,
+                                         const char *path,
+                                         profiler_format_t format) {
+
+    struct sigaction action;
+
+    profiler->dump_path = path;
+    profiler->dump_format = format;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = profiler_signal_handler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+
+    return sigaction(signal_number, &action, nullptr) == 0 ? PROFILER_ERROR_OK : PROFILER_ERROR_SIGNAL;
+}
+
+void profiler_poll(profiler_t *profiler) {
+    unsigned int generation = atomic_load_explicit(&profiler_dump_generation, memory_order_relaxed);
+
+    if (generation == profiler->dump_generation) {
+        return;
+    }
+
+    profiler->dump_generation = generation;
+
+    if (profiler->dump_path != nullptr) {
+        profiler_dump_file(profiler, profiler->dump_path, profiler->dump_format);
+    }
+}
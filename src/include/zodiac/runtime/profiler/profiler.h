@@ -0,0 +1,169 @@
+/**
+ * @file profiler.h
+ * @brief Provides the per-operation execution profiler of the Zodiac executor.
+ *
+ * The profiler counts how often every (controller, operation) pair is dispatched and how
+ * many cycles its operation takes, in a flat table indexed by the instruction header.
+ * The table can be dumped as CSV or JSON, at exit or when a signal is received.
+ *
+ * The counters are plain integers, so a profiler must never receive samples from two
+ * threads at once: executors running concurrently, such as tasks on different scheduler
+ * workers, need profilers of their own. A signal makes every profiler set up for it dump
+ * once, at its next poll.
+ *
+ * The executor only records samples when built with ZODIAC_PROFILER defined, which the
+ * CMake option of the same name does. Otherwise the PROFILER_SAMPLE_* macros expand to
+ * nothing and the dispatch loop carries no instrumentation.
+ */
+#ifndef ZODIAC_PROFILER_H
+#define ZODIAC_PROFILER_H
+
+#include "../../controller/controller.h"
+#include "../../instruction/instruction.h"
+#include "../../platform/platform_clock.h"
+
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+/**
+ * @enum profiler_format_e
+ * @brief Enum representing the formats in which the profile can be dumped.
+ */
+typedef enum profiler_format_e {
+    PROFILER_FORMAT_CSV,    /*!< @brief One line per dispatched operation with a header line. */
+    PROFILER_FORMAT_JSON    /*!< @brief An array of objects, one per dispatched operation. */
+} profiler_format_t;
+
+/**
+ * @enum profiler_error_e
+ * @brief Enum representing the errors that can occur when dumping the profile.
+ */
+typedef enum profiler_error_e {
+    PROFILER_ERROR_OK,       /*!< @brief No error occurred. */
+    PROFILER_ERROR_OPEN,     /*!< @brief The output file could not be opened. */
+    PROFILER_ERROR_WRITE,    /*!< @brief The profile could not be written. */
+    PROFILER_ERROR_SIGNAL    /*!< @brief The signal handler could not be installed. */
+} profiler_error_t;
+
+/**
+ * @struct profiler_entry_s
+ * @brief Represents the counters of one (controller, operation) pair.
+ */
+typedef struct profiler_entry_s {
+    uint64_t number_of_hits;      /*!< Number of dispatched instructions */
+    uint64_t number_of_cycles;    /*!< Cycles spent in the operation, as counted by platform_clock_cycles() */
+} profiler_entry_t;
+
+/**
+ * @struct profiler_s
+ * @brief Represents a profile of the executed operations.
+ */
+typedef struct profiler_s {
+    profiler_entry_t entries[MAX_NUMBER_OF_CONTROLLERS][MAX_NUMBER_OF_CONTROLLER_OPERATIONS]; /*!< The counters */
+    const char *dump_path;           /*!< The file written when a dump is requested by signal */
+    profiler_format_t dump_format;   /*!< The format of the file written when a dump is requested by signal */
+    unsigned int dump_generation;    /*!< The value of profiler_dump_generation at the last poll */
+} profiler_t;
+
+/**
+ * @brief Incremented by the signal handler installed by profiler_dump_on_signal().
+ *
+ * Each profiler compares it with the generation it last dumped at, so one signal makes
+ * every profiler dump once, whichever thread polls first.
+ */
+extern atomic_uint profiler_dump_generation;
+
+/**
+ * @brief Clears the counters of a profiler.
+ *
+ * Signals received before the profiler is initialized do not make it dump.
+ *
+ * @param profiler Pointer to the profiler to initialize.
+ */
+void profiler_init(profiler_t *profiler);
+
+/**
+ * @brief Writes the counters of the dispatched operations to a stream.
+ *
+ * @param profiler Pointer to the profiler.
+ * @param stream The stream to write to.
+ * @param format The output format.
+ * @return Error code resulting from the operation.
+ */
+profiler_error_t profiler_dump(const profiler_t *profiler, FILE *stream, profiler_format_t format);
+
+/**
+ * @brief Writes the counters of the dispatched operations to a file.
+ *
+ * @param profiler Pointer to the profiler.
+ * @param path The path of the file, which is replaced.
+ * @param format The output format.
+ * @return Error code resulting from the operation.
+ */
+profiler_error_t profiler_dump_file(const profiler_t *profiler, const char *path, profiler_format_t format);
+
+/**
+ * @brief Dumps the profile to a file whenever the given signal is received.
+ *
+ * The signal handler only increments profiler_dump_generation; the file is written by
+ * the thread owning the profiler at its next recorded sample or when the run of an
+ * executor it is attached to returns, outside the signal context. Every profiler set up
+ * for the same signal writes its own file.
+ *
+ * @param profiler Pointer to the profiler.
+ * @param signal_number The signal triggering the dump, typically SIGUSR1.
+ * @param path The path of the file, which must outlive the profiler.
+ * @param format The output format.
+ * @return Error code resulting from the operation.
+ */
+profiler_error_t profiler_dump_on_signal(profiler_t *profiler,
+                                         int signal_number,
+                                         const char *path,
+                                         profiler_format_t format);
+
+/**
+ * @brief Writes the dump requested by signal since the last poll of the profiler, if any.
+ *
+ * @param profiler Pointer to the profiler.
+ */
+void profiler_poll(profiler_t *profiler);
+
+/**
+ * @brief Accounts one dispatch of the operation addressed by a header.
+ *
+ * @param profiler Pointer to the profiler, or nullptr to discard the sample.
+ * @param header The header of the dispatched instruction.
+ * @param cycles The cycles spent in the operation.
+ */
+ZDC_STATIC_INLINE void profiler_record(profiler_t *profiler, const instruction_header_t *header, uint64_t cycles) {
+    profiler_entry_t *entry;
+
+    if (profiler == nullptr) {
+        return;
+    }
+
+    entry = &profiler->entries[header->controller_index][header->operation_index];
+    ++entry->number_of_hits;
+    entry->number_of_cycles += cycles;
+
+    if (atomic_load_explicit(&profiler_dump_generation, memory_order_relaxed) != profiler->dump_generation) {
+        profiler_poll(profiler);
+    }
+}
+
+#ifdef ZODIAC_PROFILER
+/// Declares the variable holding the start of a sample.
+#   define PROFILER_SAMPLE_DECLARE(start) uint64_t start = 0
+/// Starts timing an operation.
+#   define PROFILER_SAMPLE_BEGIN(start) ((start) = platform_clock_cycles())
+/// Accounts the operation addressed by the header with the cycles elapsed since the start of the sample.
+#   define PROFILER_SAMPLE_END(profiler, header, start) \
+        profiler_record((profiler), (header), platform_clock_cycles() - (start))
+#else
+#   define PROFILER_SAMPLE_DECLARE(start) ((void) 0)
+#   define PROFILER_SAMPLE_BEGIN(start) ((void) 0)
+#   define PROFILER_SAMPLE_END(profiler, header, start) ((void) 0)
+#endif
+
+#endif // ZODIAC_PROFILER_H
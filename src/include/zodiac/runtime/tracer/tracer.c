@@ -0,0 +1,114 @@
+#include "tracer.h"
+#include "../../platform/platform_memory.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+_Thread_local tracer_buffer_t *tracer_thread_buffer;
+
+/// Buffers of every thread that recorded an event, most recent first.
+static tracer_buffer_t *tracer_buffers;
+
+/// Number of threads that recorded an event.
+static uint64_t tracer_number_of_threads;
+
+/// Reference points converting cycles to time, taken when the first thread attaches.
+static uint64_t tracer_origin_cycles;
+static uint64_t tracer_origin_nanoseconds;
+
+/// Protects the list of buffers and the reference points.
+static pthread_mutex_t tracer_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+tracer_buffer_t *tracer_attach(void) {
+    tracer_buffer_t *buffer = platform_memory_allocate(nullptr, sizeof(tracer_buffer_t));
+
+    if (buffer == nullptr) {
+        return nullptr;
+    }
+
+    buffer->number_of_events = 0;
+
+    pthread_mutex_lock(&tracer_mutex);
+
+    if (tracer_buffers == nullptr) {
+        tracer_origin_cycles = platform_clock_cycles();
+        tracer_origin_nanoseconds = platform_clock_monotonic();
+    }
+
+    buffer->thread_id = ++tracer_number_of_threads;
+    buffer->next = tracer_buffers;
+    tracer_buffers = buffer;
+
+    pthread_mutex_unlock(&tracer_mutex);
+
+    tracer_thread_buffer = buffer;
+    return buffer;
+}
+
+tracer_error_t tracer_export(FILE *stream) {
+    double nanoseconds_per_cycle = 1.0;
+    uint64_t elapsed_cycles;
+    bool first = true;
+    int failed = 0;
+
+    pthread_mutex_lock(&tracer_mutex);
+
+    // Calibrates the cycle counter against the monotonic clock over the traced period.
+    elapsed_cycles = platform_clock_cycles() - tracer_origin_cycles;
+    if (tracer_buffers != nullptr && elapsed_cycles != 0) {
+        nanoseconds_per_cycle = (double) (platform_clock_monotonic() - tracer_origin_nanoseconds)
+                                / (double) elapsed_cycles;
+    }
+
+    failed |= fprintf(stream, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [") < 0;
+
+    for (const tracer_buffer_t *buffer = tracer_buffers; buffer != nullptr; buffer = buffer->next) {
+        uint64_t end = buffer->number_of_events;
+        uint64_t start = end > TRACER_BUFFER_CAPACITY ? end - TRACER_BUFFER_CAPACITY : 0;
+
+        for (uint64_t index = start; index < end; ++index) {
+            const tracer_event_t *event = &buffer->events[index & (TRACER_BUFFER_CAPACITY - 1)];
+            double microseconds = (double) (int64_t) (event->cycles - tracer_origin_cycles)
+                                  * nanoseconds_per_cycle / 1000.0;
+
+            failed |= fprintf(stream,
+                              "%s\n  {\"name\": \"%s\", \"cat\": \"zodiac\", \"ph\": \"%c\", "
+                              "\"ts\": %.3f, \"pid\": %ld, \"tid\": %llu}",
+                              first ? "" : ",", event->name, event->begin ? 'B' : 'E', microseconds,
+                              (long) getpid(), (unsigned long long) buffer->thread_id) < 0;
+            first = false;
+        }
+    }
+
+    failed |= fprintf(stream, "\n]}\n") < 0;
+
+    pthread_mutex_unlock(&tracer_mutex);
+    return failed ? TRACER_ERROR_WRITE : TRACER_ERROR_OK;
+}
+
+tracer_error_t tracer_export_file(const char *path) {
+    tracer_error_t error;
+    FILE *stream = fopen(path, "w");
+
+    if (stream == nullptr) {
+        return TRACER_ERROR_OPEN;
+    }
+
+    error = tracer_export(stream);
+
+    if (fclose(stream) != 0 && error == TRACER_ERROR_OK) {
+        error = TRACER_ERROR_WRITE;
+    }
+
+    return error;
+}
+
+void tracer_reset(void) {
+    pthread_mutex_lock(&tracer_mutex);
+
+    for (tracer_buffer_t *buffer = tracer_buffers; buffer != nullptr; buffer = buffer->next) {
+        buffer->number_of_events = 0;
+    }
+
+    pthread_mutex_unlock(&tracer_mutex);
+}
@@ -0,0 +1,126 @@
+/**
+ * @file tracer.h
+ * @brief Provides the event tracer of the Zodiac runtime.
+ *
+ * The tracer records begin and end events of named spans, such as executor slices,
+ * reader callbacks and logger flushes, into a ring buffer owned by the recording
+ * thread, so recording takes no lock and touches no shared cache line. When a ring is
+ * full the oldest events are overwritten. Timestamps are taken with
+ * platform_clock_cycles() and converted to microseconds when the trace is exported
+ * in the Chrome trace event format, which chrome://tracing and Perfetto open.
+ *
+ * Spans are only recorded when built with ZODIAC_TRACER defined, which the CMake
+ * option of the same name does. Otherwise the TRACER_* macros expand to nothing.
+ */
+#ifndef ZODIAC_TRACER_H
+#define ZODIAC_TRACER_H
+
+#include "../../platform/platform_clock.h"
+
+#include <stdio.h>
+
+#ifndef TRACER_BUFFER_CAPACITY
+/// Number of events kept per thread, a power of two.
+#   define TRACER_BUFFER_CAPACITY 16384
+#endif
+
+/**
+ * @enum tracer_error_e
+ * @brief Enum representing the errors that can occur when exporting the trace.
+ */
+typedef enum tracer_error_e {
+    TRACER_ERROR_OK,       /*!< @brief No error occurred. */
+    TRACER_ERROR_OPEN,     /*!< @brief The output file could not be opened. */
+    TRACER_ERROR_WRITE     /*!< @brief The trace could not be written. */
+} tracer_error_t;
+
+/**
+ * @struct tracer_event_s
+ * @brief Represents the begin or the end of a span.
+ */
+typedef struct tracer_event_s {
+    const char *name;     /*!< Name of the span, a string literal */
+    uint64_t cycles;      /*!< Time of the event, as counted by platform_clock_cycles() */
+    bool begin;           /*!< Whether the event begins the span */
+} tracer_event_t;
+
+/**
+ * @struct tracer_buffer_s
+ * @brief Represents the ring of events of a thread.
+ */
+typedef struct tracer_buffer_s {
+    tracer_event_t events[TRACER_BUFFER_CAPACITY];   /*!< The ring of events */
+    uint64_t number_of_events;                       /*!< Number of events recorded since the last reset */
+    uint64_t thread_id;                              /*!< Sequential number of the owning thread */
+    struct tracer_buffer_s *next;                    /*!< The buffer of the next registered thread */
+} tracer_buffer_t;
+
+/**
+ * @brief The buffer of the calling thread, nullptr until it records its first event.
+ */
+extern _Thread_local tracer_buffer_t *tracer_thread_buffer;
+
+/**
+ * @brief Registers a buffer for the calling thread.
+ *
+ * Buffers outlive their threads, so spans of finished threads are exported as well, and
+ * are only released at process exit.
+ *
+ * @return The buffer, or nullptr if it could not be allocated.
+ */
+tracer_buffer_t *tracer_attach(void);
+
+/**
+ * @brief Writes the events of every thread as a Chrome trace.
+ *
+ * Threads should not record events while the trace is exported.
+ *
+ * @param stream The stream to write to.
+ * @return Error code resulting from the operation.
+ */
+tracer_error_t tracer_export(FILE *stream);
+
+/**
+ * @brief Writes the events of every thread as a Chrome trace to a file.
+ *
+ * @param path The path of the file, which is replaced.
+ * @return Error code resulting from the operation.
+ */
+tracer_error_t tracer_export_file(const char *path);
+
+/**
+ * @brief Discards the recorded events of every thread.
+ */
+void tracer_reset(void);
+
+/**
+ * @brief Records an event in the buffer of the calling thread.
+ *
+ * @param name Name of the span, a string literal.
+ * @param begin Whether the event begins the span.
+ */
+ZDC_STATIC_INLINE void tracer_record(const char *name, bool begin) {
+    tracer_buffer_t *buffer = tracer_thread_buffer;
+    tracer_event_t *event;
+
+    if (buffer == nullptr && (buffer = tracer_attach()) == nullptr) {
+        return;
+    }
+
+    event = &buffer->events[buffer->number_of_events++ & (TRACER_BUFFER_CAPACITY - 1)];
+    event->name = name;
+    event->cycles = platform_clock_cycles();
+    event->begin = begin;
+}
+
+#ifdef ZODIAC_TRACER
+/// Begins a span of the given name.
+#   define TRACER_BEGIN(name) tracer_record((name), true)
+/// Ends the span of the given name.
+#   define TRACER_END(name) tracer_record((name), false)
+#else
+#   define TRACER_BEGIN(name) ((void) 0)
+#   define TRACER_END(name) ((void) 0)
+#endif
+
+#endif // ZODIAC_TRACER_H
@@ -0,0 +1,383 @@
+#include "scheduler.h"
+#include "../platform/platform_clock.h"
+#include "../platform/platform_memory.h"
+
+#include <unistd.h>
+
+/// Time a worker sleeps before looking for tasks to steal again, in nanoseconds.
+#define SCHEDULER_IDLE_SLEEP 1000000
+
+/// The worker running on the calling thread, if any.
+static _Thread_local scheduler_worker_t *scheduler_current_worker = nullptr;
+
+/**
+ * @brief Appends a task to the submission queue and wakes a sleeping worker.
+ */
+static void scheduler_enqueue(scheduler_t *scheduler, scheduler_task_t *task) {
+    task->next = nullptr;
+
+    pthread_mutex_lock(&scheduler->mutex);
+
+    if (scheduler->queue_tail != nullptr) {
+        scheduler->queue_tail->next = task;
+    } else {
+        scheduler->queue_head = task;
+    }
+
+    scheduler->queue_tail = task;
+    atomic_fetch_add_explicit(&scheduler->number_of_queued_tasks, 1, memory_order_relaxed);
+    pthread_cond_signal(&scheduler->work_available);
+    pthread_mutex_unlock(&scheduler->mutex);
+}
+
+/**
+ * @brief Removes the oldest task of the submission queue.
+ *
+ * @return The task, or nullptr if the queue is empty.
+ */
+static scheduler_task_t *scheduler_dequeue(scheduler_t *scheduler) {
+    scheduler_task_t *task;
+
+    // The queue only holds overflowed tasks, so it is nearly always empty.
+    if (atomic_load_explicit(&scheduler->number_of_queued_tasks, memory_order_relaxed) == 0) {
+        return nullptr;
+    }
+
+    pthread_mutex_lock(&scheduler->mutex);
+
+    task = scheduler->queue_head;
+    if (task != nullptr) {
+        scheduler->queue_head = task->next;
+        if (scheduler->queue_head == nullptr) {
+            scheduler->queue_tail = nullptr;
+        }
+
+        atomic_fetch_sub_explicit(&scheduler->number_of_queued_tasks, 1, memory_order_relaxed);
+    }
+
+    pthread_mutex_unlock(&scheduler->mutex);
+    return task;
+}
+
+/**
+ * @brief Pushes a task to the deque of a worker, or to the submission queue if the deque is full.
+ */
+static void scheduler_push(scheduler_worker_t *worker, scheduler_task_t *task) {
+    scheduler_t *scheduler = worker->scheduler;
+
+    if (!scheduler_deque_push(&worker->deque, task)) {
+        scheduler_enqueue(scheduler, task);
+        return;
+    }
+
+    if (atomic_load_explicit(&scheduler->number_of_sleeping_workers, memory_order_relaxed) != 0) {
+        pthread_mutex_lock(&scheduler->mutex);
+        pthread_cond_signal(&scheduler->work_available);
+        pthread_mutex_unlock(&scheduler->mutex);
+    }
+}
+
+/**
+ * @brief Pushes a yielded task back to the deque of its worker, or to the submission queue if the deque is full.
+ *
+ * Unlike scheduler_push(), sleeping workers are not woken: they find the task when their
+ * bounded wait ends, which keeps the mutex out of the path of every slice.
+ */
+static void scheduler_requeue(scheduler_worker_t *worker, scheduler_task_t *task) {
+    if (!scheduler_deque_push(&worker->deque, task)) {
+        scheduler_enqueue(worker->scheduler, task);
+    }
+}
+
+/**
+ * @brief Hands a task submitted from outside the workers to the next worker in turn.
+ */
+static void scheduler_deliver(scheduler_t *scheduler, scheduler_task_t *task) {
+    size_t index = atomic_fetch_add_explicit(&scheduler->next_worker, 1, memory_order_relaxed);
+    scheduler_worker_t *worker = &scheduler->workers[index % scheduler->number_of_workers];
+    scheduler_task_t *head = atomic_load_explicit(&worker->inbox, memory_order_relaxed);
+
+    do {
+        task->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&worker->inbox, &head, task,
+                                                    memory_order_seq_cst, memory_order_relaxed));
+
+    // Pairs with scheduler_sleep(), which counts itself as sleeping before looking at its inbox.
+    if (atomic_load_explicit(&scheduler->number_of_sleeping_workers, memory_order_seq_cst) != 0) {
+        pthread_mutex_lock(&scheduler->mutex);
+        pthread_cond_broadcast(&scheduler->work_available);
+        pthread_mutex_unlock(&scheduler->mutex);
+    }
+}
+
+/**
+ * @brief Moves the tasks of the inbox of a worker to its deque, oldest first.
+ */
+static void scheduler_drain(scheduler_worker_t *worker) {
+    scheduler_task_t *task;
+    scheduler_task_t *oldest = nullptr;
+
+    if (atomic_load_explicit(&worker->inbox, memory_order_relaxed) == nullptr) {
+        return;
+    }
+
+    task = atomic_exchange_explicit(&worker->inbox, nullptr, memory_order_acquire);
+
+    while (task != nullptr) {
+        scheduler_task_t *next = task->next;
+
+        task->next = oldest;
+        oldest = task;
+        task = next;
+    }
+
+    while (oldest != nullptr) {
+        scheduler_task_t *next = oldest->next;
+
+        scheduler_requeue(worker, oldest);
+        oldest = next;
+    }
+}
+
+/**
+ * @brief Steals a task from another worker, starting with a random victim.
+ *
+ * @return The task, or nullptr if no other worker had one.
+ */
+static scheduler_task_t *scheduler_steal(scheduler_worker_t *worker) {
+    scheduler_t *scheduler = worker->scheduler;
+    size_t start;
+
+    worker->random_state ^= worker->random_state << 13;
+    worker->random_state ^= worker->random_state >> 17;
+    worker->random_state ^= worker->random_state << 5;
+    start = worker->random_state % scheduler->number_of_workers;
+
+    for (size_t offset = 0; offset < scheduler->number_of_workers; ++offset) {
+        scheduler_worker_t *victim = &scheduler->workers[(start + offset) % scheduler->number_of_workers];
+        scheduler_task_t *task;
+
+        if (victim == worker) {
+            continue;
+        }
+
+        task = scheduler_deque_steal(&victim->deque);
+        if (task != nullptr) {
+            ++worker->number_of_steals;
+            return task;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Waits until a task may be available or the scheduler stops.
+ *
+ * The wait is bounded, since tasks pushed to the deques of busy workers do not always
+ * signal sleeping workers.
+ */
+static void scheduler_sleep(scheduler_worker_t *worker) {
+    scheduler_t *scheduler = worker->scheduler;
+    uint64_t deadline = platform_clock_realtime() + SCHEDULER_IDLE_SLEEP;
+    struct timespec timeout = {(time_t) (deadline / 1000000000u), (long) (deadline % 1000000000u)};
+
+    pthread_mutex_lock(&scheduler->mutex);
+    atomic_fetch_add_explicit(&scheduler->number_of_sleeping_workers, 1, memory_order_seq_cst);
+
+    if (scheduler->queue_head == nullptr
+        && atomic_load_explicit(&worker->inbox, memory_order_seq_cst) == nullptr
+        && atomic_load_explicit(&scheduler->running, memory_order_acquire)) {
+        pthread_cond_timedwait(&scheduler->work_available, &scheduler->mutex, &timeout);
+    }
+
+    atomic_fetch_sub_explicit(&scheduler->number_of_sleeping_workers, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&scheduler->mutex);
+}
+
+/**
+ * @brief Reports a task whose executor stopped for good.
+ */
+static void scheduler_complete(scheduler_t *scheduler, scheduler_task_t *task, executor_status_t status) {
+    task->status = status;
+
+    if (task->completion_callback != nullptr) {
+        task->completion_callback(task->sender, task);
+    }
+
+    if (atomic_fetch_sub_explicit(&scheduler->number_of_pending_tasks, 1, memory_order_acq_rel) == 1) {
+        pthread_mutex_lock(&scheduler->mutex);
+        pthread_cond_broadcast(&scheduler->all_completed);
+        pthread_mutex_unlock(&scheduler->mutex);
+    }
+}
+
+/**
+ * @brief Entry point of a worker thread.
+ */
+static void *scheduler_worker(void *argument) {
+    scheduler_worker_t *worker = argument;
+    scheduler_t *scheduler = worker->scheduler;
+
+    scheduler_current_worker = worker;
+
+    while (atomic_load_explicit(&scheduler->running, memory_order_acquire)) {
+        scheduler_task_t *task = nullptr;
+        executor_status_t status;
+
+        scheduler_drain(worker);
+
+        if (worker->number_of_slices % SCHEDULER_QUEUE_INTERVAL == 0) {
+            task = scheduler_dequeue(scheduler);
+        }
+
+        if (task == nullptr) {
+            task = scheduler_deque_take(&worker->deque);
+        }
+
+        if (task == nullptr) {
+            task = scheduler_dequeue(scheduler);
+        }
+
+        if (task == nullptr) {
+            task = scheduler_steal(worker);
+        }
+
+        if (task == nullptr) {
+            scheduler_sleep(worker);
+            continue;
+        }
+
+        status = executor_run_slice(task->executor, scheduler->slice);
+        ++worker->number_of_slices;
+
+        // Yielded tasks go behind the other tasks of the deque, which is served oldest
+        // first, so a task looping forever cannot keep them from ever running.
+        if (status == EXECUTOR_STATUS_YIELDED) {
+            scheduler_requeue(worker, task);
+        } else {
+            scheduler_complete(scheduler, task, status);
+        }
+    }
+
+    scheduler_current_worker = nullptr;
+    return nullptr;
+}
+
+void scheduler_options_init(scheduler_options_t *options) {
+    long number_of_cores = sysconf(_SC_NPROCESSORS_ONLN);
+
+    options->number_of_workers = number_of_cores > 0 ? (size_t) number_of_cores : 1;
+    options->slice = SCHEDULER_DEFAULT_SLICE;
+    options->deque_capacity = SCHEDULER_DEFAULT_DEQUE_CAPACITY;
+}
+
+scheduler_error_t scheduler_start(scheduler_t *scheduler, const scheduler_options_t *options) {
+    scheduler_options_t defaults;
+    size_t index;
+
+    scheduler_options_init(&defaults);
+    if (options == nullptr) {
+        options = &defaults;
+    }
+
+    scheduler->number_of_workers = options->number_of_workers != 0
+                                   ? options->number_of_workers
+                                   : defaults.number_of_workers;
+    scheduler->slice = options->slice != 0 ? options->slice : SCHEDULER_DEFAULT_SLICE;
+    scheduler->queue_head = nullptr;
+    scheduler->queue_tail = nullptr;
+    atomic_init(&scheduler->number_of_pending_tasks, 0);
+    atomic_init(&scheduler->number_of_queued_tasks, 0);
+    atomic_init(&scheduler->next_worker, 0);
+    atomic_init(&scheduler->number_of_sleeping_workers, 0);
+    atomic_init(&scheduler->running, true);
+
+    scheduler->workers = platform_memory_allocate_zeroed(nullptr, scheduler->number_of_workers * sizeof(scheduler_worker_t));
+    if (scheduler->workers == nullptr) {
+        return SCHEDULER_ERROR_MEMORY;
+    }
+
+    for (index = 0; index < scheduler->number_of_workers; ++index) {
+        scheduler_worker_t *worker = &scheduler->workers[index];
+
+        worker->scheduler = scheduler;
+        worker->index = index;
+        worker->random_state = (uint32_t) index * 2654435761u + 1;
+        atomic_init(&worker->inbox, nullptr);
+
+        if (!scheduler_deque_init(&worker->deque, options->deque_capacity)) {
+            while (index-- > 0) {
+                scheduler_deque_free(&scheduler->workers[index].deque);
+            }
+
+            platform_memory_release(nullptr, scheduler->workers);
+            return SCHEDULER_ERROR_MEMORY;
+        }
+    }
+
+    pthread_mutex_init(&scheduler->mutex, nullptr);
+    pthread_cond_init(&scheduler->work_available, nullptr);
+    pthread_cond_init(&scheduler->all_completed, nullptr);
+
+    for (index = 0; index < scheduler->number_of_workers; ++index) {
+        if (pthread_create(&scheduler->workers[index].thread, nullptr, scheduler_worker,
+                           &scheduler->workers[index]) != 0) {
+            break;
+        }
+    }
+
+    if (index < scheduler->number_of_workers) {
+        for (size_t unstarted = index; unstarted < scheduler->number_of_workers; ++unstarted) {
+            scheduler_deque_free(&scheduler->workers[unstarted].deque);
+        }
+
+        scheduler->number_of_workers = index;
+        scheduler_stop(scheduler);
+        return SCHEDULER_ERROR_THREAD;
+    }
+
+    return SCHEDULER_ERROR_OK;
+}
+
+void scheduler_stop(scheduler_t *scheduler) {
+    pthread_mutex_lock(&scheduler->mutex);
+    atomic_store_explicit(&scheduler->running, false, memory_order_release);
+    pthread_cond_broadcast(&scheduler->work_available);
+    pthread_mutex_unlock(&scheduler->mutex);
+
+    for (size_t index = 0; index < scheduler->number_of_workers; ++index) {
+        pthread_join(scheduler->workers[index].thread, nullptr);
+        scheduler_deque_free(&scheduler->workers[index].deque);
+    }
+
+    pthread_cond_destroy(&scheduler->all_completed);
+    pthread_cond_destroy(&scheduler->work_available);
+    pthread_mutex_destroy(&scheduler->mutex);
+
+    platform_memory_release(nullptr, scheduler->workers);
+    scheduler->workers = nullptr;
+    scheduler->number_of_workers = 0;
+}
+
+void scheduler_submit(scheduler_t *scheduler, scheduler_task_t *task) {
+    scheduler_worker_t *worker = scheduler_current_worker;
+
+    atomic_fetch_add_explicit(&scheduler->number_of_pending_tasks, 1, memory_order_relaxed);
+
+    if (worker != nullptr && worker->scheduler == scheduler) {
+        scheduler_push(worker, task);
+    } else {
+        scheduler_deliver(scheduler, task);
+    }
+}
+
+void scheduler_wait(scheduler_t *scheduler) {
+    pthread_mutex_lock(&scheduler->mutex);
+
+    while (atomic_load_explicit(&scheduler->number_of_pending_tasks, memory_order_acquire) != 0) {
+        pthread_cond_wait(&scheduler->all_completed, &scheduler->mutex);
+    }
+
+    pthread_mutex_unlock(&scheduler->mutex);
+}
@@ -0,0 +1,138 @@
+/**
+ * @file scheduler.h
+ * @brief Defines the work-stealing scheduler running many VM instances on a thread pool.
+ *
+ * Every worker thread owns a scheduler_deque_t. A worker runs the oldest task of its
+ * deque for a slice of instructions with executor_run_slice(), then pushes it back to
+ * the bottom if it yielded, so the tasks of a worker take turns without any lock.
+ * Tasks submitted from outside the workers are spread over the workers round-robin
+ * through a lock-free inbox each worker moves into its deque. Workers with an empty
+ * deque steal the oldest task of another worker, so long-running instances spread
+ * across all cores. The shared submission queue only holds the tasks that overflowed a
+ * full deque; workers also serve it every SCHEDULER_QUEUE_INTERVAL slices, so such
+ * tasks are never starved by the tasks of the deques.
+ */
+
+#ifndef ZODIAC_SCHEDULER_H
+#define ZODIAC_SCHEDULER_H
+
+#include "scheduler_deque.h"
+
+#include <pthread.h>
+
+/**
+ * @brief Default number of instructions a task runs before yielding its worker.
+ */
+#define SCHEDULER_DEFAULT_SLICE 10000
+
+/**
+ * @brief Default number of slots of the deque of every worker.
+ */
+#define SCHEDULER_DEFAULT_DEQUE_CAPACITY 1024
+
+/**
+ * @brief Number of slices after which a worker serves the shared submission queue before its deque.
+ */
+#define SCHEDULER_QUEUE_INTERVAL 61
+
+/**
+ * @enum scheduler_error_e
+ * @brief Enumerates possible errors that can occur when starting a scheduler.
+ */
+typedef enum scheduler_error_e {
+    SCHEDULER_ERROR_OK,        ///< No error occurred, the workers are running.
+    SCHEDULER_ERROR_MEMORY,    ///< The workers or their deques could not be allocated.
+    SCHEDULER_ERROR_THREAD     ///< A worker thread could not be started.
+} scheduler_error_t;
+
+/**
+ * @struct scheduler_options_s
+ * @brief Structure that holds the configuration of a scheduler.
+ */
+typedef struct scheduler_options_s {
+    size_t number_of_workers;   ///< Number of worker threads, 0 for one per online core.
+    uint64_t slice;             ///< Number of instructions a task runs before yielding its worker.
+    size_t deque_capacity;      ///< Number of slots of the deque of every worker.
+} scheduler_options_t;
+
+struct scheduler_s;
+
+/**
+ * @struct scheduler_worker_s
+ * @brief Structure that holds the state of a worker thread.
+ */
+typedef struct scheduler_worker_s {
+    struct scheduler_s *scheduler;       ///< The scheduler owning the worker.
+    scheduler_deque_t deque;             ///< The tasks of the worker.
+    _Atomic(scheduler_task_t *) inbox;   ///< Tasks submitted to the worker from outside, newest first.
+    pthread_t thread;                    ///< The worker thread.
+    size_t index;                        ///< Index of the worker within the scheduler.
+    uint32_t random_state;               ///< State of the generator picking steal victims.
+    uint64_t number_of_slices;           ///< Number of slices run by the worker.
+    uint64_t number_of_steals;           ///< Number of tasks stolen from other workers.
+} scheduler_worker_t;
+
+/**
+ * @struct scheduler_s
+ * @brief Structure that holds a pool of workers and the tasks they run.
+ */
+typedef struct scheduler_s {
+    scheduler_worker_t *workers;                 ///< The workers.
+    size_t number_of_workers;                    ///< Number of workers.
+    uint64_t slice;                              ///< Number of instructions a task runs before yielding.
+    pthread_mutex_t mutex;                       ///< Guards the submission queue and the condition variables.
+    pthread_cond_t work_available;               ///< Signaled when sleeping workers may find a task.
+    pthread_cond_t all_completed;                ///< Signaled when the last pending task completes.
+    scheduler_task_t *queue_head;                ///< Oldest task of the submission queue.
+    scheduler_task_t *queue_tail;                ///< Newest task of the submission queue.
+    atomic_size_t number_of_queued_tasks;        ///< Number of tasks of the submission queue.
+    atomic_size_t next_worker;                   ///< Worker receiving the next task submitted from outside.
+    atomic_size_t number_of_pending_tasks;       ///< Number of submitted tasks not completed yet.
+    atomic_size_t number_of_sleeping_workers;    ///< Number of workers waiting for a task.
+    atomic_bool running;                         ///< Whether the workers keep looking for tasks.
+} scheduler_t;
+
+/**
+ * @brief Returns the default configuration of a scheduler.
+ *
+ * @param[out] options Pointer to the options to fill with the defaults.
+ */
+void scheduler_options_init(scheduler_options_t *options);
+
+/**
+ * @brief Starts the workers of a scheduler.
+ *
+ * @param[out] scheduler Pointer to the scheduler to start.
+ * @param[in] options The configuration, or nullptr for the defaults.
+ * @return scheduler_error_t Error code resulting from the operation.
+ */
+scheduler_error_t scheduler_start(scheduler_t *scheduler, const scheduler_options_t *options);
+
+/**
+ * @brief Stops the workers and releases the scheduler.
+ *
+ * Tasks that have not completed are abandoned; call scheduler_wait() first to let
+ * them finish.
+ *
+ * @param[in,out] scheduler Pointer to the scheduler.
+ */
+void scheduler_stop(scheduler_t *scheduler);
+
+/**
+ * @brief Submits a task; safe to call from any thread, including operations running on a worker.
+ *
+ * @param[in,out] scheduler Pointer to the scheduler.
+ * @param[in,out] task The task, which must stay valid until it completes.
+ */
+void scheduler_submit(scheduler_t *scheduler, scheduler_task_t *task);
+
+/**
+ * @brief Waits until every submitted task has completed.
+ *
+ * Must not be called from a worker thread.
+ *
+ * @param[in,out] scheduler Pointer to the scheduler.
+ */
+void scheduler_wait(scheduler_t *scheduler);
+
+#endif // ZODIAC_SCHEDULER_H
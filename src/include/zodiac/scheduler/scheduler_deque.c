@@ -0,0 +1,110 @@
+#include "scheduler_deque.h"
+
+#include "../platform/platform_memory.h"
+
+bool scheduler_deque_init(scheduler_deque_t *deque, size_t capacity) {
+    size_t number_of_slots = 1;
+
+    while (number_of_slots < capacity) {
+        number_of_slots <<= 1;
+    }
+
+    deque->tasks = platform_memory_allocate(nullptr, number_of_slots * sizeof(deque->tasks[0]));
+    if (deque->tasks == nullptr) {
+        return false;
+    }
+
+    for (size_t index = 0; index < number_of_slots; ++index) {
+        atomic_init(&deque->tasks[index], nullptr);
+    }
+
+    deque->mask = (int_fast64_t) number_of_slots - 1;
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    return true;
+}
+
+void scheduler_deque_free(scheduler_deque_t *deque) {
+    platform_memory_release(nullptr, deque->tasks);
+    deque->tasks = nullptr;
+}
+
+bool scheduler_deque_push(scheduler_deque_t *deque, scheduler_task_t *task) {
+    int_fast64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int_fast64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+
+    if (bottom - top > deque->mask) {
+        return false;
+    }
+
+    atomic_store_explicit(&deque->tasks[bottom & deque->mask], task, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return true;
+}
+
+scheduler_task_t *scheduler_deque_pop(scheduler_deque_t *deque) {
+    int_fast64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    int_fast64_t top;
+    scheduler_task_t *task;
+
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return nullptr;
+    }
+
+    task = atomic_load_explicit(&deque->tasks[bottom & deque->mask], memory_order_relaxed);
+
+    if (top == bottom) {
+        // Last task: race the thieves for it.
+        if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                     memory_order_seq_cst, memory_order_relaxed)) {
+            task = nullptr;
+        }
+
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+
+    return task;
+}
+
+scheduler_task_t *scheduler_deque_take(scheduler_deque_t *deque) {
+    scheduler_task_t *task;
+
+    do {
+        if (atomic_load_explicit(&deque->top, memory_order_acquire)
+            >= atomic_load_explicit(&deque->bottom, memory_order_relaxed)) {
+            return nullptr;
+        }
+
+        task = scheduler_deque_steal(deque);
+    } while (task == nullptr);
+
+    return task;
+}
+
+scheduler_task_t *scheduler_deque_steal(scheduler_deque_t *deque) {
+    int_fast64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    int_fast64_t bottom;
+    scheduler_task_t *task;
+
+    atomic_thread_fence(memory_order_seq_cst);
+    bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    if (top >= bottom) {
+        return nullptr;
+    }
+
+    task = atomic_load_explicit(&deque->tasks[top & deque->mask], memory_order_relaxed);
+
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                 memory_order_seq_cst, memory_order_relaxed)) {
+        return nullptr;
+    }
+
+    return task;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file scheduler_deque.h
+ * @brief Defines the work-stealing deque of a scheduler worker.
+ *
+ * The deque is the Chase-Lev deque with the memory orderings of Lê et al.,
+ * "Correct and Efficient Work-Stealing for Weak Memory Models". Its owner pushes and
+ * pops tasks at the bottom without locking, other workers steal from the top. The
+ * capacity is fixed; pushing into a full deque fails and the caller falls back to the
+ * shared submission queue.
+ */
+
+#ifndef ZODIAC_SCHEDULER_DEQUE_H
+#define ZODIAC_SCHEDULER_DEQUE_H
+
+#include "scheduler_task.h"
+
+#include <stdatomic.h>
+
+/**
+ * @struct scheduler_deque_s
+ * @brief Structure that holds the tasks of a worker.
+ */
+typedef struct scheduler_deque_s {
+    atomic_int_fast64_t top;                     ///< Index of the oldest task, advanced by thieves.
+    atomic_int_fast64_t bottom;                  ///< Index past the newest task, moved by the owner.
+    _Atomic(scheduler_task_t *) *tasks;          ///< Ring of tasks.
+    int_fast64_t mask;                           ///< Number of slots of the ring minus one.
+} scheduler_deque_t;
+
+/**
+ * @brief Allocates an empty deque.
+ *
+ * @param[out] deque Pointer to the deque to initialize.
+ * @param[in] capacity Number of slots, rounded up to a power of two.
+ * @return Whether the ring could be allocated.
+ */
+bool scheduler_deque_init(scheduler_deque_t *deque, size_t capacity);
+
+/**
+ * @brief Releases the ring of a deque.
+ *
+ * @param[in,out] deque Pointer to the deque.
+ */
+void scheduler_deque_free(scheduler_deque_t *deque);
+
+/**
+ * @brief Pushes a task at the bottom; only called by the owner.
+ *
+ * @return Whether the task was pushed, false if the deque is full.
+ */
+bool scheduler_deque_push(scheduler_deque_t *deque, scheduler_task_t *task);
+
+/**
+ * @brief Pops the newest task from the bottom; only called by the owner.
+ *
+ * @return The task, or nullptr if the deque is empty.
+ */
+scheduler_task_t *scheduler_deque_pop(scheduler_deque_t *deque);
+
+/**
+ * @brief Takes the oldest task from the top; only called by the owner.
+ *
+ * Unlike scheduler_deque_steal(), losing a race to a thief is retried, so nullptr means
+ * the deque is empty. Owners taking their tasks from the top run them in turn.
+ *
+ * @return The task, or nullptr if the deque is empty.
+ */
+scheduler_task_t *scheduler_deque_take(scheduler_deque_t *deque);
+
+/**
+ * @brief Steals the oldest task from the top; called by any other thread.
+ *
+ * @return The task, or nullptr if the deque is empty or another thread won the race.
+ */
+scheduler_task_t *scheduler_deque_steal(scheduler_deque_t *deque);
+
+#endif // ZODIAC_SCHEDULER_DEQUE_H
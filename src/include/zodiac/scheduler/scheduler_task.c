@@ -0,0 +1,13 @@
+#include "scheduler_task.h"
+
+void scheduler_task_init(scheduler_task_t *task,
+                         executor_t *executor,
+                         scheduler_completion_callback_t completion_callback,
+                         callback_sender sender) {
+
+    task->executor = executor;
+    task->completion_callback = completion_callback;
+    task->sender = sender;
+    task->status = EXECUTOR_STATUS_READY;
+    task->next = nullptr;
+}
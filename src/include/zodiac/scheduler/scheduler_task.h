@@ -0,0 +1,51 @@
+/**
+ * @file scheduler_task.h
+ * @brief Defines a VM instance scheduled by the scheduler.
+ */
+
+#ifndef ZODIAC_SCHEDULER_TASK_H
+#define ZODIAC_SCHEDULER_TASK_H
+
+#include "../executor/executor.h"  // Execution state of the instance.
+
+struct scheduler_task_s;
+
+/**
+ * @typedef scheduler_completion_callback_t
+ * @brief Called on a worker thread once the executor of a task has stopped for good.
+ *
+ * @param sender The sender of the task.
+ * @param task The completed task, whose `status` holds the final executor status.
+ */
+typedef void (*scheduler_completion_callback_t)(callback_sender sender, struct scheduler_task_s *task);
+
+/**
+ * @struct scheduler_task_s
+ * @brief Structure that holds a VM instance submitted to the scheduler.
+ *
+ * Each task owns its executor and the reader, program or image it runs, so instances
+ * share nothing but the read-only controller registry. The task must stay valid until
+ * its completion callback has been called.
+ */
+typedef struct scheduler_task_s {
+    executor_t *executor;                                  ///< The execution state of the instance.
+    scheduler_completion_callback_t completion_callback;   ///< Called when the instance stops, may be nullptr.
+    callback_sender sender;                                ///< Passed to the completion callback.
+    executor_status_t status;                              ///< The final status of the instance.
+    struct scheduler_task_s *next;                         ///< Link of the submission queue, used internally.
+} scheduler_task_t;
+
+/**
+ * @brief Initializes a task running an executor.
+ *
+ * @param[out] task Pointer to the task to initialize.
+ * @param[in] executor The initialized executor of the instance.
+ * @param[in] completion_callback Called when the instance stops, or nullptr.
+ * @param[in] sender Passed to the completion callback.
+ */
+void scheduler_task_init(scheduler_task_t *task,
+                         executor_t *executor,
+                         scheduler_completion_callback_t completion_callback,
+                         callback_sender sender);
+
+#endif // ZODIAC_SCHEDULER_TASK_H
@@ -1,13 +1,100 @@
+#include <zodiac/controller/controller_plugin.h>
 #include <zodiac/runtime/runtime_logger.h>
+#include <zodiac/runtime/logger/logger_async.h>
+#include <zodiac/runtime/tracer/tracer.h>
+
+#include <stdio.h>
+#include <stdlib.h>
 
 logger_t runtime_logger;
+logger_async_t runtime_logger_async;
+controller_registry_t runtime_registry;
+
+/// Controller plug-ins loaded at startup, indexed by controller index.
+static controller_plugin_t runtime_plugins[MAX_NUMBER_OF_CONTROLLERS];
+
+#ifdef ZODIAC_TRACER
+/// File receiving the trace of the runtime at exit.
+#define RUNTIME_TRACE_PATH "zodiac_trace.json"
+#endif
 
 void console_log(callback_sender_t sender, logger_level_t logger_level, const char* message) {
-    // TODO: implement console logging
+    (void) sender;
+    fprintf(stderr, "[%s] %s\n", logger_level_to_string(logger_level), message);
+}
+
+/**
+ * @brief Loads the controller plug-ins given as `controller_index=path` arguments into the runtime registry.
+ *
+ * @return Whether every plug-in was loaded.
+ */
+static bool runtime_load_plugins(int argc, char *argv[]) {
+    char message[512];
+
+    for (int index = 1; index < argc; ++index) {
+        char *separator;
+        unsigned long controller_index = strtoul(argv[index], &separator, 0);
+        controller_plugin_t plugin;
+        controller_plugin_error_t error;
+
+        if (*separator != '=' || separator == argv[index] || controller_index >= MAX_NUMBER_OF_CONTROLLERS) {
+            snprintf(message, sizeof(message), "%s: expected controller_index=path", argv[index]);
+            RUNTIME_LOG_ERROR(message);
+            return false;
+        }
+
+        error = controller_plugin_load(&plugin, separator + 1, &runtime_registry, (controller_index_t) controller_index);
+
+        if (error != CONTROLLER_PLUGIN_ERROR_OK) {
+            snprintf(message, sizeof(message), "%s: could not load the controller plug-in (error %d)%s%s",
+                     separator + 1, (int) error, plugin.message[0] != '\0' ? ": " : "", plugin.message);
+            RUNTIME_LOG_ERROR(message);
+            return false;
+        }
+
+        runtime_plugins[controller_index] = plugin;
+        snprintf(message, sizeof(message), "controller %lu: %s", controller_index, plugin.descriptor->name);
+        RUNTIME_LOG_INFO(message);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Unloads every controller plug-in loaded at startup.
+ */
+static void runtime_unload_plugins(void) {
+    for (size_t index = 0; index < MAX_NUMBER_OF_CONTROLLERS; ++index) {
+        controller_plugin_unload(&runtime_plugins[index]);
+    }
 }
 
-int main(void)
+int main(int argc, char *argv[])
 {
-    logger_init(&runtime_logger, nullptr, console_log);
-	return 0;
-}
\ No newline at end of file
+    int status = EXIT_SUCCESS;
+    bool asynchronous = logger_async_start(&runtime_logger_async, nullptr, console_log, nullptr)
+                        == LOGGER_ASYNC_ERROR_OK;
+
+    if (asynchronous) {
+        logger_init_async(&runtime_logger, &runtime_logger_async);
+    } else {
+        logger_init(&runtime_logger, nullptr, console_log);
+    }
+
+    controller_registry_init(&runtime_registry);
+    if (!runtime_load_plugins(argc, argv)) {
+        status = EXIT_FAILURE;
+    }
+
+    runtime_unload_plugins();
+
+    if (asynchronous) {
+        logger_async_stop(&runtime_logger_async);
+    }
+
+#ifdef ZODIAC_TRACER
+    tracer_export_file(RUNTIME_TRACE_PATH);
+#endif
+
+	return status;
+}
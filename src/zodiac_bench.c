@@ -0,0 +1,580 @@
+/**
+ * @file zodiac_bench.c
+ * @brief Microbenchmarks of the instruction reader, logger, dispatch, seek and checksum hot paths.
+ *
+ * Usage: zodiac_bench [number_of_instructions [number_of_repetitions]]. The benchmarks run
+ * on a synthetic program generated from a fixed seed, so runs are reproducible. Each
+ * benchmark is repeated and the fastest repetition is reported, together with the
+ * median, as a JSON document on the standard output.
+ */
+#include <zodiac/executor/executor.h>
+#include <zodiac/instruction/instruction_reader_buffer.h>
+#include <zodiac/instruction/instruction_reader_fd.h>
+#include <zodiac/instruction/instruction_reader_container.h>
+#include <zodiac/instruction/instruction_reader_mmap.h>
+#include <zodiac/instruction/instruction_reader_prefetch.h>
+#include <zodiac/instruction/instruction_reader_program.h>
+#include <zodiac/platform/platform_checksum.h>
+#include <zodiac/runtime/logger/logger_async.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/// Default number of instructions of the synthetic program.
+#define BENCH_DEFAULT_NUMBER_OF_INSTRUCTIONS 1000000
+
+/// Default number of repetitions of every benchmark.
+#define BENCH_DEFAULT_NUMBER_OF_REPETITIONS 5
+
+/// Max number of repetitions of every benchmark.
+#define BENCH_MAX_NUMBER_OF_REPETITIONS 64
+
+/// Number of messages logged by the logger benchmarks.
+#define BENCH_NUMBER_OF_MESSAGES 200000
+
+/// Number of instructions fetched per call by the batched reader benchmarks.
+#define BENCH_BATCH_SIZE 64
+
+/// Seed of the generator of the synthetic program.
+#define BENCH_SEED 0x5eed2024u
+
+/**
+ * @struct bench_context_s
+ * @brief Represents the inputs shared by the benchmarks.
+ */
+typedef struct bench_context_s {
+    instruction_program_t program;     ///< The synthetic program.
+    char path[64];                     ///< The file holding the packed synthetic program.
+    char container_path[64];           ///< The file holding the synthetic program as a container.
+    size_t number_of_instructions;     ///< Number of instructions of the synthetic program.
+    controller_registry_t registry;    ///< Registry of the no-op controller used for dispatch.
+    executor_image_t image;            ///< The pre-decoded synthetic program.
+} bench_context_t;
+
+/// Prevents the compiler from discarding the work of a benchmark.
+static volatile uint64_t bench_sink;
+
+/**
+ * @brief Runs one repetition of a benchmark.
+ *
+ * @return Number of operations performed.
+ */
+typedef uint64_t (*bench_callback_t)(bench_context_t *context);
+
+/**
+ * @brief Advances the generator of the synthetic program.
+ */
+static uint32_t bench_random(uint32_t *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/**
+ * @brief Operation doing nothing, used to measure the dispatch cost alone.
+ */
+static controller_operation_result_t bench_operation(callback_sender sender,
+                                                     struct executor_s *executor,
+                                                     const instruction_header_t *header,
+                                                     const instruction_operand_t *operands) {
+    (void) sender;
+    (void) executor;
+    (void) header;
+    (void) operands;
+    return CONTROLLER_OPERATION_RESULT_CONTINUE;
+}
+
+/**
+ * @brief Logging callback discarding the message, used to measure the logger alone.
+ */
+static void bench_log(callback_sender_t sender, logger_level_t logger_level, const char *message) {
+    (void) sender;
+    bench_sink += (uint64_t) logger_level + (uint8_t) message[0];
+}
+
+/**
+ * @brief Reads a whole reader one instruction at a time.
+ */
+static uint64_t bench_drain(instruction_reader_t *reader) {
+    instruction_t instruction;
+    uint64_t number_of_instructions = 0;
+    uint64_t checksum = 0;
+
+    while (instruction_reader_read(reader, &instruction) == INSTRUCTION_READER_READ_ERROR_OK) {
+        checksum += instruction.header.operation_index + instruction.operands[0];
+        ++number_of_instructions;
+    }
+
+    bench_sink += checksum;
+    return number_of_instructions;
+}
+
+/**
+ * @brief Reads a whole reader in batches.
+ */
+static uint64_t bench_drain_many(instruction_reader_t *reader) {
+    static instruction_t instructions[BENCH_BATCH_SIZE];
+    uint64_t number_of_instructions = 0;
+    uint64_t checksum = 0;
+    size_t number_of_read_instructions;
+
+    do {
+        instruction_reader_read_many(reader, instructions, BENCH_BATCH_SIZE, &number_of_read_instructions);
+
+        for (size_t index = 0; index < number_of_read_instructions; ++index) {
+            checksum += instructions[index].header.operation_index + instructions[index].operands[0];
+        }
+
+        number_of_instructions += number_of_read_instructions;
+    } while (number_of_read_instructions == BENCH_BATCH_SIZE);
+
+    bench_sink += checksum;
+    return number_of_instructions;
+}
+
+static uint64_t bench_reader_memory(bench_context_t *context) {
+    instruction_reader_t reader;
+    instruction_reader_program_t cursor;
+
+    instruction_reader_init_program(&reader, &cursor, &context->program);
+    return bench_drain(&reader);
+}
+
+static uint64_t bench_reader_memory_many(bench_context_t *context) {
+    instruction_reader_t reader;
+    instruction_reader_program_t cursor;
+
+    instruction_reader_init_program(&reader, &cursor, &context->program);
+    return bench_drain_many(&reader);
+}
+
+static uint64_t bench_reader_buffer(bench_context_t *context) {
+    instruction_reader_t reader;
+    instruction_reader_buffer_t buffer;
+
+    instruction_reader_buffer_init(&buffer, context->program.code, context->program.size);
+    instruction_reader_init_buffer(&reader, &buffer);
+    return bench_drain(&reader);
+}
+
+/**
+ * @brief Walks the program through the inline cursor of the buffer reader, without copies.
+ */
+static uint64_t bench_reader_buffer_view(bench_context_t *context) {
+    instruction_reader_buffer_t buffer;
+    instruction_view_t view;
+    uint64_t number_of_instructions = 0;
+    uint64_t checksum = 0;
+
+    instruction_reader_buffer_init(&buffer, context->program.code, context->program.size);
+
+    while (instruction_reader_buffer_view(&buffer, &view) == INSTRUCTION_READER_READ_ERROR_OK) {
+        checksum += view.header->operation_index + view.header->number_of_operands;
+        ++number_of_instructions;
+    }
+
+    bench_sink += checksum;
+    return number_of_instructions;
+}
+
+static uint64_t bench_reader_file(bench_context_t *context) {
+    instruction_reader_t reader;
+    instruction_reader_fd_t fd_reader;
+    uint64_t number_of_instructions;
+
+    if (instruction_reader_fd_open(&fd_reader, context->path, nullptr) != INSTRUCTION_READER_FD_ERROR_OK) {
+        return 0;
+    }
+
+    instruction_reader_init_fd(&reader, &fd_reader);
+    number_of_instructions = bench_drain(&reader);
+    instruction_reader_fd_close(&fd_reader);
+    return number_of_instructions;
+}
+
+/**
+ * @brief Reads the program file through a lookahead stage.
+ */
+static uint64_t bench_reader_prefetch(bench_context_t *context, bool threaded) {
+    instruction_reader_t reader;
+    instruction_reader_t source;
+    instruction_reader_fd_t fd_reader;
+    instruction_reader_prefetch_t prefetch;
+    uint64_t number_of_instructions;
+
+    if (instruction_reader_fd_open(&fd_reader, context->path, nullptr) != INSTRUCTION_READER_FD_ERROR_OK) {
+        return 0;
+    }
+
+    instruction_reader_init_fd(&source, &fd_reader);
+    if (instruction_reader_prefetch_init(&prefetch, &source, 0, threaded, nullptr) != INSTRUCTION_READER_PREFETCH_ERROR_OK) {
+        instruction_reader_fd_close(&fd_reader);
+        return 0;
+    }
+
+    instruction_reader_init_prefetch(&reader, &prefetch);
+    number_of_instructions = bench_drain(&reader);
+    instruction_reader_prefetch_free(&prefetch);
+    instruction_reader_fd_close(&fd_reader);
+    return number_of_instructions;
+}
+
+static uint64_t bench_reader_prefetch_inline(bench_context_t *context) {
+    return bench_reader_prefetch(context, false);
+}
+
+static uint64_t bench_reader_prefetch_thread(bench_context_t *context) {
+    return bench_reader_prefetch(context, true);
+}
+
+static uint64_t bench_reader_file_many(bench_context_t *context) {
+    instruction_reader_t reader;
+    instruction_reader_fd_t fd_reader;
+    uint64_t number_of_instructions;
+
+    if (instruction_reader_fd_open(&fd_reader, context->path, nullptr) != INSTRUCTION_READER_FD_ERROR_OK) {
+        return 0;
+    }
+
+    instruction_reader_init_fd(&reader, &fd_reader);
+    number_of_instructions = bench_drain_many(&reader);
+    instruction_reader_fd_close(&fd_reader);
+    return number_of_instructions;
+}
+
+static uint64_t bench_reader_mmap(bench_context_t *context) {
+    instruction_reader_t reader;
+    instruction_reader_mmap_t mapping;
+    uint64_t number_of_instructions;
+
+    if (instruction_reader_mmap_open(&mapping, context->path) != INSTRUCTION_READER_MMAP_ERROR_OK) {
+        return 0;
+    }
+
+    instruction_reader_init_mmap(&reader, &mapping);
+    number_of_instructions = bench_drain(&reader);
+    instruction_reader_mmap_close(&mapping);
+    return number_of_instructions;
+}
+
+static uint64_t bench_reader_mmap_many(bench_context_t *context) {
+    instruction_reader_t reader;
+    instruction_reader_mmap_t mapping;
+    uint64_t number_of_instructions;
+
+    if (instruction_reader_mmap_open(&mapping, context->path) != INSTRUCTION_READER_MMAP_ERROR_OK) {
+        return 0;
+    }
+
+    instruction_reader_init_mmap(&reader, &mapping);
+    number_of_instructions = bench_drain_many(&reader);
+    instruction_reader_mmap_close(&mapping);
+    return number_of_instructions;
+}
+
+static uint64_t bench_reader_container(bench_context_t *context) {
+    instruction_reader_t reader;
+    instruction_reader_container_t container;
+    uint64_t number_of_instructions;
+
+    if (instruction_reader_container_open(&container, context->container_path)
+        != INSTRUCTION_READER_CONTAINER_ERROR_OK) {
+        return 0;
+    }
+
+    instruction_reader_init_container(&reader, &container);
+    number_of_instructions = bench_drain(&reader);
+    instruction_reader_container_close(&container);
+    return number_of_instructions;
+}
+
+static uint64_t bench_logger_sync(bench_context_t *context) {
+    logger_t logger;
+
+    (void) context;
+    logger_init(&logger, nullptr, bench_log);
+
+    for (size_t index = 0; index < BENCH_NUMBER_OF_MESSAGES; ++index) {
+        logger_log(&logger, LOGGER_LEVEL_INFO, "benchmark message");
+    }
+
+    return BENCH_NUMBER_OF_MESSAGES;
+}
+
+static uint64_t bench_logger_async(bench_context_t *context) {
+    logger_t logger;
+    logger_async_t async;
+    logger_async_options_t options;
+
+    (void) context;
+    logger_async_options_init(&options);
+    options.overflow = LOGGER_ASYNC_OVERFLOW_BLOCK;
+
+    if (logger_async_start(&async, nullptr, bench_log, &options) != LOGGER_ASYNC_ERROR_OK) {
+        return 0;
+    }
+
+    logger_init_async(&logger, &async);
+
+    for (size_t index = 0; index < BENCH_NUMBER_OF_MESSAGES; ++index) {
+        logger_log(&logger, LOGGER_LEVEL_INFO, "benchmark message");
+    }
+
+    logger_async_stop(&async);
+    return BENCH_NUMBER_OF_MESSAGES;
+}
+
+static uint64_t bench_dispatch_program(bench_context_t *context) {
+    executor_t executor;
+
+    executor_init_program(&executor, &context->registry, &context->program);
+    executor_run(&executor);
+    return executor.number_of_executed_instructions;
+}
+
+static uint64_t bench_dispatch_image(bench_context_t *context) {
+    executor_t executor;
+
+    executor_init_image(&executor, &context->image);
+    executor_run(&executor);
+    return executor.number_of_executed_instructions;
+}
+
+static uint64_t bench_dispatch_buffer(bench_context_t *context) {
+    executor_t executor;
+    instruction_reader_t reader;
+    instruction_reader_buffer_t buffer;
+
+    instruction_reader_buffer_init(&buffer, context->program.code, context->program.size);
+    instruction_reader_init_buffer(&reader, &buffer);
+    executor_init(&executor, &context->registry, &reader);
+    executor_run(&executor);
+    return executor.number_of_executed_instructions;
+}
+
+static uint64_t bench_dispatch_stream(bench_context_t *context) {
+    executor_t executor;
+    instruction_reader_t reader;
+    instruction_reader_program_t cursor;
+
+    instruction_reader_init_program(&reader, &cursor, &context->program);
+    executor_init(&executor, &context->registry, &reader);
+    executor_run(&executor);
+    return executor.number_of_executed_instructions;
+}
+
+static uint64_t bench_seek_image(bench_context_t *context) {
+    executor_t executor;
+    uint32_t state = BENCH_SEED;
+
+    executor_init_image(&executor, &context->image);
+
+    for (size_t index = 0; index < context->number_of_instructions; ++index) {
+        executor_seek(&executor,
+                      (instruction_reader_offset_t) (bench_random(&state) % context->program.size),
+                      INSTRUCTION_READER_SEEK_SET);
+        bench_sink += executor.position;
+    }
+
+    return context->number_of_instructions;
+}
+
+static uint64_t bench_checksum_crc32c(bench_context_t *context) {
+    bench_sink += platform_checksum_crc32c(0, context->program.code, context->program.size);
+    return context->program.size;
+}
+
+/**
+ * @brief Builds the synthetic program, writes it to a file, registers the no-op controller
+ * and pre-decodes the program.
+ *
+ * @return Whether the context is ready.
+ */
+static bool bench_context_init(bench_context_t *context, size_t number_of_instructions) {
+    static controller_operation_callback_t operations[MAX_NUMBER_OF_CONTROLLER_OPERATIONS];
+    instruction_operands_t operands;
+    instruction_header_t header;
+    controller_t controller;
+    instruction_reader_t reader;
+    instruction_reader_program_t cursor;
+    uint32_t state = BENCH_SEED;
+    FILE *stream;
+    int fd;
+
+    instruction_program_init(&context->program);
+    context->number_of_instructions = number_of_instructions;
+
+    for (size_t index = 0; index < number_of_instructions; ++index) {
+        uint32_t random = bench_random(&state);
+
+        header.controller_index = 0;
+        header.operation_index = (operation_index_t) random;
+        header.number_of_operands = (operands_length_t) ((random >> 8) % 5);
+
+        for (size_t operand = 0; operand < header.number_of_operands; ++operand) {
+            operands[operand] = (instruction_operand_t) (random >> (operand * 4));
+        }
+
+        if (instruction_program_append(&context->program, &header, operands) != INSTRUCTION_PROGRAM_ERROR_OK) {
+            return false;
+        }
+    }
+
+    strcpy(context->path, "/tmp/zodiac_bench_XXXXXX");
+    fd = mkstemp(context->path);
+    if (fd < 0) {
+        return false;
+    }
+
+    stream = fdopen(fd, "wb");
+    if (stream == nullptr
+        || fwrite(context->program.code, 1, context->program.size, stream) != context->program.size
+        || fclose(stream) != 0) {
+        unlink(context->path);
+        return false;
+    }
+
+    strcpy(context->container_path, "/tmp/zodiac_bench_XXXXXX");
+    fd = mkstemp(context->container_path);
+    if (fd < 0) {
+        unlink(context->path);
+        return false;
+    }
+
+    stream = fdopen(fd, "wb");
+    if (stream == nullptr
+        || instruction_container_pack(stream, context->program.code, context->program.size, 0)
+           != INSTRUCTION_CONTAINER_ERROR_OK
+        || fclose(stream) != 0) {
+        unlink(context->path);
+        unlink(context->container_path);
+        return false;
+    }
+
+    for (size_t index = 0; index < MAX_NUMBER_OF_CONTROLLER_OPERATIONS; ++index) {
+        operations[index] = bench_operation;
+    }
+
+    controller_registry_init(&context->registry);
+    controller_init(&controller, nullptr, operations, MAX_NUMBER_OF_CONTROLLER_OPERATIONS);
+    controller_registry_register(&context->registry, 0, &controller);
+
+    instruction_reader_init_program(&reader, &cursor, &context->program);
+    executor_image_init(&context->image);
+    return executor_image_load(&context->image, &context->registry, &reader) == EXECUTOR_IMAGE_ERROR_OK;
+}
+
+static void bench_context_free(bench_context_t *context) {
+    unlink(context->path);
+    unlink(context->container_path);
+    executor_image_free(&context->image);
+    instruction_program_free(&context->program);
+}
+
+static int bench_compare(const void *left, const void *right) {
+    uint64_t a = *(const uint64_t *) left;
+    uint64_t b = *(const uint64_t *) right;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Runs a benchmark and prints its result as a JSON object.
+ */
+static void bench_run(bench_context_t *context, const char *name, const char *unit, bench_callback_t callback,
+                      size_t number_of_repetitions, bool first) {
+
+    uint64_t durations[BENCH_MAX_NUMBER_OF_REPETITIONS];
+    uint64_t number_of_operations = 0;
+    double best;
+    double median;
+
+    callback(context);
+
+    for (size_t repetition = 0; repetition < number_of_repetitions; ++repetition) {
+        uint64_t start = platform_clock_monotonic();
+        number_of_operations = callback(context);
+        durations[repetition] = platform_clock_monotonic() - start;
+    }
+
+    qsort(durations, number_of_repetitions, sizeof(durations[0]), bench_compare);
+
+    if (number_of_operations == 0) {
+        number_of_operations = 1;
+    }
+
+    best = (double) durations[0] / (double) number_of_operations;
+    median = (double) durations[number_of_repetitions / 2] / (double) number_of_operations;
+
+    printf("%s\n    {\"name\": \"%s\", \"unit\": \"%s\", \"operations\": %llu, \"repetitions\": %zu, "
+           "\"ns_per_operation\": %.3f, \"median_ns_per_operation\": %.3f, \"operations_per_second\": %.0f}",
+           first ? "" : ",", name, unit, (unsigned long long) number_of_operations, number_of_repetitions,
+           best, median, best > 0 ? 1e9 / best : 0.0);
+}
+
+int main(int argc, char *argv[]) {
+    static bench_context_t context;
+    size_t number_of_instructions = BENCH_DEFAULT_NUMBER_OF_INSTRUCTIONS;
+    size_t number_of_repetitions = BENCH_DEFAULT_NUMBER_OF_REPETITIONS;
+
+    static const struct {
+        const char *name;
+        const char *unit;
+        bench_callback_t callback;
+    } benchmarks[] = {
+            {"reader_read.memory",          "instruction", bench_reader_memory},
+            {"reader_read.buffer",          "instruction", bench_reader_buffer},
+            {"reader_view.buffer",          "instruction", bench_reader_buffer_view},
+            {"reader_read.file",            "instruction", bench_reader_file},
+            {"reader_read.mmap",            "instruction", bench_reader_mmap},
+            {"reader_read.container",       "instruction", bench_reader_container},
+            {"reader_read.prefetch",        "instruction", bench_reader_prefetch_inline},
+            {"reader_read.prefetch_thread", "instruction", bench_reader_prefetch_thread},
+            {"reader_read_many.memory",     "instruction", bench_reader_memory_many},
+            {"reader_read_many.file",       "instruction", bench_reader_file_many},
+            {"reader_read_many.mmap",       "instruction", bench_reader_mmap_many},
+            {"logger_log.sync",             "message",     bench_logger_sync},
+            {"logger_log.async",            "message",     bench_logger_async},
+            {"dispatch.image",              "instruction", bench_dispatch_image},
+            {"dispatch.program",            "instruction", bench_dispatch_program},
+            {"dispatch.buffer",             "instruction", bench_dispatch_buffer},
+            {"dispatch.stream",             "instruction", bench_dispatch_stream},
+            {"seek.image",                  "seek",        bench_seek_image},
+            {"checksum.crc32c",             "byte",        bench_checksum_crc32c}
+    };
+
+    if (argc > 1) {
+        number_of_instructions = strtoull(argv[1], nullptr, 10);
+    }
+
+    if (argc > 2) {
+        number_of_repetitions = strtoull(argv[2], nullptr, 10);
+    }
+
+    if (number_of_instructions == 0 || number_of_repetitions == 0
+        || number_of_repetitions > BENCH_MAX_NUMBER_OF_REPETITIONS) {
+        fprintf(stderr, "usage: %s [number_of_instructions [number_of_repetitions <= %d]]\n",
+                argv[0], BENCH_MAX_NUMBER_OF_REPETITIONS);
+        return EXIT_FAILURE;
+    }
+
+    if (!bench_context_init(&context, number_of_instructions)) {
+        fprintf(stderr, "failed to prepare the benchmark program\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("{\n  \"version\": \"%s\",\n  \"instructions\": %zu,\n  \"program_bytes\": %zu,\n  \"benchmarks\": [",
+           PROJECT_VERSION, context.number_of_instructions, context.program.size);
+
+    for (size_t index = 0; index < sizeof(benchmarks) / sizeof(benchmarks[0]); ++index) {
+        bench_run(&context, benchmarks[index].name, benchmarks[index].unit, benchmarks[index].callback,
+                  number_of_repetitions, index == 0);
+    }
+
+    printf("\n  ]\n}\n");
+
+    bench_context_free(&context);
+    return EXIT_SUCCESS;
+}
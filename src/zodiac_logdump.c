@@ -0,0 +1,335 @@
+/**
+ * @file zodiac_logdump.c
+ * @brief Decodes a binary log written by logger_binary_t into text.
+ *
+ * Usage: zodiac_logdump [file]. Reads the standard input when no file is given and
+ * prints one line per message: the timestamp in seconds, the level and the message
+ * formatted with its registered format string.
+ */
+#include <zodiac/runtime/logger/logger_binary.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+/// Max length of a decoded message; longer messages are truncated.
+#define LOGDUMP_MESSAGE_SIZE 4096
+
+/// Max length of a single conversion specification of a format string.
+#define LOGDUMP_SPECIFICATION_SIZE 32
+
+/**
+ * @struct logdump_argument_s
+ * @brief Represents a decoded argument of a message.
+ */
+typedef struct logdump_argument_s {
+    logger_binary_argument_type_t type;                 /*!< The type of the argument */
+    uint64_t bits;                                      /*!< The value of a number or pointer argument */
+    char string[LOGGER_BINARY_MAX_STRING_SIZE + 1];     /*!< The value of a string argument */
+} logdump_argument_t;
+
+/// Format strings of the stream, indexed by identifier.
+static char *logdump_formats[LOGGER_BINARY_MAX_FORMATS];
+
+/**
+ * @brief Reads exactly the given number of bytes.
+ */
+static bool logdump_read(FILE *stream, void *data, size_t size) {
+    return fread(data, 1, size, stream) == size;
+}
+
+static bool logdump_read16(FILE *stream, uint16_t *value) {
+    uint8_t bytes[2];
+
+    if (!logdump_read(stream, bytes, sizeof(bytes))) {
+        return false;
+    }
+
+    *value = (uint16_t) (bytes[0] | (bytes[1] << 8));
+    return true;
+}
+
+static bool logdump_read64(FILE *stream, uint64_t *value) {
+    uint8_t bytes[8];
+
+    if (!logdump_read(stream, bytes, sizeof(bytes))) {
+        return false;
+    }
+
+    *value = 0;
+    for (size_t index = 0; index < 8; ++index) {
+        *value |= (uint64_t) bytes[index] << (index * 8);
+    }
+    return true;
+}
+
+/**
+ * @brief Formats one argument according to a conversion specification.
+ *
+ * The length modifiers of the specification are replaced to match the stored width of
+ * the argument, so the format strings of the call sites can be used unchanged.
+ *
+ * @return Number of characters the conversion produces, as snprintf().
+ */
+static int logdump_convert(char *output, size_t size, const char *specification, size_t length,
+                           const logdump_argument_t *argument) {
+
+    char conversion = specification[length - 1];
+    char format[LOGDUMP_SPECIFICATION_SIZE + 4];
+    size_t format_length = 0;
+    double floating;
+
+    for (size_t index = 0; index + 1 < length; ++index) {
+        if (strchr("hljztL", specification[index]) == nullptr) {
+            format[format_length++] = specification[index];
+        }
+    }
+
+    switch (conversion) {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+            format[format_length++] = 'l';
+            format[format_length++] = 'l';
+            format[format_length++] = conversion;
+            format[format_length] = '\0';
+            if (argument->type == LOGGER_BINARY_ARGUMENT_INT && (conversion == 'd' || conversion == 'i')) {
+                return snprintf(output, size, format, (long long) argument->bits);
+            }
+            return snprintf(output, size, format, (unsigned long long) argument->bits);
+        case 'c':
+            format[format_length++] = conversion;
+            format[format_length] = '\0';
+            return snprintf(output, size, format, (int) argument->bits);
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            format[format_length++] = conversion;
+            format[format_length] = '\0';
+            if (argument->type == LOGGER_BINARY_ARGUMENT_DOUBLE) {
+                memcpy(&floating, &argument->bits, sizeof(floating));
+            } else if (argument->type == LOGGER_BINARY_ARGUMENT_INT) {
+                floating = (double) (int64_t) argument->bits;
+            } else {
+                floating = (double) argument->bits;
+            }
+            return snprintf(output, size, format, floating);
+        case 's':
+            format[format_length++] = conversion;
+            format[format_length] = '\0';
+            return snprintf(output, size, format,
+                            argument->type == LOGGER_BINARY_ARGUMENT_STRING ? argument->string : "(?)");
+        case 'p':
+            return snprintf(output, size, "0x%llx", (unsigned long long) argument->bits);
+        default:
+            return snprintf(output, size, "%.*s", (int) length, specification);
+    }
+}
+
+/**
+ * @brief Formats a message from its format string and decoded arguments.
+ */
+static void logdump_format(char *output, size_t size, const char *format,
+                           const logdump_argument_t *arguments, size_t number_of_arguments) {
+
+    size_t used = 0;
+    size_t argument_index = 0;
+    int written;
+
+    output[0] = '\0';
+
+    while (*format != '\0' && used + 1 < size) {
+        size_t length;
+
+        if (*format != '%') {
+            output[used++] = *format++;
+            output[used] = '\0';
+            continue;
+        }
+
+        if (format[1] == '%') {
+            output[used++] = '%';
+            output[used] = '\0';
+            format += 2;
+            continue;
+        }
+
+        length = 1;
+        while (format[length] != '\0' && strchr("diouxXcfFeEgGaAsp", format[length]) == nullptr) {
+            ++length;
+        }
+
+        if (format[length] == '\0' || length + 1 > LOGDUMP_SPECIFICATION_SIZE) {
+            written = snprintf(output + used, size - used, "%s", format);
+            used += written > 0 ? (size_t) written : 0;
+            break;
+        }
+
+        ++length;
+
+        if (argument_index < number_of_arguments) {
+            written = logdump_convert(output + used, size - used, format, length, &arguments[argument_index++]);
+        } else {
+            written = snprintf(output + used, size - used, "(missing)");
+        }
+
+        if (written > 0) {
+            used += (size_t) written;
+        }
+
+        if (used >= size) {
+            break;
+        }
+
+        format += length;
+    }
+}
+
+/**
+ * @brief Reads a format record and registers its format string.
+ */
+static bool logdump_read_format(FILE *stream) {
+    uint16_t format_id;
+    uint16_t length;
+    char *format;
+
+    if (!logdump_read16(stream, &format_id) || !logdump_read16(stream, &length)) {
+        return false;
+    }
+
+    format = malloc((size_t) length + 1);
+    if (format == nullptr || !logdump_read(stream, format, length)) {
+        free(format);
+        return false;
+    }
+
+    format[length] = '\0';
+
+    if (format_id >= LOGGER_BINARY_MAX_FORMATS) {
+        free(format);
+        return true;
+    }
+
+    free(logdump_formats[format_id]);
+    logdump_formats[format_id] = format;
+    return true;
+}
+
+/**
+ * @brief Reads a message record and prints it.
+ */
+static bool logdump_read_message(FILE *stream, FILE *output) {
+    static logdump_argument_t arguments[LOGGER_BINARY_MAX_ARGUMENTS];
+    char message[LOGDUMP_MESSAGE_SIZE];
+    uint16_t format_id;
+    uint8_t level;
+    uint8_t number_of_arguments;
+    uint64_t timestamp;
+    const char *format;
+
+    if (!logdump_read16(stream, &format_id)
+        || !logdump_read(stream, &level, 1)
+        || !logdump_read(stream, &number_of_arguments, 1)
+        || !logdump_read64(stream, &timestamp)
+        || number_of_arguments > LOGGER_BINARY_MAX_ARGUMENTS) {
+        return false;
+    }
+
+    for (size_t index = 0; index < number_of_arguments; ++index) {
+        logdump_argument_t *argument = &arguments[index];
+        uint8_t type;
+        uint16_t length;
+
+        if (!logdump_read(stream, &type, 1)) {
+            return false;
+        }
+
+        argument->type = (logger_binary_argument_type_t) type;
+
+        if (argument->type == LOGGER_BINARY_ARGUMENT_STRING) {
+            if (!logdump_read16(stream, &length)
+                || length > LOGGER_BINARY_MAX_STRING_SIZE
+                || !logdump_read(stream, argument->string, length)) {
+                return false;
+            }
+            argument->string[length] = '\0';
+        } else if (!logdump_read64(stream, &argument->bits)) {
+            return false;
+        }
+    }
+
+    format = format_id < LOGGER_BINARY_MAX_FORMATS ? logdump_formats[format_id] : nullptr;
+    if (format == nullptr) {
+        snprintf(message, sizeof(message), "<unknown format %u>", (unsigned) format_id);
+    } else {
+        logdump_format(message, sizeof(message), format, arguments, number_of_arguments);
+    }
+
+    fprintf(output, "%llu.%09llu [%s] %s\n",
+            (unsigned long long) (timestamp / 1000000000u),
+            (unsigned long long) (timestamp % 1000000000u),
+            logger_level_to_string((logger_level_t) level),
+            message);
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    char magic[LOGGER_BINARY_MAGIC_SIZE];
+    FILE *stream = stdin;
+    int kind;
+    int status = EXIT_SUCCESS;
+
+    if (argc > 2) {
+        fprintf(stderr, "usage: %s [file]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (argc == 2 && (stream = fopen(argv[1], "rb")) == nullptr) {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    if (!logdump_read(stream, magic, sizeof(magic))
+        || memcmp(magic, LOGGER_BINARY_MAGIC, LOGGER_BINARY_MAGIC_SIZE) != 0) {
+        fprintf(stderr, "not a zodiac binary log\n");
+        status = EXIT_FAILURE;
+    }
+
+    while (status == EXIT_SUCCESS && (kind = fgetc(stream)) != EOF) {
+        bool decoded;
+
+        switch (kind) {
+            case LOGGER_BINARY_RECORD_FORMAT:
+                decoded = logdump_read_format(stream);
+                break;
+            case LOGGER_BINARY_RECORD_MESSAGE:
+                decoded = logdump_read_message(stream, stdout);
+                break;
+            default:
+                decoded = false;
+                break;
+        }
+
+        if (!decoded) {
+            fprintf(stderr, "truncated or corrupt record\n");
+            status = EXIT_FAILURE;
+        }
+    }
+
+    for (size_t index = 0; index < LOGGER_BINARY_MAX_FORMATS; ++index) {
+        free(logdump_formats[index]);
+    }
+
+    if (stream != stdin) {
+        fclose(stream);
+    }
+
+    return status;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file zodiac_pack.c
+ * @brief Converts program files to and from the compressed container format.
+ *
+ * Usage: zodiac_pack [-b block_size] input output to compress a program file, and
+ * zodiac_pack -d input output to restore it from a container. See instruction_container.h
+ * for the format.
+ */
+#include <zodiac/instruction/instruction_reader_container.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+/// Number of bytes copied at once when restoring a program file.
+#define PACK_COPY_SIZE (64 * 1024)
+
+/**
+ * @brief Reads a whole file into memory.
+ *
+ * @return The contents of the file, or nullptr on failure.
+ */
+static uint8_t *pack_load(const char *path, size_t *size) {
+    FILE *stream = fopen(path, "rb");
+    uint8_t *data = nullptr;
+    size_t capacity = 0;
+    size_t received;
+
+    *size = 0;
+
+    if (stream == nullptr) {
+        return nullptr;
+    }
+
+    do {
+        if (*size == capacity) {
+            uint8_t *grown;
+
+            capacity = capacity != 0 ? capacity * 2 : PACK_COPY_SIZE;
+            grown = realloc(data, capacity);
+            if (grown == nullptr) {
+                free(data);
+                fclose(stream);
+                return nullptr;
+            }
+            data = grown;
+        }
+
+        received = fread(data + *size, 1, capacity - *size, stream);
+        *size += received;
+    } while (received != 0);
+
+    if (ferror(stream)) {
+        free(data);
+        data = nullptr;
+    }
+
+    fclose(stream);
+    return data;
+}
+
+/**
+ * @brief Compresses a program file into a container.
+ */
+static int pack_compress(const char *input, const char *output, size_t block_size) {
+    FILE *stream;
+    uint8_t *data;
+    size_t size;
+    instruction_container_error_t error;
+
+    data = pack_load(input, &size);
+    if (data == nullptr) {
+        perror(input);
+        return EXIT_FAILURE;
+    }
+
+    stream = fopen(output, "wb");
+    if (stream == nullptr) {
+        perror(output);
+        free(data);
+        return EXIT_FAILURE;
+    }
+
+    error = instruction_container_pack(stream, data, size, block_size);
+    free(data);
+
+    if (fclose(stream) != 0 || error != INSTRUCTION_CONTAINER_ERROR_OK) {
+        fprintf(stderr, "%s: could not write the container\n", output);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Restores a program file from a container.
+ */
+static int pack_decompress(const char *input, const char *output) {
+    static uint8_t buffer[PACK_COPY_SIZE];
+    instruction_reader_container_t container;
+    FILE *stream;
+    size_t copied;
+    int status = EXIT_SUCCESS;
+
+    switch (instruction_reader_container_open(&container, input)) {
+        case INSTRUCTION_READER_CONTAINER_ERROR_OK:
+            break;
+        case INSTRUCTION_READER_CONTAINER_ERROR_OPEN:
+            perror(input);
+            return EXIT_FAILURE;
+        default:
+            fprintf(stderr, "%s: not a zodiac container\n", input);
+            return EXIT_FAILURE;
+    }
+
+    stream = fopen(output, "wb");
+    if (stream == nullptr) {
+        perror(output);
+        instruction_reader_container_close(&container);
+        return EXIT_FAILURE;
+    }
+
+    while ((copied = instruction_reader_container_copy(&container, buffer, sizeof(buffer))) != 0) {
+        if (fwrite(buffer, 1, copied, stream) != copied) {
+            status = EXIT_FAILURE;
+            break;
+        }
+    }
+
+    if (container.failed) {
+        fprintf(stderr, "%s: corrupt block\n", input);
+        status = EXIT_FAILURE;
+    }
+
+    if (fclose(stream) != 0) {
+        status = EXIT_FAILURE;
+    }
+
+    instruction_reader_container_close(&container);
+    return status;
+}
+
+int main(int argc, char *argv[]) {
+    size_t block_size = 0;
+    bool decompress = false;
+    int index = 1;
+
+    for (; index < argc && argv[index][0] == '-'; ++index) {
+        if (strcmp(argv[index], "-d") == 0) {
+            decompress = true;
+        } else if (strcmp(argv[index], "-b") == 0 && index + 1 < argc) {
+            block_size = strtoul(argv[++index], nullptr, 0);
+        } else {
+            break;
+        }
+    }
+
+    if (argc - index != 2) {
+        fprintf(stderr, "usage: %s [-d] [-b block_size] input output\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    return decompress
+           ? pack_decompress(argv[index], argv[index + 1])
+           : pack_compress(argv[index], argv[index + 1], block_size);
+}
@@ -0,0 +1,314 @@
+/**
+ * @file executor_equivalence.c
+ * @brief Checks that every execution mode runs a program the same way.
+ *
+ * A program jumping forward, backward onto the second instruction of a fused pair and
+ * backward into the middle of an instruction is run from a stream, from a program, from
+ * an image, from an image in slices of one instruction and from an image whose adjacent
+ * marks are fused. Every run must execute the same operations at the same offsets, stop
+ * with the same status and leave the executor at the same offset.
+ */
+#include <zodiac/executor/executor.h>
+#include <zodiac/executor/executor_fusion.h>
+#include <zodiac/instruction/instruction_reader_buffer.h>
+#include <zodiac/instruction/instruction_reader_program.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/// Largest number of operations a run may execute.
+#define EQUIVALENCE_MAX_TRACE_LENGTH 64
+
+/// Operation recording itself.
+#define EQUIVALENCE_MARK 0
+
+/// Operation jumping to the offset held by its operand.
+#define EQUIVALENCE_JUMP 1
+
+/// Operation jumping to the offset held by the operand of its pass, then falling through.
+#define EQUIVALENCE_LOOP 2
+
+/// Operation stopping the execution.
+#define EQUIVALENCE_HALT 3
+
+/**
+ * @struct equivalence_step_s
+ * @brief Structure that records an executed operation.
+ */
+typedef struct equivalence_step_s {
+    operation_index_t operation_index;        ///< The executed operation.
+    int operand;                              ///< Its first operand, -1 without operands.
+    instruction_reader_offset_t position;     ///< Offset of the executor after the instruction.
+} equivalence_step_t;
+
+/**
+ * @struct equivalence_run_s
+ * @brief Structure that records a run of the program.
+ */
+typedef struct equivalence_run_s {
+    equivalence_step_t steps[EQUIVALENCE_MAX_TRACE_LENGTH];   ///< The executed operations, in order.
+    size_t number_of_steps;                                   ///< Number of executed operations.
+    size_t number_of_loop_passes;                             ///< Number of loop instructions executed.
+    size_t number_of_fused_dispatches;                        ///< Number of fused operations executed.
+    executor_status_t status;                                 ///< Status the run stopped with.
+    instruction_reader_offset_t position;                     ///< Offset of the executor after the run.
+} equivalence_run_t;
+
+/// The run being recorded.
+static equivalence_run_t *equivalence_current;
+
+static void equivalence_record(const instruction_header_t *header,
+                               const instruction_operand_t *operands,
+                               instruction_reader_offset_t position) {
+
+    equivalence_step_t *step;
+
+    if (equivalence_current->number_of_steps == EQUIVALENCE_MAX_TRACE_LENGTH) {
+        return;
+    }
+
+    step = &equivalence_current->steps[equivalence_current->number_of_steps++];
+    step->operation_index = header->operation_index;
+    step->operand = header->number_of_operands != 0 ? operands[0] : -1;
+    step->position = position;
+}
+
+static controller_operation_result_t equivalence_operation(callback_sender sender,
+                                                           struct executor_s *executor,
+                                                           const instruction_header_t *header,
+                                                           const instruction_operand_t *operands) {
+    (void) sender;
+
+    equivalence_record(header, operands, executor_tell(executor));
+
+    switch (header->operation_index) {
+        case EQUIVALENCE_JUMP:
+            executor_seek(executor, operands[0], INSTRUCTION_READER_SEEK_SET);
+            break;
+        case EQUIVALENCE_LOOP:
+            if (equivalence_current->number_of_loop_passes < header->number_of_operands) {
+                executor_seek(executor, operands[equivalence_current->number_of_loop_passes],
+                              INSTRUCTION_READER_SEEK_SET);
+            }
+
+            ++equivalence_current->number_of_loop_passes;
+            break;
+        case EQUIVALENCE_HALT:
+            return CONTROLLER_OPERATION_RESULT_HALT;
+        default:
+            break;
+    }
+
+    return CONTROLLER_OPERATION_RESULT_CONTINUE;
+}
+
+/**
+ * @brief Fused operation executing two adjacent marks.
+ */
+static controller_operation_result_t equivalence_fused_marks(callback_sender sender,
+                                                             struct executor_s *executor,
+                                                             const instruction_header_t *header,
+                                                             const instruction_operand_t *operands) {
+    const instruction_header_t *second = executor_fusion_second(header);
+    instruction_reader_offset_t position = executor_tell(executor);
+    (void) sender;
+
+    ++equivalence_current->number_of_fused_dispatches;
+    equivalence_record(header, operands, position - (instruction_reader_offset_t) instruction_packed_size(second));
+    equivalence_record(second, executor_fusion_operands(second), position);
+    return CONTROLLER_OPERATION_RESULT_CONTINUE;
+}
+
+static void equivalence_append(instruction_program_t *program,
+                               operation_index_t operation_index,
+                               operands_length_t number_of_operands,
+                               const instruction_operand_t *operands) {
+
+    instruction_header_t header = {0, operation_index, number_of_operands};
+    instruction_program_append(program, &header, operands);
+}
+
+/**
+ * @brief Builds the program.
+ *
+ * The offsets are those of the instructions, the loop jumps back twice:
+ *
+ *      0  mark 7
+ *      4  mark 8          second of a fused pair
+ *      8  jump 16         forward, over mark 9
+ *     12  mark 9
+ *     16  mark 0 0 0      its last three bytes decode as a mark without operands
+ *     22  loop 4 19       back to 4, then back into the middle of the mark at 16
+ *     27  mark 10
+ *     31  halt
+ *     34  mark 11         never reached
+ */
+static void equivalence_build(instruction_program_t *program) {
+    static const instruction_operand_t mark_7[] = {7};
+    static const instruction_operand_t mark_8[] = {8};
+    static const instruction_operand_t jump[] = {16};
+    static const instruction_operand_t mark_9[] = {9};
+    static const instruction_operand_t mark_0[] = {0, EQUIVALENCE_MARK, 0};
+    static const instruction_operand_t loop[] = {4, 19};
+    static const instruction_operand_t mark_10[] = {10};
+    static const instruction_operand_t mark_11[] = {11};
+
+    equivalence_append(program, EQUIVALENCE_MARK, 1, mark_7);
+    equivalence_append(program, EQUIVALENCE_MARK, 1, mark_8);
+    equivalence_append(program, EQUIVALENCE_JUMP, 1, jump);
+    equivalence_append(program, EQUIVALENCE_MARK, 1, mark_9);
+    equivalence_append(program, EQUIVALENCE_MARK, 3, mark_0);
+    equivalence_append(program, EQUIVALENCE_LOOP, 2, loop);
+    equivalence_append(program, EQUIVALENCE_MARK, 1, mark_10);
+    equivalence_append(program, EQUIVALENCE_HALT, 0, nullptr);
+    equivalence_append(program, EQUIVALENCE_MARK, 1, mark_11);
+}
+
+/**
+ * @brief Runs an executor to its end, in slices of the given number of instructions or at once if 0.
+ */
+static void equivalence_run(executor_t *executor, uint64_t slice, equivalence_run_t *run) {
+    memset(run, 0, sizeof(*run));
+    equivalence_current = run;
+
+    if (slice == 0) {
+        run->status = executor_run(executor);
+    } else {
+        while ((run->status = executor_run_slice(executor, slice)) == EXECUTOR_STATUS_YIELDED) {
+        }
+    }
+
+    run->position = executor_tell(executor);
+}
+
+/**
+ * @brief Compares a run with the reference run.
+ */
+static bool equivalence_compare(const char *name, const equivalence_run_t *run, const equivalence_run_t *reference) {
+    if (run->status != reference->status || run->position != reference->position) {
+        fprintf(stderr, "%s: stopped with status %d at %lld instead of status %d at %lld\n", name,
+                run->status, (long long) run->position, reference->status, (long long) reference->position);
+        return false;
+    }
+
+    for (size_t index = 0; index < run->number_of_steps || index < reference->number_of_steps; ++index) {
+        const equivalence_step_t *step = &run->steps[index];
+        const equivalence_step_t *expected = &reference->steps[index];
+
+        if (index == run->number_of_steps || index == reference->number_of_steps
+            || step->operation_index != expected->operation_index
+            || step->operand != expected->operand
+            || step->position != expected->position) {
+            fprintf(stderr, "%s: operation %zu differs from the stream\n", name, index);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(void) {
+    static const controller_operation_callback_t operations[] = {
+        equivalence_operation, equivalence_operation, equivalence_operation, equivalence_operation
+    };
+    static const equivalence_step_t expected_steps[] = {
+        {EQUIVALENCE_MARK, 7, 4}, {EQUIVALENCE_MARK, 8, 8}, {EQUIVALENCE_JUMP, 16, 12},
+        {EQUIVALENCE_MARK, 0, 22}, {EQUIVALENCE_LOOP, 4, 27},
+        {EQUIVALENCE_MARK, 8, 8}, {EQUIVALENCE_JUMP, 16, 12},
+        {EQUIVALENCE_MARK, 0, 22}, {EQUIVALENCE_LOOP, 4, 27},
+        {EQUIVALENCE_MARK, -1, 22}, {EQUIVALENCE_LOOP, 4, 27},
+        {EQUIVALENCE_MARK, 10, 31}, {EQUIVALENCE_HALT, -1, 34}
+    };
+    static controller_registry_t registry;
+    static executor_fusion_t fusion;
+    static equivalence_run_t reference;
+    static equivalence_run_t run;
+    controller_t controller;
+    instruction_program_t program;
+    instruction_reader_buffer_t buffer;
+    instruction_reader_program_t cursor;
+    instruction_reader_t reader;
+    executor_image_t image;
+    executor_image_t fused_image;
+    executor_t executor;
+    executor_fusion_rule_t rule = {
+        {{0, 0}, {EQUIVALENCE_MARK, EQUIVALENCE_MARK}}, equivalence_fused_marks, nullptr
+    };
+    bool ok = true;
+
+    controller_registry_init(&registry);
+    controller_init(&controller, nullptr, operations, sizeof(operations) / sizeof(operations[0]));
+    controller_registry_register(&registry, 0, &controller);
+
+    instruction_program_init(&program);
+    equivalence_build(&program);
+
+    executor_image_init(&image);
+    executor_image_init(&fused_image);
+    executor_fusion_init(&fusion);
+
+    instruction_reader_init_program(&reader, &cursor, &program);
+    if (executor_image_load(&image, &registry, &reader) != EXECUTOR_IMAGE_ERROR_OK) {
+        fprintf(stderr, "could not load the image\n");
+        return EXIT_FAILURE;
+    }
+
+    instruction_reader_init_program(&reader, &cursor, &program);
+    if (executor_image_load(&fused_image, &registry, &reader) != EXECUTOR_IMAGE_ERROR_OK
+        || executor_fusion_add(&fusion, &rule) != EXECUTOR_FUSION_ERROR_OK
+        || executor_fusion_apply(&fusion, &fused_image) == 0) {
+        fprintf(stderr, "could not fuse the image\n");
+        return EXIT_FAILURE;
+    }
+
+    instruction_reader_buffer_init(&buffer, program.code, program.size);
+    instruction_reader_init_buffer(&reader, &buffer);
+    executor_init(&executor, &registry, &reader);
+    equivalence_run(&executor, 0, &reference);
+
+    ok &= reference.status == EXECUTOR_STATUS_HALTED
+          && reference.position == 34
+          && reference.number_of_steps == sizeof(expected_steps) / sizeof(expected_steps[0]);
+
+    for (size_t index = 0; ok && index < reference.number_of_steps; ++index) {
+        ok &= reference.steps[index].operation_index == expected_steps[index].operation_index
+              && reference.steps[index].operand == expected_steps[index].operand
+              && reference.steps[index].position == expected_steps[index].position;
+    }
+
+    if (!ok) {
+        fprintf(stderr, "stream: the program did not run as written\n");
+    }
+
+    executor_init_program(&executor, &registry, &program);
+    equivalence_run(&executor, 0, &run);
+    ok &= equivalence_compare("program", &run, &reference);
+
+    executor_init_image(&executor, &image);
+    equivalence_run(&executor, 0, &run);
+    ok &= equivalence_compare("image", &run, &reference);
+
+    executor_init_image(&executor, &image);
+    equivalence_run(&executor, 1, &run);
+    ok &= equivalence_compare("sliced image", &run, &reference);
+
+    executor_init_image(&executor, &fused_image);
+    equivalence_run(&executor, 0, &run);
+    ok &= equivalence_compare("fused image", &run, &reference);
+
+    if (run.number_of_fused_dispatches == 0) {
+        fprintf(stderr, "fused image: the fused pair was not dispatched\n");
+        ok = false;
+    }
+
+    executor_image_free(&fused_image);
+    executor_image_free(&image);
+    instruction_program_free(&program);
+
+    if (!ok) {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
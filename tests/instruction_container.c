@@ -0,0 +1,355 @@
+/**
+ * @file instruction_container.c
+ * @brief Checks the container codec and the reader decompressing containers on the fly.
+ *
+ * A stream mixing repetitive instructions, which compress, and instructions with random
+ * operands, which are stored raw, is compressed block by block and packed into a
+ * container whose last block is partial. Decompressing every block and reading the
+ * container back must return the original stream, seeks must clamp to its bounds, and
+ * containers with a corrupt header or index entry must be rejected.
+ */
+#include <zodiac/instruction/instruction_reader_container.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/// Uncompressed size of a block, small so the stream spans several of them.
+#define CONTAINER_BLOCK_SIZE 4096
+
+/// Number of repetitive instructions starting the stream.
+#define CONTAINER_NUMBER_OF_REPEATED 3000
+
+/// Number of instructions with random operands in the middle of the stream.
+#define CONTAINER_NUMBER_OF_RANDOM 40
+
+/// Number of instructions without operands ending the stream.
+#define CONTAINER_NUMBER_OF_EMPTY 1001
+
+/// Number of instructions of the stream.
+#define CONTAINER_NUMBER_OF_INSTRUCTIONS \
+    (CONTAINER_NUMBER_OF_REPEATED + CONTAINER_NUMBER_OF_RANDOM + CONTAINER_NUMBER_OF_EMPTY)
+
+/// Largest size of the stream in bytes.
+#define CONTAINER_CAPACITY (CONTAINER_NUMBER_OF_INSTRUCTIONS * (sizeof(instruction_header_t) + 255))
+
+/// The packed stream.
+static uint8_t container_stream[CONTAINER_CAPACITY];
+
+/// Offsets of the instructions of the stream, followed by its size.
+static size_t container_offsets[CONTAINER_NUMBER_OF_INSTRUCTIONS + 1];
+
+static bool container_expect(bool condition, const char *message) {
+    if (!condition) {
+        fprintf(stderr, "%s\n", message);
+    }
+
+    return condition;
+}
+
+/**
+ * @brief Appends an instruction to the stream.
+ */
+static size_t container_append(size_t size, uint8_t operation_index, uint8_t number_of_operands,
+                               const uint8_t *operands) {
+
+    container_stream[size] = 0;
+    container_stream[size + 1] = operation_index;
+    container_stream[size + 2] = number_of_operands;
+    memcpy(container_stream + size + sizeof(instruction_header_t), operands, number_of_operands);
+    return size + sizeof(instruction_header_t) + number_of_operands;
+}
+
+/**
+ * @brief Fills the stream and returns its size.
+ */
+static size_t container_fill(void) {
+    static const uint8_t repeated_operands[] = {1, 2};
+    uint8_t random_operands[255];
+    uint32_t state = UINT32_C(2463534242);
+    size_t number_of_instructions = 0;
+    size_t size = 0;
+
+    for (size_t index = 0; index < CONTAINER_NUMBER_OF_REPEATED; ++index) {
+        container_offsets[number_of_instructions++] = size;
+        size = container_append(size, (uint8_t) (index % 4), sizeof(repeated_operands), repeated_operands);
+    }
+
+    for (size_t index = 0; index < CONTAINER_NUMBER_OF_RANDOM; ++index) {
+        for (size_t operand = 0; operand < sizeof(random_operands); ++operand) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            random_operands[operand] = (uint8_t) state;
+        }
+
+        container_offsets[number_of_instructions++] = size;
+        size = container_append(size, (uint8_t) index, sizeof(random_operands), random_operands);
+    }
+
+    for (size_t index = 0; index < CONTAINER_NUMBER_OF_EMPTY; ++index) {
+        container_offsets[number_of_instructions++] = size;
+        size = container_append(size, (uint8_t) index, 0, random_operands);
+    }
+
+    container_offsets[number_of_instructions] = size;
+    return size;
+}
+
+/**
+ * @brief Compresses and decompresses the bytes and compares the result with them.
+ */
+static bool container_round_trip(const uint8_t *data, size_t size) {
+    static uint8_t compressed[CONTAINER_CAPACITY + CONTAINER_CAPACITY / 255 + 16];
+    static uint8_t decompressed[CONTAINER_CAPACITY];
+    size_t compressed_size = instruction_container_compress(data, size, compressed,
+                                                            instruction_container_bound(size));
+
+    if (compressed_size == 0 || compressed_size > instruction_container_bound(size)) {
+        return false;
+    }
+
+    if (instruction_container_decompress(compressed, compressed_size, decompressed, size) != size
+        || memcmp(decompressed, data, size) != 0) {
+        return false;
+    }
+
+    // The output is one byte short of the stream unless the stream is empty.
+    return size == 0 || instruction_container_decompress(compressed, compressed_size, decompressed, size - 1)
+                        == SIZE_MAX;
+}
+
+/**
+ * @brief Packs the first bytes of the stream into a temporary file and rewinds its descriptor.
+ *
+ * @return The file, or nullptr if it could not be written.
+ */
+static FILE *container_pack(size_t size) {
+    FILE *file = tmpfile();
+
+    if (file == nullptr) {
+        return nullptr;
+    }
+
+    if (instruction_container_pack(file, container_stream, size, CONTAINER_BLOCK_SIZE)
+        != INSTRUCTION_CONTAINER_ERROR_OK
+        || fflush(file) != 0
+        || lseek(fileno(file), 0, SEEK_SET) != 0) {
+        fclose(file);
+        return nullptr;
+    }
+
+    return file;
+}
+
+/**
+ * @brief Overwrites a little-endian value of a packed container.
+ */
+static bool container_patch(FILE *file, off_t offset, uint64_t value, size_t size) {
+    uint8_t bytes[8];
+
+    for (size_t index = 0; index < size; ++index) {
+        bytes[index] = (uint8_t) (value >> (index * 8));
+    }
+
+    return pwrite(fileno(file), bytes, size, offset) == (ssize_t) size;
+}
+
+/**
+ * @brief Reads the whole container and compares it with the stream, instruction by instruction.
+ */
+static bool container_check_stream(instruction_reader_container_t *container, size_t size) {
+    static uint8_t bytes[CONTAINER_CAPACITY];
+    instruction_reader_t reader;
+    instruction_t instruction;
+    instruction_reader_read_error_t read_error;
+    size_t number_of_instructions = 0;
+    bool ok = true;
+
+    instruction_reader_init_container(&reader, container);
+
+    ok &= container_expect(instruction_reader_container_copy(container, bytes, sizeof(bytes)) == size
+                           && memcmp(bytes, container_stream, size) == 0,
+                           "the container does not hold the stream");
+
+    instruction_reader_seek(&reader, 0, INSTRUCTION_READER_SEEK_SET);
+
+    while ((read_error = instruction_reader_read(&reader, &instruction)) == INSTRUCTION_READER_READ_ERROR_OK) {
+        size_t offset = container_offsets[number_of_instructions];
+
+        if (number_of_instructions == CONTAINER_NUMBER_OF_INSTRUCTIONS
+            || memcmp(&instruction.header, container_stream + offset, sizeof(instruction_header_t)) != 0
+            || memcmp(instruction.operands, container_stream + offset + sizeof(instruction_header_t),
+                      instruction.header.number_of_operands) != 0) {
+            fprintf(stderr, "instruction %zu differs from the stream\n", number_of_instructions);
+            return false;
+        }
+
+        ++number_of_instructions;
+    }
+
+    ok &= container_expect(read_error == INSTRUCTION_READER_READ_ERROR_END, "the container did not end cleanly");
+    ok &= container_expect(number_of_instructions == CONTAINER_NUMBER_OF_INSTRUCTIONS, "instructions were lost");
+    return ok;
+}
+
+/**
+ * @brief Seeks in every mode, within and past the bounds of the stream.
+ */
+static bool container_check_seek(instruction_reader_container_t *container, size_t size) {
+    instruction_reader_t reader;
+    instruction_t instruction;
+    size_t last = container_offsets[CONTAINER_NUMBER_OF_INSTRUCTIONS - 1];
+    size_t middle = container_offsets[CONTAINER_NUMBER_OF_REPEATED + CONTAINER_NUMBER_OF_RANDOM / 2];
+    bool ok = true;
+
+    instruction_reader_init_container(&reader, container);
+
+    instruction_reader_seek(&reader, (instruction_reader_offset_t) middle, INSTRUCTION_READER_SEEK_SET);
+    ok &= container_expect(instruction_reader_tell(&reader) == (instruction_reader_offset_t) middle
+                           && instruction_reader_read(&reader, &instruction) == INSTRUCTION_READER_READ_ERROR_OK
+                           && instruction.header.operation_index == CONTAINER_NUMBER_OF_RANDOM / 2,
+                           "seeking to an instruction in a raw block did not reach it");
+
+    instruction_reader_seek(&reader, (instruction_reader_offset_t) size + 1, INSTRUCTION_READER_SEEK_SET);
+    ok &= container_expect(instruction_reader_tell(&reader) == (instruction_reader_offset_t) size,
+                           "SEEK_SET past the end was not clamped");
+
+    instruction_reader_seek(&reader, -1, INSTRUCTION_READER_SEEK_SET);
+    ok &= container_expect(instruction_reader_tell(&reader) == 0, "SEEK_SET before the start was not clamped");
+
+    instruction_reader_seek(&reader, (instruction_reader_offset_t) middle, INSTRUCTION_READER_SEEK_CUR);
+    instruction_reader_seek(&reader, -(instruction_reader_offset_t) middle - 1, INSTRUCTION_READER_SEEK_CUR);
+    ok &= container_expect(instruction_reader_tell(&reader) == 0, "SEEK_CUR before the start was not clamped");
+
+    instruction_reader_seek(&reader, (instruction_reader_offset_t) middle, INSTRUCTION_READER_SEEK_CUR);
+    instruction_reader_seek(&reader, (instruction_reader_offset_t) size, INSTRUCTION_READER_SEEK_CUR);
+    ok &= container_expect(instruction_reader_tell(&reader) == (instruction_reader_offset_t) size,
+                           "SEEK_CUR past the end was not clamped");
+
+    instruction_reader_seek(&reader, 1, INSTRUCTION_READER_SEEK_END);
+    ok &= container_expect(instruction_reader_tell(&reader) == (instruction_reader_offset_t) size
+                           && instruction_reader_read(&reader, &instruction) == INSTRUCTION_READER_READ_ERROR_END,
+                           "SEEK_END past the end was not clamped");
+
+    instruction_reader_seek(&reader, -(instruction_reader_offset_t) size - 1, INSTRUCTION_READER_SEEK_END);
+    ok &= container_expect(instruction_reader_tell(&reader) == 0, "SEEK_END before the start was not clamped");
+
+    instruction_reader_seek(&reader, (instruction_reader_offset_t) last - (instruction_reader_offset_t) size,
+                            INSTRUCTION_READER_SEEK_END);
+    ok &= container_expect(instruction_reader_read(&reader, &instruction) == INSTRUCTION_READER_READ_ERROR_OK
+                           && instruction.header.operation_index == (uint8_t) (CONTAINER_NUMBER_OF_EMPTY - 1)
+                           && instruction_reader_read(&reader, &instruction) == INSTRUCTION_READER_READ_ERROR_END,
+                           "SEEK_END did not reach the last instruction of the partial block");
+
+    return ok;
+}
+
+/**
+ * @brief Packs the stream, applies a corruption and checks that the container is rejected.
+ */
+static bool container_check_corrupt(size_t size, off_t offset, uint64_t value, size_t value_size,
+                                    bool rejected_when_opened, const char *message) {
+
+    instruction_reader_container_t container;
+    instruction_reader_t reader;
+    instruction_t instruction;
+    instruction_reader_read_error_t read_error = INSTRUCTION_READER_READ_ERROR_OK;
+    FILE *file = container_pack(size);
+    bool ok;
+
+    if (file == nullptr || !container_patch(file, offset, value, value_size)) {
+        fprintf(stderr, "could not write a corrupt container\n");
+        return false;
+    }
+
+    if (instruction_reader_container_attach(&container, fileno(file)) != INSTRUCTION_READER_CONTAINER_ERROR_OK) {
+        fclose(file);
+        return container_expect(rejected_when_opened, message);
+    }
+
+    instruction_reader_init_container(&reader, &container);
+    while ((read_error = instruction_reader_read(&reader, &instruction)) == INSTRUCTION_READER_READ_ERROR_OK) {
+    }
+
+    ok = container_expect(!rejected_when_opened && read_error != INSTRUCTION_READER_READ_ERROR_END, message);
+
+    instruction_reader_container_close(&container);
+    fclose(file);
+    return ok;
+}
+
+int main(void) {
+    instruction_reader_container_t container;
+    instruction_reader_t reader;
+    instruction_t instruction;
+    size_t size = container_fill();
+    size_t number_of_raw_blocks = 0;
+    off_t entry = INSTRUCTION_CONTAINER_HEADER_SIZE;
+    FILE *file;
+    bool ok = true;
+
+    ok &= container_expect(container_round_trip(container_stream, 0), "an empty block did not round-trip");
+    ok &= container_expect(container_round_trip(container_stream, CONTAINER_BLOCK_SIZE),
+                           "a repetitive block did not round-trip");
+    ok &= container_expect(container_round_trip(container_stream + container_offsets[CONTAINER_NUMBER_OF_REPEATED],
+                                                CONTAINER_BLOCK_SIZE),
+                           "a random block did not round-trip");
+    ok &= container_expect(container_round_trip(container_stream, size), "the whole stream did not round-trip");
+
+    if ((file = container_pack(size)) == nullptr
+        || instruction_reader_container_attach(&container, fileno(file)) != INSTRUCTION_READER_CONTAINER_ERROR_OK) {
+        fprintf(stderr, "could not pack the stream\n");
+        return EXIT_FAILURE;
+    }
+
+    for (size_t index = 0; index < container.number_of_blocks; ++index) {
+        number_of_raw_blocks += container.blocks[index].raw;
+    }
+
+    ok &= container_expect(size % CONTAINER_BLOCK_SIZE != 0
+                           && container.number_of_blocks == size / CONTAINER_BLOCK_SIZE + 1,
+                           "the last block is not partial");
+    ok &= container_expect(number_of_raw_blocks != 0 && number_of_raw_blocks != container.number_of_blocks,
+                           "the container does not mix raw and compressed blocks");
+    ok &= container_check_stream(&container, size);
+    ok &= container_check_seek(&container, size);
+
+    instruction_reader_container_close(&container);
+    fclose(file);
+
+    if ((file = container_pack(0)) == nullptr
+        || instruction_reader_container_attach(&container, fileno(file)) != INSTRUCTION_READER_CONTAINER_ERROR_OK) {
+        fprintf(stderr, "could not pack an empty stream\n");
+        return EXIT_FAILURE;
+    }
+
+    instruction_reader_init_container(&reader, &container);
+    instruction_reader_seek(&reader, 1, INSTRUCTION_READER_SEEK_END);
+    ok &= container_expect(container.number_of_blocks == 0
+                           && instruction_reader_tell(&reader) == 0
+                           && instruction_reader_read(&reader, &instruction) == INSTRUCTION_READER_READ_ERROR_END,
+                           "an empty container is not empty");
+
+    instruction_reader_container_close(&container);
+    fclose(file);
+
+    // Every block of the index is 12 bytes: a u64 offset followed by a u32 stored size.
+    ok &= container_check_corrupt(size, entry + 8, INSTRUCTION_CONTAINER_BLOCK_RAW | (CONTAINER_BLOCK_SIZE + 1), 4,
+                                  true, "a raw block larger than a block was accepted");
+    ok &= container_check_corrupt(size, entry + 8, instruction_container_bound(CONTAINER_BLOCK_SIZE) + 1, 4,
+                                  true, "a compressed block larger than the bound was accepted");
+    ok &= container_check_corrupt(size, 12, size / CONTAINER_BLOCK_SIZE + 2, 4,
+                                  true, "a wrong number of blocks was accepted");
+    ok &= container_check_corrupt(size, entry, UINT64_C(1) << 40, 8,
+                                  false, "a block past the end of the file was read");
+    ok &= container_check_corrupt(size, entry + 8, 1, 4,
+                                  false, "a truncated block was read");
+
+    if (!ok) {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
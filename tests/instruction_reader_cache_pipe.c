@@ -0,0 +1,132 @@
+/**
+ * @file instruction_reader_cache_pipe.c
+ * @brief Checks that seeking a cache never breaks a source reading from a pipe.
+ *
+ * A thread writes a stream of instructions into a pipe read by an fd reader behind a
+ * cache. Seeking the cache back to instructions it holds must replay them from the table
+ * and then continue with the pipe, reading the whole stream in order.
+ */
+#include <zodiac/instruction/instruction_reader_cache.h>
+#include <zodiac/instruction/instruction_reader_fd.h>
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/// Number of instructions written into the pipe.
+#define CACHE_PIPE_NUMBER_OF_INSTRUCTIONS 100000
+
+/// Size of an instruction without operands.
+#define CACHE_PIPE_INSTRUCTION_SIZE 3
+
+/**
+ * @brief Writes the instructions into the pipe, the operation index cycling through all values.
+ */
+static void *cache_pipe_write(void *argument) {
+    int fd = *(int *) argument;
+    uint8_t bytes[CACHE_PIPE_INSTRUCTION_SIZE * 256];
+
+    for (size_t index = 0; index < 256; ++index) {
+        bytes[index * CACHE_PIPE_INSTRUCTION_SIZE] = 0;
+        bytes[index * CACHE_PIPE_INSTRUCTION_SIZE + 1] = (uint8_t) index;
+        bytes[index * CACHE_PIPE_INSTRUCTION_SIZE + 2] = 0;
+    }
+
+    for (size_t written = 0; written < CACHE_PIPE_NUMBER_OF_INSTRUCTIONS; written += 256) {
+        size_t count = CACHE_PIPE_NUMBER_OF_INSTRUCTIONS - written < 256
+                       ? CACHE_PIPE_NUMBER_OF_INSTRUCTIONS - written
+                       : 256;
+
+        if (write(fd, bytes, count * CACHE_PIPE_INSTRUCTION_SIZE) != (ssize_t) (count * CACHE_PIPE_INSTRUCTION_SIZE)) {
+            break;
+        }
+    }
+
+    close(fd);
+    return nullptr;
+}
+
+static bool cache_pipe_expect(bool condition, const char *message) {
+    if (!condition) {
+        fprintf(stderr, "%s\n", message);
+    }
+
+    return condition;
+}
+
+int main(void) {
+    int fds[2];
+    pthread_t writer;
+    instruction_reader_fd_t fd_reader;
+    instruction_reader_cache_t cache;
+    instruction_reader_t source;
+    instruction_reader_t reader;
+    instruction_t instruction;
+    instruction_reader_read_error_t read_error;
+    size_t number_of_instructions = 0;
+    bool ok = true;
+
+    // The writer gets EPIPE instead of being killed when the stream is not read to its end.
+    signal(SIGPIPE, SIG_IGN);
+
+    if (pipe(fds) != 0 || pthread_create(&writer, nullptr, cache_pipe_write, &fds[1]) != 0) {
+        fprintf(stderr, "could not start the writer\n");
+        return EXIT_FAILURE;
+    }
+
+    if (instruction_reader_fd_attach(&fd_reader, fds[0], nullptr) != INSTRUCTION_READER_FD_ERROR_OK) {
+        fprintf(stderr, "could not attach the pipe\n");
+        return EXIT_FAILURE;
+    }
+
+    instruction_reader_init_fd(&source, &fd_reader);
+
+    if (instruction_reader_cache_init(&cache, &source, 0, nullptr) != INSTRUCTION_READER_CACHE_ERROR_OK) {
+        fprintf(stderr, "could not create the cache\n");
+        return EXIT_FAILURE;
+    }
+
+    instruction_reader_init_cache(&reader, &cache);
+
+    ok &= cache_pipe_expect(instruction_reader_read(&reader, &instruction) == INSTRUCTION_READER_READ_ERROR_OK
+                            && instruction_reader_read(&reader, &instruction) == INSTRUCTION_READER_READ_ERROR_OK,
+                            "could not read the first instructions");
+
+    instruction_reader_seek(&reader, 9, INSTRUCTION_READER_SEEK_SET);
+    ok &= cache_pipe_expect(instruction_reader_tell(&reader) == 9, "a seek ahead of the end seen so far was clamped");
+
+    instruction_reader_seek(&reader, 0, INSTRUCTION_READER_SEEK_SET);
+
+    while ((read_error = instruction_reader_read(&reader, &instruction)) == INSTRUCTION_READER_READ_ERROR_OK) {
+        if (instruction.header.operation_index != (uint8_t) number_of_instructions) {
+            fprintf(stderr, "instruction %zu is out of order\n", number_of_instructions);
+            ok = false;
+            break;
+        }
+
+        ++number_of_instructions;
+    }
+
+    ok &= cache_pipe_expect(read_error == INSTRUCTION_READER_READ_ERROR_END, "the stream did not end cleanly");
+    ok &= cache_pipe_expect(number_of_instructions == CACHE_PIPE_NUMBER_OF_INSTRUCTIONS, "instructions were lost");
+    ok &= cache_pipe_expect(cache.number_of_hits == 2, "the replayed instructions were not served by the cache");
+
+    instruction_reader_seek(&reader, 1, INSTRUCTION_READER_SEEK_CUR);
+    ok &= cache_pipe_expect(instruction_reader_tell(&reader)
+                            == CACHE_PIPE_NUMBER_OF_INSTRUCTIONS * CACHE_PIPE_INSTRUCTION_SIZE,
+                            "a seek past the end reached was not clamped");
+
+    instruction_reader_cache_free(&cache);
+    instruction_reader_fd_close(&fd_reader);
+    close(fds[0]);
+    pthread_join(writer, nullptr);
+
+    if (!ok) {
+        fprintf(stderr, "read %zu of %d instructions\n", number_of_instructions, CACHE_PIPE_NUMBER_OF_INSTRUCTIONS);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file scheduler_fairness.c
+ * @brief Checks that a task looping forever does not starve the other tasks of its worker.
+ *
+ * A single worker runs a task jumping back to its first instruction forever, then a task
+ * made of a single instruction is submitted. The short task must complete while the
+ * looping one is still running.
+ */
+#include <zodiac/instruction/instruction_program.h>
+#include <zodiac/scheduler/scheduler.h>
+
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/// Number of instructions of a slice, small so the looping task yields often.
+#define FAIRNESS_SLICE 1000
+
+/// Time the short task is given to complete, in seconds.
+#define FAIRNESS_TIMEOUT 2
+
+/// Time the looping task runs alone before the short task is submitted, in nanoseconds.
+#define FAIRNESS_HEAD_START 10000000
+
+static controller_operation_result_t fairness_loop(callback_sender sender,
+                                                   struct executor_s *executor,
+                                                   const instruction_header_t *header,
+                                                   const instruction_operand_t *operands) {
+    (void) sender;
+    (void) header;
+    (void) operands;
+
+    executor_seek(executor, 0, INSTRUCTION_READER_SEEK_SET);
+    return CONTROLLER_OPERATION_RESULT_CONTINUE;
+}
+
+static controller_operation_result_t fairness_nop(callback_sender sender,
+                                                  struct executor_s *executor,
+                                                  const instruction_header_t *header,
+                                                  const instruction_operand_t *operands) {
+    (void) sender;
+    (void) executor;
+    (void) header;
+    (void) operands;
+
+    return CONTROLLER_OPERATION_RESULT_CONTINUE;
+}
+
+static void fairness_completed(callback_sender sender, scheduler_task_t *task) {
+    (void) task;
+    atomic_store((atomic_bool *) sender, true);
+}
+
+int main(void) {
+    static const controller_operation_callback_t operations[] = {fairness_loop, fairness_nop};
+    controller_registry_t registry;
+    controller_t controller;
+    instruction_program_t looping_program;
+    instruction_program_t short_program;
+    instruction_header_t header = {0, 0, 0};
+    executor_t looping_executor;
+    executor_t short_executor;
+    scheduler_task_t looping_task;
+    scheduler_task_t short_task;
+    scheduler_options_t options;
+    scheduler_t scheduler;
+    struct timespec head_start = {0, FAIRNESS_HEAD_START};
+    atomic_bool completed = false;
+    time_t deadline;
+
+    controller_registry_init(&registry);
+    controller_init(&controller, nullptr, operations, 2);
+    controller_registry_register(&registry, 0, &controller);
+
+    instruction_program_init(&looping_program);
+    instruction_program_init(&short_program);
+    instruction_program_append(&looping_program, &header, nullptr);
+    header.operation_index = 1;
+    instruction_program_append(&short_program, &header, nullptr);
+
+    executor_init_program(&looping_executor, &registry, &looping_program);
+    executor_init_program(&short_executor, &registry, &short_program);
+    scheduler_task_init(&looping_task, &looping_executor, nullptr, nullptr);
+    scheduler_task_init(&short_task, &short_executor, fairness_completed, &completed);
+
+    scheduler_options_init(&options);
+    options.number_of_workers = 1;
+    options.slice = FAIRNESS_SLICE;
+
+    if (scheduler_start(&scheduler, &options) != SCHEDULER_ERROR_OK) {
+        fprintf(stderr, "could not start the scheduler\n");
+        return EXIT_FAILURE;
+    }
+
+    scheduler_submit(&scheduler, &looping_task);
+
+    // Lets the looping task yield a few times before the short one arrives.
+    nanosleep(&head_start, nullptr);
+
+    scheduler_submit(&scheduler, &short_task);
+    deadline = time(nullptr) + FAIRNESS_TIMEOUT;
+
+    while (!atomic_load(&completed) && time(nullptr) < deadline) {
+        sched_yield();
+    }
+
+    scheduler_stop(&scheduler);
+
+    instruction_program_free(&looping_program);
+    instruction_program_free(&short_program);
+
+    if (!atomic_load(&completed) || short_task.status != EXECUTOR_STATUS_COMPLETED) {
+        fprintf(stderr, "the short task was starved, the looping task ran %llu instructions\n",
+                (unsigned long long) looping_executor.number_of_executed_instructions);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}